@@ -41,6 +41,23 @@ BENCHMARK_SCENARIOS = [
 		"name": "Scenario 4 (TFL accident stats 2015)",
 		"description": "A large JSON (18M) from an open API",
 	},
+	{
+		"id": "scenario5",
+		"name": "Scenario 5 (Escaped text)",
+		"description": "A list of CJK and emoji strings (size: 600K) with every"
+		  + " non-ASCII character written as a \\uXXXX escape, generated by"
+		  + " build.py. This benchmark measures unicode escape decoding.",
+	},
+]
+
+# Same scenarios with pretty-printed inputs (indented by 4 spaces)
+BENCHMARK_SCENARIOS += [
+	{
+		"id": sc["id"] + "_pretty",
+		"name": sc["name"] + ", pretty-printed",
+		"description": "Same as above, with the input pretty-printed.",
+	}
+	for sc in BENCHMARK_SCENARIOS
 ]
 
 BENCHMARK_LIBRARIES = [
@@ -48,6 +65,14 @@ BENCHMARK_LIBRARIES = [
 		"id": "quantumjson",
 		"url": "https://github.com/mserdarsanli/QuantumJson",
 	},
+	{
+		"id": "quantumjson_trusted",
+		"url": "https://github.com/mserdarsanli/QuantumJson",
+	},
+	{
+		"id": "quantumjson_view",
+		"url": "https://github.com/mserdarsanli/QuantumJson",
+	},
 	{
 		"id": "staticjson",
 		"url": "https://github.com/netheril96/StaticJSON",
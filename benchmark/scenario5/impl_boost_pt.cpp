@@ -0,0 +1,77 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Mustafa Serdar Sanli
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "benchmark/Benchmark.hpp"
+
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+namespace pt = boost::property_tree;
+
+void Benchmark(int repeat, const std::string &input)
+{
+	BENCHMARK_BEGIN;
+
+	for (int i = 0; i < repeat; ++i)
+	{
+		BENCHMARK_LOOP_BEGIN;
+
+		// TODO boost property_tree does not read from string directly.
+		// So this may not be a fair comparison.
+		std::stringstream ss;
+		ss.str(input);
+
+		pt::ptree root;
+		pt::read_json(ss, root);
+
+		#ifdef BENCHMARK_CHECK_CORRECTNESS
+
+		// boost_pt does not allow random access to list elements
+		std::vector<std::string> res;
+		for (const auto &ch : root)
+		{
+			res.push_back(ch.second.get_value<std::string>());
+		}
+
+		size_t count = res.size();
+		std::string first = res[0];
+		std::string third = res[2];
+		std::string last = res[1999];
+
+		CHECK(count == 2000);
+		CHECK(first == u8"中文文本中的每个字符都被转义，只有标点符号除外。");
+		CHECK(third == u8"한국어 텍스트도 마찬가지로 모두 이스케이프됩니다."
+		               u8"한국어 텍스트도 마찬가지로 모두 이스케이프됩니다."
+		               u8"한국어 텍스트도 마찬가지로 모두 이스케이프됩니다.");
+		CHECK(last == u8"絵文字はサロゲートペアになります 😀🎉🚀 ★☆"
+		              u8"絵文字はサロゲートペアになります 😀🎉🚀 ★☆");
+
+		#endif
+
+		BENCHMARK_LOOP_END;
+	}
+
+	BENCHMARK_END;
+}
@@ -22,20 +22,22 @@
 # OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 # SOFTWARE.
 
+import json
+import os
 import subprocess
 import sys
 
 NinjaContents = '''
-cppflags = -std=c++17 -fPIC -O3 -I out -I . -I third_party
+cppflags = -std=c++17 -fPIC -O3 -pthread -I out -I . -I third_party
 extra_cppflags =
-linkflags =
+linkflags = -pthread
 
 rule compile
     depfile = $out.d
     command = g++ -MMD -MF $out.d $cppflags $extra_cppflags -c $in -o $out
 
 rule link
-    command = g++ $linkflags $in -o $out
+    command = g++ $linkflags $in -o $out $libs
 
 build out/lib/HexDump.o: compile lib/HexDump.cpp
 build out/lib/HexDump: link out/lib/HexDump.o
@@ -69,11 +71,13 @@ build out/src/TestUtil         : link out/tests/CatchMain.o out/src/TestUtil.o
 
 
 rule jc
-    command = out/jc --in $in --out $out
+    command = out/jc $jc_flags --in $in --out $out
 
 build out/tests/Schema1.gen.hpp: jc tests/Schema1.json.hpp | out/jc
 build out/tests/Schema2.gen.hpp: jc tests/Schema2.json.hpp | out/jc
 build out/tests/SchemaNS.gen.hpp: jc tests/SchemaNS.json.hpp | out/jc
+build out/tests/SchemaPmr.gen.hpp: jc tests/SchemaPmr.json.hpp | out/jc
+    jc_flags = --pmr
 
 
 build out/tests/Main.o: compile tests/Main.cpp
@@ -92,6 +96,9 @@ build out/tests/SerializeObjectTests: link out/tests/CatchMain.o out/tests/Seria
 build out/tests/NamespaceTests.o: compile tests/NamespaceTests.cpp
 build out/tests/NamespaceTests: link out/tests/CatchMain.o out/tests/NamespaceTests.o
 
+build out/tests/PmrTests.o: compile tests/PmrTests.cpp | out/tests/SchemaPmr.gen.hpp
+build out/tests/PmrTests: link out/tests/CatchMain.o out/tests/PmrTests.o
+
 build out/tests/LibTests.o: compile tests/LibTests.cpp
 build out/tests/LibTests: link out/tests/CatchMain.o out/tests/LibTests.o
 
@@ -110,6 +117,11 @@ build out/tests/ReservedSizes: link out/tests/CatchMain.o out/tests/ReservedSize
 build out/tests/Utf8StressTest.o: compile tests/Utf8StressTest.cpp
 build out/tests/Utf8StressTest: link out/tests/CatchMain.o out/tests/Utf8StressTest.o
 
+build out/tests/DecompressionTests.o: compile tests/DecompressionTests.cpp
+    extra_cppflags = -DQUANTUMJSON_WITH_ZLIB
+build out/tests/DecompressionTests: link out/tests/CatchMain.o out/tests/DecompressionTests.o
+    libs = -lz
+
 build out/tests/JsonSkipConformanceChecker.o: compile tests/JsonSkipConformanceChecker.cpp
 build out/tests/JsonSkipConformanceChecker: link out/tests/JsonSkipConformanceChecker.o
 
@@ -129,6 +141,21 @@ build out/third_party/jsoncpp.o: compile third_party/jsoncpp.cpp
 build out/third_party/staticjson/staticjson.o: compile third_party/staticjson/staticjson.cpp
 '''
 
+# Text escaped as a whole, as some systems do with every non-ASCII
+# character, so that strings are almost entirely \uXXXX escapes.
+ESCAPED_TEXT_SENTENCES = [
+    '中文文本中的每个字符都被转义，只有标点符号除外。',
+    '日本語のテキストも同じようにエスケープされています。',
+    '한국어 텍스트도 마찬가지로 모두 이스케이프됩니다.',
+    '絵文字はサロゲートペアになります 😀🎉🚀 ★☆',
+]
+
+def generate_escaped_text( path ):
+
+    data = [ ESCAPED_TEXT_SENTENCES[i % 4] * ( 1 + i % 3 ) for i in range( 2000 ) ]
+    with open( path, 'w' ) as out:
+        json.dump( data, out, ensure_ascii = True )
+
 BENCHMARK_SCENARIOS = [
     {
         "id": "scenario1",
@@ -150,11 +177,20 @@ BENCHMARK_SCENARIOS = [
         "input": "data/tfl_accident_stats_2015.json",
         "repeat_cnt": 15,
     },
+    {
+        "id": "scenario5",
+        "input": "data/escaped_text.json",
+        "repeat_cnt": 1000,
+        "generate": generate_escaped_text,
+        "escaped": True,
+    },
 ]
 
 BENCHMARK_LIBRARIES = [
     'nlohmann_json',
     'quantumjson',
+    'quantumjson_trusted',
+    'quantumjson_view',
     'jsoncpp',
     'rapidjson',
     'staticjson',
@@ -162,11 +198,37 @@ BENCHMARK_LIBRARIES = [
 ]
 
 
+# zstd is optional, its tests are only built when pkg-config finds libzstd.
+# Returns their build rules, or None.
+def zstd_test_rules():
+
+    try:
+        flags = [ subprocess.run( [ 'pkg-config', option, 'libzstd' ], check = True, stdout = subprocess.PIPE,
+                                  stderr = subprocess.DEVNULL, universal_newlines = True ).stdout.split()
+                  for option in [ '--cflags', '--libs' ] ]
+    except ( OSError, subprocess.CalledProcessError ):
+        return None
+    cflags, libs = flags
+
+    # Also found at run time when installed out of the default search path
+    libs += [ '-Wl,-rpath,' + flag[ 2: ] for flag in libs if flag.startswith( '-L' ) ]
+
+    return ( 'build out/tests/ZstdDecompressionTests.o: compile tests/ZstdDecompressionTests.cpp\n'
+           + '    extra_cppflags = -DQUANTUMJSON_WITH_ZSTD ' + ' '.join( cflags ) + '\n'
+           + 'build out/tests/ZstdDecompressionTests: link out/tests/CatchMain.o out/tests/ZstdDecompressionTests.o\n'
+           + '    libs = ' + ' '.join( libs ) + '\n' )
+
 def configure_main():
 
     with open( 'build.ninja', 'w' ) as ninja:
         ninja.write( NinjaContents )
 
+        zstd_rules = zstd_test_rules()
+        if zstd_rules:
+            ninja.write( zstd_rules )
+        else:
+            print( 'libzstd not found by pkg-config, zstd tests are not built' )
+
         for sc in BENCHMARK_SCENARIOS:
             for lib in BENCHMARK_LIBRARIES:
                 extra_objs = ''
@@ -176,7 +238,7 @@ def configure_main():
                     extra_objs = 'out/third_party/staticjson/staticjson.o'
 
                 extra_deps = ''
-                if lib == 'quantumjson':
+                if lib.startswith( 'quantumjson' ):
                     extra_deps = ' | out/benchmark/schema/RedditListing.gen.hpp out/benchmark/schema/OMDB.gen.hpp out/benchmark/schema/StackOverflow.gen.hpp out/benchmark/schema/TFL.gen.hpp'
                 # Check Correctness
                 ninja.write( f"build out/benchmark/bin_{lib}_{sc['id']}_check.o: compile benchmark/{sc['id']}/impl_{lib}.cpp {extra_deps}\n"
@@ -206,6 +268,7 @@ def run_tests_main():
     subprocess.run( 'out/tests/MultipleSchemas' )
     subprocess.run( 'out/tests/SerializeObjectTests' )
     subprocess.run( 'out/tests/NamespaceTests' )
+    subprocess.run( 'out/tests/PmrTests' )
 
     subprocess.run( 'out/tests/LibTests' )
     subprocess.run( 'out/tests/SerializeTests' )
@@ -213,6 +276,9 @@ def run_tests_main():
     subprocess.run( 'out/tests/StringAllocations' )
     subprocess.run( 'out/tests/ReservedSizes' )
     subprocess.run( 'out/tests/Utf8StressTest' )
+    subprocess.run( 'out/tests/DecompressionTests' )
+    if os.path.exists( 'out/tests/ZstdDecompressionTests' ):
+        subprocess.run( 'out/tests/ZstdDecompressionTests' )
 
     for i in range( 1, 4 ):
         subprocess.run( [ 'out/tests/JsonSkipConformanceChecker', '--pass', f'tests/json_checker_tests/pass{i}.json' ] )
@@ -220,25 +286,50 @@ def run_tests_main():
     for i in range( 1, 34 ):
         subprocess.run( [ 'out/tests/JsonSkipConformanceChecker', '--fail', f'tests/json_checker_tests/fail{i}.json' ] )
 
+# Each scenario is run with its input as is, and with a pretty-printed copy
+# of it to measure whitespace handling. Returns (name, input path) pairs.
+def benchmark_inputs( sc ):
+
+    inp_path = 'benchmark/' + sc['input']
+    if 'generate' in sc:
+        inp_path = 'out/benchmark/' + sc['input']
+        if not os.path.exists( inp_path ):
+            os.makedirs( os.path.dirname( inp_path ), exist_ok = True )
+            sc['generate']( inp_path )
+
+    pretty_input = 'out/benchmark/' + sc['input'].replace( '.json', '.pretty.json' )
+    if not os.path.exists( pretty_input ):
+        with open( inp_path ) as inp:
+            data = json.load( inp )
+        os.makedirs( os.path.dirname( pretty_input ), exist_ok = True )
+        with open( pretty_input, 'w' ) as out:
+            json.dump( data, out, indent = 4, ensure_ascii = sc.get( 'escaped', False ) )
+
+    return [ ( sc['id'], inp_path ),
+             ( sc['id'] + '_pretty', pretty_input ) ]
+
 def run_benchmarks_main():
 
     for lib in BENCHMARK_LIBRARIES:
         for sc in BENCHMARK_SCENARIOS:
+            for name, inp in benchmark_inputs( sc ):
 
-            res = subprocess.run( f"out/benchmark/bin_{lib}_{sc['id']}_check 1 < benchmark/{sc['input']}", shell = True, check = True, stdout = subprocess.PIPE )
-            print( 'Correctness', lib, sc['id'], str( res.stdout, 'utf-8' ) )
+                res = subprocess.run( f"out/benchmark/bin_{lib}_{sc['id']}_check 1 < {inp}", shell = True, check = True, stdout = subprocess.PIPE )
+                print( 'Correctness', lib, name, str( res.stdout, 'utf-8' ) )
 
     for lib in BENCHMARK_LIBRARIES:
         for sc in BENCHMARK_SCENARIOS:
+            for name, inp in benchmark_inputs( sc ):
 
-            res = subprocess.run( f"out/benchmark/bin_{lib}_{sc['id']}_speed {sc['repeat_cnt'] // 15} < benchmark/{sc['input']}", shell = True, check = True, stdout = subprocess.PIPE )
-            print( 'Speed', lib, sc['id'], str( res.stdout, 'utf-8' ) )
+                res = subprocess.run( f"out/benchmark/bin_{lib}_{sc['id']}_speed {sc['repeat_cnt'] // 15} < {inp}", shell = True, check = True, stdout = subprocess.PIPE )
+                print( 'Speed', lib, name, str( res.stdout, 'utf-8' ) )
 
     for lib in BENCHMARK_LIBRARIES:
         for sc in BENCHMARK_SCENARIOS:
+            for name, inp in benchmark_inputs( sc ):
 
-            res = subprocess.run( f"LD_PRELOAD=./out/benchmark/memory_reporter.so out/benchmark/bin_{lib}_{sc['id']}_memory 1 < benchmark/{sc['input']}", shell = True, check = True, stdout = subprocess.PIPE )
-            print( 'Memory', lib, sc['id'], str( res.stdout, 'utf-8' ) )
+                res = subprocess.run( f"LD_PRELOAD=./out/benchmark/memory_reporter.so out/benchmark/bin_{lib}_{sc['id']}_memory 1 < {inp}", shell = True, check = True, stdout = subprocess.PIPE )
+                print( 'Memory', lib, name, str( res.stdout, 'utf-8' ) )
 
 
 def die_with_usage():
@@ -0,0 +1,19070 @@
+#pragma once
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Mustafa Serdar Sanli
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QUANTUMJSON_LIB_IMPL_
+#define QUANTUMJSON_LIB_IMPL_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cinttypes>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Compressed input is supported with the libraries enabled here, see
+// `DecompressingInput`. Programs defining these need to link -lz and
+// -lzstd respectively.
+#ifdef QUANTUMJSON_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef QUANTUMJSON_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define QUANTUMJSON_HAVE_SSE2 1
+#endif
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define QUANTUMJSON_HAVE_SSSE3 1
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define QUANTUMJSON_HAVE_AVX2 1
+#endif
+
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+#define QUANTUMJSON_HAVE_AVX512 1
+#endif
+
+// Kernels for instruction sets above the compile time ones are built with
+// target attributes, and the widest one the CPU supports is picked at first
+// use (see `ActiveKernels`). So one binary built without `-march` flags
+// still gets AVX2 or AVX-512 kernels where the hardware has them. Define
+// QUANTUMJSON_NO_RUNTIME_DISPATCH to only use what is enabled at compile
+// time.
+#if !defined(QUANTUMJSON_NO_RUNTIME_DISPATCH) && defined(__x86_64__) \
+    && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define QUANTUMJSON_RUNTIME_DISPATCH 1
+#define QUANTUMJSON_TARGET(isa) __attribute__((target(isa)))
+#else
+#define QUANTUMJSON_TARGET(isa)
+#endif
+
+#if QUANTUMJSON_HAVE_SSSE3 || QUANTUMJSON_RUNTIME_DISPATCH
+#define QUANTUMJSON_BUILD_SSSE3 1
+#endif
+
+#if QUANTUMJSON_HAVE_AVX2 || QUANTUMJSON_RUNTIME_DISPATCH
+#define QUANTUMJSON_BUILD_AVX2 1
+#endif
+
+#if QUANTUMJSON_HAVE_AVX512 || QUANTUMJSON_RUNTIME_DISPATCH
+#define QUANTUMJSON_BUILD_AVX512 1
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define QUANTUMJSON_LIKELY(x) __builtin_expect(!!(x), 1)
+#define QUANTUMJSON_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#define QUANTUMJSON_NOINLINE __attribute__((noinline))
+#else
+#define QUANTUMJSON_LIKELY(x) (x)
+#define QUANTUMJSON_UNLIKELY(x) (x)
+#define QUANTUMJSON_NOINLINE
+#endif
+
+// Exceptions seem to have a large (a few percent) performance cost by
+// preventing inlining (though I am not really sure about why).
+// So this simple alternative is used.
+#define QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE \
+	if (QUANTUMJSON_UNLIKELY(this->errorCode != ErrorCode::NoError)) \
+	{ \
+		return; \
+	}
+
+#define QUANTUMJSON_CHECK_EOF_AND_PROPAGATE \
+	if (QUANTUMJSON_UNLIKELY(this->it == this->end)) \
+	{ \
+		this->errorCode = ErrorCode::UnexpectedEOF; \
+		return; \
+	}
+
+// Maximum nesting of objects and lists, both for values parsed into
+// objects and for skipped ones. Deeper input fails with "Depth Limit
+// Exceeded" instead of growing the stack. May be defined before inclusion,
+// or changed per parse with `MaxDepth()`.
+#ifndef QUANTUMJSON_MAX_DEPTH
+#define QUANTUMJSON_MAX_DEPTH 1024
+#endif
+
+// TODO add library version checks?
+
+// TODO find a better namespace name
+namespace QuantumJsonImpl__ {
+
+enum class ErrorCode
+{
+	NoError,
+
+	UnexpectedEOF,
+	UnexpectedChar,
+	UnexpectedToken,
+	InvalidEscape,
+	InvalidUtf8Sequence,
+	InvalidSurrogate,
+	UnsupportedUnicodeRange,
+	ControlCharacterInString,
+	NumberOutOfRange,
+	MissingStringStorage,
+	DepthLimitExceeded,
+	InputTooLarge,
+};
+
+// Make an exception class for better error reporting when uncaught
+class JsonError : public std::exception
+{
+public:
+	explicit JsonError(ErrorCode code)
+	    : errorCode(code)
+	{
+	}
+
+	// TODO provide more error details?
+	const char* what() const noexcept override
+	{
+		switch (errorCode)
+		{
+		case ErrorCode::UnexpectedEOF:
+			return "Unexpected EOF";
+		case ErrorCode::UnexpectedChar:
+			return "Unexpected Char";
+		case ErrorCode::UnexpectedToken:
+			return "Unexpected Token";
+		case ErrorCode::InvalidEscape:
+			return "Invalid Escape";
+		case ErrorCode::InvalidUtf8Sequence:
+			return "Invalid UTF-8 Sequence";
+		case ErrorCode::InvalidSurrogate:
+			return "Invalid Surrogate";
+		case ErrorCode::UnsupportedUnicodeRange:
+			return "Unsupported Unicode Range";
+		case ErrorCode::ControlCharacterInString:
+			return "Control Character In String";
+		case ErrorCode::NumberOutOfRange:
+			return "Number Out Of Range";
+		case ErrorCode::MissingStringStorage:
+			return "Missing String Storage";
+		case ErrorCode::DepthLimitExceeded:
+			return "Depth Limit Exceeded";
+		case ErrorCode::InputTooLarge:
+			return "Input Too Large";
+		default:
+			// Should not happen
+			return "";
+		}
+	}
+
+private:
+	ErrorCode errorCode;
+};
+
+template <typename T> struct HasSize : std::true_type {};
+template <> struct HasSize<bool>               : std::false_type {};
+template <> struct HasSize<int>                : std::false_type {};
+template <> struct HasSize<unsigned>           : std::false_type {};
+template <> struct HasSize<long>               : std::false_type {};
+template <> struct HasSize<unsigned long>      : std::false_type {};
+template <> struct HasSize<long long>          : std::false_type {};
+template <> struct HasSize<unsigned long long> : std::false_type {};
+template <> struct HasSize<double>             : std::false_type {};
+template <> struct HasSize<std::string_view>   : std::false_type {};
+// Maps are not preallocated
+template <typename K, typename V, typename C, typename A>
+struct HasSize<std::map<K, V, C, A>> : std::false_type {};
+
+// Strings of any allocator, so `std::pmr::string` is handled like
+// `std::string`
+template <typename Allocator>
+using BasicString = std::basic_string<char, std::char_traits<char>, Allocator>;
+
+// Default constructs a `T` that allocates from `alloc` if it is allocator
+// aware, so elements of pmr containers use the container's memory resource.
+template <typename T, typename Allocator>
+T ConstructWithAllocator(const Allocator &alloc)
+{
+	if constexpr (std::uses_allocator<T, Allocator>::value)
+	{
+		return T(alloc);
+	}
+	else
+	{
+		return T();
+	}
+}
+
+// Number of bytes that must be readable past the end of a
+// `QuantumJson::PaddedInput`, enough for the widest load the parser does.
+constexpr size_t InputPadding = 64;
+
+// Iterator over a `QuantumJson::PaddedInput`. It is a distinct type from
+// `const char*` so the parser can pick the code paths that load past the
+// current position without checking for the end of input first.
+class PaddedIterator
+{
+public:
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = char;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const char*;
+	using reference = const char&;
+
+	PaddedIterator() = default;
+
+	explicit PaddedIterator(const char *p)
+	  : p(p)
+	{
+	}
+
+	reference operator*() const                    { return *p; }
+	reference operator[](difference_type n) const  { return p[n]; }
+
+	PaddedIterator& operator++()                   { ++p; return *this; }
+	PaddedIterator& operator--()                   { --p; return *this; }
+	PaddedIterator operator++(int)                 { return PaddedIterator(p++); }
+	PaddedIterator operator--(int)                 { return PaddedIterator(p--); }
+	PaddedIterator& operator+=(difference_type n)  { p += n; return *this; }
+	PaddedIterator& operator-=(difference_type n)  { p -= n; return *this; }
+
+	PaddedIterator operator+(difference_type n) const        { return PaddedIterator(p + n); }
+	PaddedIterator operator-(difference_type n) const        { return PaddedIterator(p - n); }
+	difference_type operator-(const PaddedIterator &o) const { return p - o.p; }
+
+	bool operator==(const PaddedIterator &o) const { return p == o.p; }
+	bool operator!=(const PaddedIterator &o) const { return p != o.p; }
+	bool operator<(const PaddedIterator &o) const  { return p < o.p; }
+	bool operator>(const PaddedIterator &o) const  { return p > o.p; }
+	bool operator<=(const PaddedIterator &o) const { return p <= o.p; }
+	bool operator>=(const PaddedIterator &o) const { return p >= o.p; }
+
+private:
+	const char *p = nullptr;
+};
+
+template <typename T>
+struct IsPaddedInput : std::is_same<T, PaddedIterator>
+{
+};
+
+// Inputs that are laid out contiguously in memory. Parsing these can work
+// on raw pointers and use wide loads instead of going byte by byte.
+template <typename T>
+struct IsContiguousInput : std::integral_constant<bool,
+       IsPaddedInput<T>::value
+    || std::is_same<T, const char*>::value
+    || std::is_same<T, char*>::value
+    || std::is_same<T, std::string::const_iterator>::value
+    || std::is_same<T, std::string::iterator>::value
+    || std::is_same<T, std::vector<char>::const_iterator>::value
+    || std::is_same<T, std::vector<char>::iterator>::value>
+{
+};
+
+template <typename T>
+struct IsRandomAccessIterator : std::is_base_of<
+           std::random_access_iterator_tag,
+           typename std::iterator_traits<T>::iterator_category>
+{
+};
+
+// Inputs that can be read again from a copy of an iterator. Copies of single
+// pass iterators, like `std::istreambuf_iterator`, share their source.
+template <typename T>
+struct IsMultiPassInput : std::is_base_of<
+           std::forward_iterator_tag,
+           typename std::iterator_traits<T>::iterator_category>
+{
+};
+
+inline
+int CountTrailingZeros(uint64_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(mask);
+#else
+	int cnt = 0;
+	while ((mask & 1) == 0)
+	{
+		mask >>= 1;
+		++cnt;
+	}
+	return cnt;
+#endif
+}
+
+// Characters that can be copied from input into a string value as they
+// are, without any escape or UTF-8 handling.
+inline
+bool IsPlainStringChar(char c)
+{
+	return static_cast<unsigned char>(c) >= 0x20
+	    && static_cast<unsigned char>(c) < 0x80
+	    && c != '"' && c != '\\';
+}
+
+inline
+bool IsWhitespace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Characters the run length kernels stop at
+enum class StopAt
+{
+	// '"', '\\', control characters and non-ASCII bytes, i.e. the end of
+	// plain string characters
+	PlainStringEnd,
+	// '"', '\\' and control characters, what can't be written into a json
+	// string as is
+	EscapeFreeEnd,
+	// Only '"' and '\\', for trusted inputs
+	QuoteOrBackslash,
+	NonWhitespace,
+	Count
+};
+
+template <StopAt stop>
+inline
+bool IsStopChar(char c)
+{
+	if constexpr (stop == StopAt::PlainStringEnd)
+	{
+		return !IsPlainStringChar(c);
+	}
+	else if constexpr (stop == StopAt::EscapeFreeEnd)
+	{
+		return static_cast<unsigned char>(c) < 0x20 || c == '"' || c == '\\';
+	}
+	else if constexpr (stop == StopAt::QuoteOrBackslash)
+	{
+		return c == '"' || c == '\\';
+	}
+	else
+	{
+		return !IsWhitespace(c);
+	}
+}
+
+// Kernels returning the length of the longest prefix of [begin, end) without
+// `stop` characters, one per instruction set. Use the dispatching
+// `PlainStringRunLength` etc. instead of calling these directly.
+template <StopAt stop>
+size_t RunLengthScalar(const char *begin, const char *end)
+{
+	const char *p = begin;
+	while (p != end && !IsStopChar<stop>(*p))
+	{
+		++p;
+	}
+	return p - begin;
+}
+
+#if QUANTUMJSON_HAVE_SSE2
+template <StopAt stop>
+inline
+uint32_t StopMaskSse2(__m128i v)
+{
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	__m128i stops;
+	if constexpr (stop == StopAt::PlainStringEnd)
+	{
+		// Signed comparison catches both control chars and bytes >= 0x80
+		stops = _mm_or_si128(
+		    _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+		    _mm_cmplt_epi8(v, _mm_set1_epi8(0x20)));
+	}
+	else if constexpr (stop == StopAt::EscapeFreeEnd)
+	{
+		// Unsigned v <= 0x1f, via max(v, 0x1f) == 0x1f
+		const __m128i maxControl = _mm_set1_epi8(0x1f);
+		stops = _mm_or_si128(
+		    _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+		    _mm_cmpeq_epi8(_mm_max_epu8(v, maxControl), maxControl));
+	}
+	else if constexpr (stop == StopAt::QuoteOrBackslash)
+	{
+		stops = _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash));
+	}
+	else
+	{
+		__m128i whitespace = _mm_or_si128(
+		    _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+		    _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+		return ~static_cast<uint32_t>(_mm_movemask_epi8(whitespace)) & 0xffff;
+	}
+	return static_cast<uint32_t>(_mm_movemask_epi8(stops));
+}
+
+template <StopAt stop>
+size_t RunLengthSse2(const char *begin, const char *end)
+{
+	const char *p = begin;
+	while (end - p >= 16)
+	{
+		uint32_t mask = StopMaskSse2<stop>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+		if (mask != 0)
+		{
+			return (p - begin) + CountTrailingZeros(mask);
+		}
+		p += 16;
+	}
+	return (p - begin) + RunLengthScalar<stop>(p, end);
+}
+#endif
+
+#if QUANTUMJSON_BUILD_AVX2
+template <StopAt stop>
+QUANTUMJSON_TARGET("avx2")
+inline
+uint32_t StopMaskAvx2(__m256i v)
+{
+	const __m256i quote = _mm256_set1_epi8('"');
+	const __m256i backslash = _mm256_set1_epi8('\\');
+	__m256i stops;
+	if constexpr (stop == StopAt::PlainStringEnd)
+	{
+		stops = _mm256_or_si256(
+		    _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+		    _mm256_cmpgt_epi8(_mm256_set1_epi8(0x20), v));
+	}
+	else if constexpr (stop == StopAt::EscapeFreeEnd)
+	{
+		const __m256i maxControl = _mm256_set1_epi8(0x1f);
+		stops = _mm256_or_si256(
+		    _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+		    _mm256_cmpeq_epi8(_mm256_max_epu8(v, maxControl), maxControl));
+	}
+	else if constexpr (stop == StopAt::QuoteOrBackslash)
+	{
+		stops = _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash));
+	}
+	else
+	{
+		__m256i whitespace = _mm256_or_si256(
+		    _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+		    _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'))));
+		return ~static_cast<uint32_t>(_mm256_movemask_epi8(whitespace));
+	}
+	return static_cast<uint32_t>(_mm256_movemask_epi8(stops));
+}
+
+template <StopAt stop>
+QUANTUMJSON_TARGET("avx2")
+size_t RunLengthAvx2(const char *begin, const char *end)
+{
+	const char *p = begin;
+	while (end - p >= 32)
+	{
+		uint32_t mask = StopMaskAvx2<stop>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+		if (mask != 0)
+		{
+			return (p - begin) + CountTrailingZeros(mask);
+		}
+		p += 32;
+	}
+	return (p - begin) + RunLengthSse2<stop>(p, end);
+}
+#endif
+
+#if QUANTUMJSON_BUILD_AVX512
+template <StopAt stop>
+QUANTUMJSON_TARGET("avx512f,avx512bw")
+inline
+uint64_t StopMaskAvx512(__m512i v)
+{
+	const __m512i quote = _mm512_set1_epi8('"');
+	const __m512i backslash = _mm512_set1_epi8('\\');
+	if constexpr (stop == StopAt::PlainStringEnd)
+	{
+		return _mm512_cmpeq_epi8_mask(v, quote) | _mm512_cmpeq_epi8_mask(v, backslash)
+		     | _mm512_cmplt_epi8_mask(v, _mm512_set1_epi8(0x20));
+	}
+	else if constexpr (stop == StopAt::EscapeFreeEnd)
+	{
+		return _mm512_cmpeq_epi8_mask(v, quote) | _mm512_cmpeq_epi8_mask(v, backslash)
+		     | _mm512_cmplt_epu8_mask(v, _mm512_set1_epi8(0x20));
+	}
+	else if constexpr (stop == StopAt::QuoteOrBackslash)
+	{
+		return _mm512_cmpeq_epi8_mask(v, quote) | _mm512_cmpeq_epi8_mask(v, backslash);
+	}
+	else
+	{
+		return ~(_mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8(' ')) | _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8('\t'))
+		       | _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8('\n')) | _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8('\r')));
+	}
+}
+
+// The tail is read with a masked load, which does not touch the bytes
+// past `end`.
+template <StopAt stop>
+QUANTUMJSON_TARGET("avx512f,avx512bw")
+size_t RunLengthAvx512(const char *begin, const char *end)
+{
+	const char *p = begin;
+	while (p < end)
+	{
+		uint64_t valid = (end - p >= 64) ? ~uint64_t(0) : (uint64_t(1) << (end - p)) - 1;
+		__m512i v = _mm512_maskz_loadu_epi8(valid, p);
+		uint64_t mask = StopMaskAvx512<stop>(v) & valid;
+		if (mask != 0)
+		{
+			return (p - begin) + CountTrailingZeros(mask);
+		}
+		p += 64;
+	}
+	return end - begin;
+}
+#endif
+
+// Same as `PlainStringRunLength`, for inputs with `InputPadding` readable
+// bytes past `end`. Blocks are loaded regardless of the remaining length,
+// so there is no byte by byte loop for the tail of the input.
+inline
+size_t PlainStringRunLengthPadded(const char *begin, const char *end)
+{
+#if QUANTUMJSON_HAVE_SSE2
+	const char *p = begin;
+	while (p < end)
+	{
+		uint32_t mask = StopMaskSse2<StopAt::PlainStringEnd>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+		if (mask != 0)
+		{
+			return std::min<size_t>((p - begin) + CountTrailingZeros(mask), end - begin);
+		}
+		p += 16;
+	}
+	return end - begin;
+#else
+	return RunLengthScalar<StopAt::PlainStringEnd>(begin, end);
+#endif
+}
+
+// Same as `WhitespaceRunLength`, for inputs with `InputPadding` readable
+// bytes past `end`.
+inline
+size_t WhitespaceRunLengthPadded(const char *begin, const char *end)
+{
+#if QUANTUMJSON_HAVE_SSE2
+	const char *p = begin;
+	while (p < end)
+	{
+		uint32_t mask = StopMaskSse2<StopAt::NonWhitespace>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+		if (mask != 0)
+		{
+			return std::min<size_t>((p - begin) + CountTrailingZeros(mask), end - begin);
+		}
+		p += 16;
+	}
+	return end - begin;
+#else
+	return RunLengthScalar<StopAt::NonWhitespace>(begin, end);
+#endif
+}
+
+// Decodes the UTF-8 sequence at the start of [p, end) into `codePoint`.
+// Returns the length of the sequence, or 0 when it is malformed (truncated,
+// overlong, surrogate or out of the unicode range).
+inline
+size_t DecodeUtf8(const char *p, const char *end, uint32_t *codePoint)
+{
+	const unsigned char *u = reinterpret_cast<const unsigned char*>(p);
+	size_t avail = end - p;
+
+	size_t len;
+	uint32_t cp;
+	uint32_t minValue;
+	if (u[0] < 0x80)
+	{
+		*codePoint = u[0];
+		return 1;
+	}
+	else if ((u[0] & 0xe0) == 0xc0)
+	{
+		len = 2; cp = u[0] & 0x1f; minValue = 0x80;
+	}
+	else if ((u[0] & 0xf0) == 0xe0)
+	{
+		len = 3; cp = u[0] & 0x0f; minValue = 0x800;
+	}
+	else if ((u[0] & 0xf8) == 0xf0)
+	{
+		len = 4; cp = u[0] & 0x07; minValue = 0x10000;
+	}
+	else
+	{
+		return 0;
+	}
+
+	if (avail < len)
+	{
+		return 0;
+	}
+
+	for (size_t i = 1; i < len; ++i)
+	{
+		if ((u[i] & 0xc0) != 0x80)
+		{
+			return 0;
+		}
+		cp = (cp << 6) | (u[i] & 0x3f);
+	}
+
+	if (cp < minValue || cp > 0x10ffff || (cp >= 0xd800 && cp <= 0xdfff))
+	{
+		return 0;
+	}
+
+	*codePoint = cp;
+	return len;
+}
+
+// Values of hexadecimal digits. Other characters map to 0x10000, so that
+// four digits combined by DecodeHex4 give a value above 0xFFFF if any of
+// them is invalid.
+struct HexDigitTable
+{
+	uint32_t values[256] = {};
+
+	constexpr HexDigitTable()
+	{
+		for (int i = 0; i < 256; ++i)
+		{
+			values[i] = 0x10000;
+		}
+		for (int i = 0; i < 10; ++i)
+		{
+			values['0' + i] = i;
+		}
+		for (int i = 0; i < 6; ++i)
+		{
+			values['a' + i] = 10 + i;
+			values['A' + i] = 10 + i;
+		}
+	}
+};
+
+inline constexpr HexDigitTable hexDigitTable{};
+
+// Decodes the 4 hexadecimal digits at `p`. Returns a value above 0xFFFF if
+// any of them is not a hexadecimal digit.
+inline
+uint32_t DecodeHex4(const char *p)
+{
+	const uint32_t *values = hexDigitTable.values;
+	return (values[static_cast<unsigned char>(p[0])] << 12)
+	     | (values[static_cast<unsigned char>(p[1])] << 8)
+	     | (values[static_cast<unsigned char>(p[2])] << 4)
+	     | values[static_cast<unsigned char>(p[3])];
+}
+
+// Writes `codePoint` (at most U+10FFFF) encoded as UTF-8 to `out` and
+// returns the number of bytes written.
+inline
+size_t EncodeUtf8(uint32_t codePoint, char *out)
+{
+	if (codePoint <= 0x7f)
+	{
+		out[0] = codePoint;
+		return 1;
+	}
+	if (codePoint <= 0x7ff)
+	{
+		out[0] = 0xC0 | (codePoint >> 6);
+		out[1] = 0x80 | (codePoint & 0x3f);
+		return 2;
+	}
+	if (codePoint <= 0xffff)
+	{
+		out[0] = 0xE0 | (codePoint >> 12);
+		out[1] = 0x80 | ((codePoint >> 6) & 0x3f);
+		out[2] = 0x80 | (codePoint & 0x3f);
+		return 3;
+	}
+	out[0] = 0xF0 | (codePoint >> 18);
+	out[1] = 0x80 | ((codePoint >> 12) & 0x3f);
+	out[2] = 0x80 | ((codePoint >> 6) & 0x3f);
+	out[3] = 0x80 | (codePoint & 0x3f);
+	return 4;
+}
+
+#if QUANTUMJSON_BUILD_SSSE3
+// UTF-8 validation with lookup tables, after "Validating UTF-8 In Less Than
+// One Instruction Per Byte" by John Keiser and Daniel Lemire.
+//
+// Every error in a two byte window is detected from three 4 bit nibbles:
+// high and low nibbles of the first byte and the high nibble of the second.
+// Each nibble is looked up in a 16 entry table of possible error classes,
+// the window is invalid when a class is set in all three. Continuation
+// bytes expected after 3 and 4 byte leads are checked separately.
+namespace Utf8Error
+{
+	constexpr uint8_t TooShort     = 1 << 0; // 11______ 0_______, 11______ 11______
+	constexpr uint8_t TooLong      = 1 << 1; // 0_______ 10______
+	constexpr uint8_t Overlong3    = 1 << 2; // 11100000 100_____
+	constexpr uint8_t TooLarge     = 1 << 3; // 11110100 1001____, 11110100 101_____, 11110101+ 1001____ ...
+	constexpr uint8_t Surrogate    = 1 << 4; // 11101101 101_____
+	constexpr uint8_t Overlong2    = 1 << 5; // 1100000_ 10______
+	constexpr uint8_t TooLarge1000 = 1 << 6; // 11110101+ 1000____
+	constexpr uint8_t Overlong4    = 1 << 6; // 11110000 1000____
+	constexpr uint8_t TwoConts     = 1 << 7; // 10______ 10______
+	constexpr uint8_t Carry        = TooShort | TooLong | TwoConts;
+}
+
+QUANTUMJSON_TARGET("ssse3")
+inline
+__m128i Utf8SpecialCases(__m128i input, __m128i prev1)
+{
+	using namespace Utf8Error;
+	const __m128i lowNibble = _mm_set1_epi8(0x0f);
+
+	const __m128i byte1HighTable = _mm_setr_epi8(
+	    // 0_______ ________ ASCII
+	    TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong,
+	    // 10______ ________ continuation
+	    TwoConts, TwoConts, TwoConts, TwoConts,
+	    // 1100____, 1101____ two byte leads
+	    TooShort | Overlong2,
+	    TooShort,
+	    // 1110____ three byte lead
+	    TooShort | Overlong3 | Surrogate,
+	    // 1111____ four byte lead
+	    char(TooShort | TooLarge | TooLarge1000 | Overlong4));
+
+	const __m128i byte1LowTable = _mm_setr_epi8(
+	    // ____0000
+	    char(Carry | Overlong3 | Overlong2 | Overlong4),
+	    // ____0001
+	    char(Carry | Overlong2),
+	    // ____001_
+	    char(Carry),
+	    char(Carry),
+	    // ____0100
+	    char(Carry | TooLarge),
+	    // ____0101, ____011_, ____1___
+	    char(Carry | TooLarge | TooLarge1000),
+	    char(Carry | TooLarge | TooLarge1000),
+	    char(Carry | TooLarge | TooLarge1000),
+	    char(Carry | TooLarge | TooLarge1000),
+	    char(Carry | TooLarge | TooLarge1000),
+	    char(Carry | TooLarge | TooLarge1000),
+	    char(Carry | TooLarge | TooLarge1000),
+	    char(Carry | TooLarge | TooLarge1000),
+	    // ____1101
+	    char(Carry | TooLarge | TooLarge1000 | Surrogate),
+	    char(Carry | TooLarge | TooLarge1000),
+	    char(Carry | TooLarge | TooLarge1000));
+
+	const __m128i byte2HighTable = _mm_setr_epi8(
+	    // ________ 0_______ ASCII
+	    TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort,
+	    // ________ 1000____
+	    char(TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge1000 | Overlong4),
+	    // ________ 1001____
+	    char(TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge),
+	    // ________ 101_____
+	    char(TooLong | Overlong2 | TwoConts | Surrogate | TooLarge),
+	    char(TooLong | Overlong2 | TwoConts | Surrogate | TooLarge),
+	    // ________ 11______
+	    TooShort, TooShort, TooShort, TooShort);
+
+	__m128i byte1High = _mm_shuffle_epi8(byte1HighTable, _mm_and_si128(_mm_srli_epi16(prev1, 4), lowNibble));
+	__m128i byte1Low = _mm_shuffle_epi8(byte1LowTable, _mm_and_si128(prev1, lowNibble));
+	__m128i byte2High = _mm_shuffle_epi8(byte2HighTable, _mm_and_si128(_mm_srli_epi16(input, 4), lowNibble));
+	return _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+}
+
+// Accumulates the errors in the 16 bytes of `input` into `error`, `prevInput`
+// is the block before it.
+QUANTUMJSON_TARGET("ssse3")
+inline
+void CheckUtf8Block(__m128i input, __m128i prevInput, __m128i *error)
+{
+	__m128i prev1 = _mm_alignr_epi8(input, prevInput, 16 - 1);
+	__m128i specialCases = Utf8SpecialCases(input, prev1);
+
+	// Second and third continuation bytes of 3 and 4 byte sequences, these
+	// are the only places where `TwoConts` is not an error
+	__m128i prev2 = _mm_alignr_epi8(input, prevInput, 16 - 2);
+	__m128i prev3 = _mm_alignr_epi8(input, prevInput, 16 - 3);
+	__m128i isThirdByte = _mm_subs_epu8(prev2, _mm_set1_epi8(char(0xe0 - 0x80)));
+	__m128i isFourthByte = _mm_subs_epu8(prev3, _mm_set1_epi8(char(0xf0 - 0x80)));
+	__m128i must23 = _mm_and_si128(_mm_or_si128(isThirdByte, isFourthByte), _mm_set1_epi8(char(0x80)));
+
+	*error = _mm_or_si128(*error, _mm_xor_si128(must23, specialCases));
+}
+
+// Non-zero where the block ends in the middle of a multi byte sequence
+QUANTUMJSON_TARGET("ssse3")
+inline
+__m128i IsIncompleteUtf8(__m128i input)
+{
+	const __m128i maxValue = _mm_setr_epi8(
+	    char(0xff), char(0xff), char(0xff), char(0xff), char(0xff), char(0xff), char(0xff), char(0xff),
+	    char(0xff), char(0xff), char(0xff), char(0xff), char(0xff),
+	    char(0xf0 - 1), char(0xe0 - 1), char(0xc0 - 1));
+	return _mm_subs_epu8(input, maxValue);
+}
+#endif
+
+// Kernels checking that [begin, end) is valid UTF-8, use the dispatching
+// `IsValidUtf8` instead.
+inline
+bool IsValidUtf8Scalar(const char *begin, const char *end)
+{
+	const char *p = begin;
+	while (p != end)
+	{
+		if (static_cast<unsigned char>(*p) < 0x80)
+		{
+			++p;
+			continue;
+		}
+
+		uint32_t codePoint;
+		size_t len = DecodeUtf8(p, end, &codePoint);
+		if (len == 0)
+		{
+			return false;
+		}
+		p += len;
+	}
+	return true;
+}
+
+#if QUANTUMJSON_BUILD_SSSE3
+QUANTUMJSON_TARGET("ssse3")
+inline
+bool IsValidUtf8Ssse3(const char *begin, const char *end)
+{
+	__m128i error = _mm_setzero_si128();
+	__m128i prevInput = _mm_setzero_si128();
+	__m128i prevIncomplete = _mm_setzero_si128();
+
+	const char *p = begin;
+	while (p != end)
+	{
+		__m128i input;
+		if (QUANTUMJSON_LIKELY(end - p >= 16))
+		{
+			input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			p += 16;
+		}
+		else
+		{
+			// Zeros are ASCII, they terminate the sequences before them
+			char tail[16] = {};
+			memcpy(tail, p, end - p);
+			input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tail));
+			p = end;
+		}
+
+		if (_mm_movemask_epi8(input) == 0)
+		{
+			// ASCII block, only the previous block could be wrong
+			error = _mm_or_si128(error, prevIncomplete);
+		}
+		else
+		{
+			CheckUtf8Block(input, prevInput, &error);
+			prevIncomplete = IsIncompleteUtf8(input);
+		}
+		prevInput = input;
+	}
+	error = _mm_or_si128(error, prevIncomplete);
+
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xffff;
+}
+#endif
+
+// Returns the length of the longest prefix of [begin, end) consisting of
+// decimal digits, checking 8 characters at a time where possible.
+inline
+size_t DigitRunLength(const char *begin, const char *end)
+{
+	const char *p = begin;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	while (end - p >= 8)
+	{
+		uint64_t x;
+		memcpy(&x, p, sizeof(x));
+		// Digits are 0x30-0x39, adding 6 keeps the high nibble at 3 only
+		// for them. Carries may only spoil bytes after a non-digit.
+		uint64_t nonDigit = ((x & 0xF0F0F0F0F0F0F0F0ULL) ^ 0x3030303030303030ULL)
+		    | (((x + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) ^ 0x3030303030303030ULL);
+		if (nonDigit != 0)
+		{
+			return (p - begin) + CountTrailingZeros(nonDigit) / 8;
+		}
+		p += 8;
+	}
+#endif
+
+	while (p != end && *p >= '0' && *p <= '9')
+	{
+		++p;
+	}
+	return p - begin;
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+// Returns the number of leading decimal digits in 8 characters loaded as
+// little endian.
+inline
+int LeadingDigitCount(uint64_t x)
+{
+	uint64_t nonDigit = ((x & 0xF0F0F0F0F0F0F0F0ULL) ^ 0x3030303030303030ULL)
+	    | (((x + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) ^ 0x3030303030303030ULL);
+	return nonDigit == 0 ? 8 : CountTrailingZeros(nonDigit) / 8;
+}
+
+// Checks if 8 characters loaded as little endian are all decimal digits.
+inline
+bool IsEightDigits(uint64_t x)
+{
+	return (((x & 0xF0F0F0F0F0F0F0F0ULL)
+	      | (((x + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4))
+	    == 0x3333333333333333ULL);
+}
+
+// Returns the value of 8 decimal digits loaded as little endian, by
+// combining pairs of digits, then pairs of those in each step.
+inline
+uint32_t ParseEightDigits(uint64_t x)
+{
+	const uint64_t mask = 0x000000FF000000FFULL;
+	const uint64_t mul1 = 0x000F424000000064ULL; // 100 + (1000000 << 32)
+	const uint64_t mul2 = 0x0000271000000001ULL; // 1 + (10000 << 32)
+	x -= 0x3030303030303030ULL;
+	x = (x * 10) + (x >> 8);
+	x = (((x & mask) * mul1) + (((x >> 16) & mask) * mul2)) >> 32;
+	return static_cast<uint32_t>(x);
+}
+#endif
+
+// Character classes of a 64 byte block of input, bit `i` of each mask
+// corresponds to the byte `i` of the block.
+struct BlockMasks
+{
+	uint64_t quote;
+	uint64_t backslash;
+	uint64_t control;
+	uint64_t whitespace;
+	uint64_t op; // One of {}[]:,
+};
+
+// Kernels classifying the 64 bytes at `block`, use the `classifyBlock` of
+// `ActiveKernels()` instead.
+inline
+void ClassifyBlockScalar(const char *block, BlockMasks *out)
+{
+	*out = BlockMasks{0, 0, 0, 0, 0};
+	for (int i = 0; i < 64; ++i)
+	{
+		char c = block[i];
+		uint64_t bit = uint64_t(1) << i;
+		if (c == '"') out->quote |= bit;
+		if (c == '\\') out->backslash |= bit;
+		if (static_cast<unsigned char>(c) < 0x20) out->control |= bit;
+		if (c == ' ' || c == '\t' || c == '\n' || c == '\r') out->whitespace |= bit;
+		if (c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',') out->op |= bit;
+	}
+}
+
+#if QUANTUMJSON_HAVE_SSE2
+inline
+void ClassifyBlockSse2(const char *block, BlockMasks *out)
+{
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	const __m128i maxControl = _mm_set1_epi8(0x1f);
+	const __m128i space = _mm_set1_epi8(' ');
+	const __m128i tab = _mm_set1_epi8('\t');
+	const __m128i lf = _mm_set1_epi8('\n');
+	const __m128i cr = _mm_set1_epi8('\r');
+	// Setting 0x20 bit maps '[' to '{' and ']' to '}'
+	const __m128i bracketBit = _mm_set1_epi8(0x20);
+	const __m128i braceOpen = _mm_set1_epi8('{');
+	const __m128i braceClose = _mm_set1_epi8('}');
+	const __m128i colon = _mm_set1_epi8(':');
+	const __m128i comma = _mm_set1_epi8(',');
+
+	*out = BlockMasks{0, 0, 0, 0, 0};
+	for (int i = 0; i < 4; ++i)
+	{
+		__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+		__m128i b = _mm_or_si128(v, bracketBit);
+		int shift = 16 * i;
+
+		out->quote |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, quote)))) << shift;
+		out->backslash |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, backslash)))) << shift;
+		out->control |= uint64_t(uint16_t(_mm_movemask_epi8(
+		    _mm_cmpeq_epi8(_mm_max_epu8(v, maxControl), maxControl)))) << shift;
+		out->whitespace |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_or_si128(
+		    _mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+		    _mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, cr)))))) << shift;
+		out->op |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_or_si128(
+		    _mm_or_si128(_mm_cmpeq_epi8(b, braceOpen), _mm_cmpeq_epi8(b, braceClose)),
+		    _mm_or_si128(_mm_cmpeq_epi8(v, colon), _mm_cmpeq_epi8(v, comma)))))) << shift;
+	}
+}
+#endif
+
+#if QUANTUMJSON_BUILD_AVX2
+QUANTUMJSON_TARGET("avx2")
+inline
+void ClassifyBlockAvx2(const char *block, BlockMasks *out)
+{
+	const __m256i quote = _mm256_set1_epi8('"');
+	const __m256i backslash = _mm256_set1_epi8('\\');
+	const __m256i maxControl = _mm256_set1_epi8(0x1f);
+	const __m256i space = _mm256_set1_epi8(' ');
+	const __m256i tab = _mm256_set1_epi8('\t');
+	const __m256i lf = _mm256_set1_epi8('\n');
+	const __m256i cr = _mm256_set1_epi8('\r');
+	const __m256i bracketBit = _mm256_set1_epi8(0x20);
+	const __m256i braceOpen = _mm256_set1_epi8('{');
+	const __m256i braceClose = _mm256_set1_epi8('}');
+	const __m256i colon = _mm256_set1_epi8(':');
+	const __m256i comma = _mm256_set1_epi8(',');
+
+	*out = BlockMasks{0, 0, 0, 0, 0};
+	for (int i = 0; i < 2; ++i)
+	{
+		__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32 * i));
+		__m256i b = _mm256_or_si256(v, bracketBit);
+		int shift = 32 * i;
+
+		out->quote |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, quote)))) << shift;
+		out->backslash |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, backslash)))) << shift;
+		out->control |= uint64_t(uint32_t(_mm256_movemask_epi8(
+		    _mm256_cmpeq_epi8(_mm256_max_epu8(v, maxControl), maxControl)))) << shift;
+		out->whitespace |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_or_si256(
+		    _mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, tab)),
+		    _mm256_or_si256(_mm256_cmpeq_epi8(v, lf), _mm256_cmpeq_epi8(v, cr)))))) << shift;
+		out->op |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_or_si256(
+		    _mm256_or_si256(_mm256_cmpeq_epi8(b, braceOpen), _mm256_cmpeq_epi8(b, braceClose)),
+		    _mm256_or_si256(_mm256_cmpeq_epi8(v, colon), _mm256_cmpeq_epi8(v, comma)))))) << shift;
+	}
+}
+#endif
+
+#if QUANTUMJSON_BUILD_AVX512
+QUANTUMJSON_TARGET("avx512f,avx512bw")
+inline
+void ClassifyBlockAvx512(const char *block, BlockMasks *out)
+{
+	__m512i v = _mm512_loadu_si512(block);
+	__m512i b = _mm512_or_si512(v, _mm512_set1_epi8(0x20));
+
+	out->quote = _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8('"'));
+	out->backslash = _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8('\\'));
+	out->control = _mm512_cmplt_epu8_mask(v, _mm512_set1_epi8(0x20));
+	out->whitespace = _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8(' '))
+	                | _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8('\t'))
+	                | _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8('\n'))
+	                | _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8('\r'));
+	out->op = _mm512_cmpeq_epi8_mask(b, _mm512_set1_epi8('{'))
+	        | _mm512_cmpeq_epi8_mask(b, _mm512_set1_epi8('}'))
+	        | _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8(':'))
+	        | _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8(','));
+}
+#endif
+
+// Widest instruction set with kernels that the CPU supports
+enum class SimdLevel
+{
+	Scalar,
+	Sse2,
+	Ssse3,
+	Avx2,
+	Avx512,
+};
+
+inline
+SimdLevel DetectSimdLevel()
+{
+#if QUANTUMJSON_RUNTIME_DISPATCH
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+	{
+		return SimdLevel::Avx512;
+	}
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return SimdLevel::Avx2;
+	}
+	if (__builtin_cpu_supports("ssse3"))
+	{
+		return SimdLevel::Ssse3;
+	}
+	return SimdLevel::Sse2;
+#elif QUANTUMJSON_HAVE_AVX512
+	return SimdLevel::Avx512;
+#elif QUANTUMJSON_HAVE_AVX2
+	return SimdLevel::Avx2;
+#elif QUANTUMJSON_HAVE_SSSE3
+	return SimdLevel::Ssse3;
+#elif QUANTUMJSON_HAVE_SSE2
+	return SimdLevel::Sse2;
+#else
+	return SimdLevel::Scalar;
+#endif
+}
+
+// Kernels the scanning functions below dispatch to
+struct Kernels
+{
+	size_t (*runLength[static_cast<int>(StopAt::Count)])(const char *begin, const char *end);
+	bool (*isValidUtf8)(const char *begin, const char *end);
+	void (*classifyBlock)(const char *block, BlockMasks *out);
+};
+
+// Returns the widest kernels up to `level`. Levels without kernels of their
+// own use the ones below, e.g. AVX-512 validates UTF-8 with SSSE3.
+inline
+Kernels KernelsFor(SimdLevel level)
+{
+	Kernels kernels;
+	kernels.runLength[static_cast<int>(StopAt::PlainStringEnd)] = RunLengthScalar<StopAt::PlainStringEnd>;
+	kernels.runLength[static_cast<int>(StopAt::EscapeFreeEnd)] = RunLengthScalar<StopAt::EscapeFreeEnd>;
+	kernels.runLength[static_cast<int>(StopAt::QuoteOrBackslash)] = RunLengthScalar<StopAt::QuoteOrBackslash>;
+	kernels.runLength[static_cast<int>(StopAt::NonWhitespace)] = RunLengthScalar<StopAt::NonWhitespace>;
+	kernels.isValidUtf8 = IsValidUtf8Scalar;
+	kernels.classifyBlock = ClassifyBlockScalar;
+
+#if QUANTUMJSON_HAVE_SSE2
+	if (level >= SimdLevel::Sse2)
+	{
+		kernels.runLength[static_cast<int>(StopAt::PlainStringEnd)] = RunLengthSse2<StopAt::PlainStringEnd>;
+		kernels.runLength[static_cast<int>(StopAt::EscapeFreeEnd)] = RunLengthSse2<StopAt::EscapeFreeEnd>;
+		kernels.runLength[static_cast<int>(StopAt::QuoteOrBackslash)] = RunLengthSse2<StopAt::QuoteOrBackslash>;
+		kernels.runLength[static_cast<int>(StopAt::NonWhitespace)] = RunLengthSse2<StopAt::NonWhitespace>;
+		kernels.classifyBlock = ClassifyBlockSse2;
+	}
+#endif
+
+#if QUANTUMJSON_BUILD_SSSE3
+	if (level >= SimdLevel::Ssse3)
+	{
+		kernels.isValidUtf8 = IsValidUtf8Ssse3;
+	}
+#endif
+
+#if QUANTUMJSON_BUILD_AVX2
+	if (level >= SimdLevel::Avx2)
+	{
+		kernels.runLength[static_cast<int>(StopAt::PlainStringEnd)] = RunLengthAvx2<StopAt::PlainStringEnd>;
+		kernels.runLength[static_cast<int>(StopAt::EscapeFreeEnd)] = RunLengthAvx2<StopAt::EscapeFreeEnd>;
+		kernels.runLength[static_cast<int>(StopAt::QuoteOrBackslash)] = RunLengthAvx2<StopAt::QuoteOrBackslash>;
+		kernels.runLength[static_cast<int>(StopAt::NonWhitespace)] = RunLengthAvx2<StopAt::NonWhitespace>;
+		kernels.classifyBlock = ClassifyBlockAvx2;
+	}
+#endif
+
+#if QUANTUMJSON_BUILD_AVX512
+	if (level >= SimdLevel::Avx512)
+	{
+		kernels.runLength[static_cast<int>(StopAt::PlainStringEnd)] = RunLengthAvx512<StopAt::PlainStringEnd>;
+		kernels.runLength[static_cast<int>(StopAt::EscapeFreeEnd)] = RunLengthAvx512<StopAt::EscapeFreeEnd>;
+		kernels.runLength[static_cast<int>(StopAt::QuoteOrBackslash)] = RunLengthAvx512<StopAt::QuoteOrBackslash>;
+		kernels.runLength[static_cast<int>(StopAt::NonWhitespace)] = RunLengthAvx512<StopAt::NonWhitespace>;
+		kernels.classifyBlock = ClassifyBlockAvx512;
+	}
+#endif
+
+	return kernels;
+}
+
+// Kernels for the CPU, picked once at first use. Tests replace them to run
+// the narrower ones.
+inline
+Kernels& ActiveKernels()
+{
+	static Kernels kernels = KernelsFor(DetectSimdLevel());
+	return kernels;
+}
+
+// Runs ending in the first 16 bytes, which are most of the strings and
+// whitespace between tokens, are found inline. Only longer ones call the
+// kernel picked for the CPU.
+template <StopAt stop>
+inline
+size_t RunLength(const char *begin, const char *end)
+{
+#if QUANTUMJSON_HAVE_SSE2
+	if (QUANTUMJSON_LIKELY(end - begin >= 16))
+	{
+		uint32_t mask = StopMaskSse2<stop>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(begin)));
+		if (QUANTUMJSON_LIKELY(mask != 0))
+		{
+			return CountTrailingZeros(mask);
+		}
+		return 16 + ActiveKernels().runLength[static_cast<int>(stop)](begin + 16, end);
+	}
+#endif
+	return ActiveKernels().runLength[static_cast<int>(stop)](begin, end);
+}
+
+// Returns the length of the longest prefix of [begin, end) consisting of
+// plain string characters. Used to copy/skip the bulk of string values at
+// once, stopping at '"', '\\', control characters and non-ASCII bytes.
+inline
+size_t PlainStringRunLength(const char *begin, const char *end)
+{
+	return RunLength<StopAt::PlainStringEnd>(begin, end);
+}
+
+// Returns the length of the whitespace prefix of [begin, end). Pretty
+// printed json has runs of indentation between tokens, these are skipped
+// a block at a time.
+inline
+size_t WhitespaceRunLength(const char *begin, const char *end)
+{
+	return RunLength<StopAt::NonWhitespace>(begin, end);
+}
+
+// Returns the length of the longest prefix of [begin, end) that can be
+// written into a json string as is, stopping at '"', '\\' and control
+// characters. Unlike `PlainStringRunLength` non-ASCII bytes are accepted.
+inline
+size_t EscapeFreeRunLength(const char *begin, const char *end)
+{
+	return RunLength<StopAt::EscapeFreeEnd>(begin, end);
+}
+
+// Returns the length of the longest prefix of [begin, end) without '"' and
+// '\\'. Used for trusted inputs, where string contents are copied without
+// looking for control characters or validating UTF-8.
+inline
+size_t QuoteOrBackslashRunLength(const char *begin, const char *end)
+{
+	return RunLength<StopAt::QuoteOrBackslash>(begin, end);
+}
+
+// Checks that [begin, end) is valid UTF-8. Overlong encodings, surrogates,
+// code points above U+10FFFF and truncated sequences are rejected.
+inline
+bool IsValidUtf8(const char *begin, const char *end)
+{
+	return ActiveKernels().isValidUtf8(begin, end);
+}
+
+// Returns the mask of characters escaped by a backslash. `nextIsEscaped`
+// carries the state between consecutive blocks, and is set when the block
+// ends with an odd number of backslashes.
+inline
+uint64_t FindEscapedChars(uint64_t backslash, uint64_t *nextIsEscaped)
+{
+	const uint64_t evenBits = 0x5555555555555555ULL;
+
+	backslash &= ~*nextIsEscaped;
+	uint64_t followsEscape = (backslash << 1) | *nextIsEscaped;
+
+	// Adding the starts of odd positioned backslash sequences carries over
+	// the sequence, leaving the bits after sequences of odd length set.
+	uint64_t oddSequenceStarts = backslash & ~evenBits & ~followsEscape;
+	uint64_t sequencesStartingOnEvenBits = oddSequenceStarts + backslash;
+	*nextIsEscaped = sequencesStartingOnEvenBits < oddSequenceStarts;
+
+	uint64_t invertMask = sequencesStartingOnEvenBits << 1;
+	return (evenBits ^ invertMask) & followsEscape;
+}
+
+// Bit `i` of the result is the parity of set bits in `x` up to `i`.
+inline
+uint64_t PrefixXor(uint64_t x)
+{
+	x ^= x << 1;
+	x ^= x << 2;
+	x ^= x << 4;
+	x ^= x << 8;
+	x ^= x << 16;
+	x ^= x << 32;
+	return x;
+}
+
+// Truncated 128 bit approximations of 5^q for q in [-342, 308], shifted so
+// that the most significant bit is set. Each entry is the high and low
+// 64 bits respectively.
+inline const uint64_t PowersOfFive128[] = {
+	0xeef453d6923bd65aULL, 0x113faa2906a13b3fULL,
+	0x9558b4661b6565f8ULL, 0x4ac7ca59a424c507ULL,
+	0xbaaee17fa23ebf76ULL, 0x5d79bcf00d2df649ULL,
+	0xe95a99df8ace6f53ULL, 0xf4d82c2c107973dcULL,
+	0x91d8a02bb6c10594ULL, 0x79071b9b8a4be869ULL,
+	0xb64ec836a47146f9ULL, 0x9748e2826cdee284ULL,
+	0xe3e27a444d8d98b7ULL, 0xfd1b1b2308169b25ULL,
+	0x8e6d8c6ab0787f72ULL, 0xfe30f0f5e50e20f7ULL,
+	0xb208ef855c969f4fULL, 0xbdbd2d335e51a935ULL,
+	0xde8b2b66b3bc4723ULL, 0xad2c788035e61382ULL,
+	0x8b16fb203055ac76ULL, 0x4c3bcb5021afcc31ULL,
+	0xaddcb9e83c6b1793ULL, 0xdf4abe242a1bbf3dULL,
+	0xd953e8624b85dd78ULL, 0xd71d6dad34a2af0dULL,
+	0x87d4713d6f33aa6bULL, 0x8672648c40e5ad68ULL,
+	0xa9c98d8ccb009506ULL, 0x680efdaf511f18c2ULL,
+	0xd43bf0effdc0ba48ULL, 0x0212bd1b2566def2ULL,
+	0x84a57695fe98746dULL, 0x014bb630f7604b57ULL,
+	0xa5ced43b7e3e9188ULL, 0x419ea3bd35385e2dULL,
+	0xcf42894a5dce35eaULL, 0x52064cac828675b9ULL,
+	0x818995ce7aa0e1b2ULL, 0x7343efebd1940993ULL,
+	0xa1ebfb4219491a1fULL, 0x1014ebe6c5f90bf8ULL,
+	0xca66fa129f9b60a6ULL, 0xd41a26e077774ef6ULL,
+	0xfd00b897478238d0ULL, 0x8920b098955522b4ULL,
+	0x9e20735e8cb16382ULL, 0x55b46e5f5d5535b0ULL,
+	0xc5a890362fddbc62ULL, 0xeb2189f734aa831dULL,
+	0xf712b443bbd52b7bULL, 0xa5e9ec7501d523e4ULL,
+	0x9a6bb0aa55653b2dULL, 0x47b233c92125366eULL,
+	0xc1069cd4eabe89f8ULL, 0x999ec0bb696e840aULL,
+	0xf148440a256e2c76ULL, 0xc00670ea43ca250dULL,
+	0x96cd2a865764dbcaULL, 0x380406926a5e5728ULL,
+	0xbc807527ed3e12bcULL, 0xc605083704f5ecf2ULL,
+	0xeba09271e88d976bULL, 0xf7864a44c633682eULL,
+	0x93445b8731587ea3ULL, 0x7ab3ee6afbe0211dULL,
+	0xb8157268fdae9e4cULL, 0x5960ea05bad82964ULL,
+	0xe61acf033d1a45dfULL, 0x6fb92487298e33bdULL,
+	0x8fd0c16206306babULL, 0xa5d3b6d479f8e056ULL,
+	0xb3c4f1ba87bc8696ULL, 0x8f48a4899877186cULL,
+	0xe0b62e2929aba83cULL, 0x331acdabfe94de87ULL,
+	0x8c71dcd9ba0b4925ULL, 0x9ff0c08b7f1d0b14ULL,
+	0xaf8e5410288e1b6fULL, 0x07ecf0ae5ee44dd9ULL,
+	0xdb71e91432b1a24aULL, 0xc9e82cd9f69d6150ULL,
+	0x892731ac9faf056eULL, 0xbe311c083a225cd2ULL,
+	0xab70fe17c79ac6caULL, 0x6dbd630a48aaf406ULL,
+	0xd64d3d9db981787dULL, 0x092cbbccdad5b108ULL,
+	0x85f0468293f0eb4eULL, 0x25bbf56008c58ea5ULL,
+	0xa76c582338ed2621ULL, 0xaf2af2b80af6f24eULL,
+	0xd1476e2c07286faaULL, 0x1af5af660db4aee1ULL,
+	0x82cca4db847945caULL, 0x50d98d9fc890ed4dULL,
+	0xa37fce126597973cULL, 0xe50ff107bab528a0ULL,
+	0xcc5fc196fefd7d0cULL, 0x1e53ed49a96272c8ULL,
+	0xff77b1fcbebcdc4fULL, 0x25e8e89c13bb0f7aULL,
+	0x9faacf3df73609b1ULL, 0x77b191618c54e9acULL,
+	0xc795830d75038c1dULL, 0xd59df5b9ef6a2417ULL,
+	0xf97ae3d0d2446f25ULL, 0x4b0573286b44ad1dULL,
+	0x9becce62836ac577ULL, 0x4ee367f9430aec32ULL,
+	0xc2e801fb244576d5ULL, 0x229c41f793cda73fULL,
+	0xf3a20279ed56d48aULL, 0x6b43527578c1110fULL,
+	0x9845418c345644d6ULL, 0x830a13896b78aaa9ULL,
+	0xbe5691ef416bd60cULL, 0x23cc986bc656d553ULL,
+	0xedec366b11c6cb8fULL, 0x2cbfbe86b7ec8aa8ULL,
+	0x94b3a202eb1c3f39ULL, 0x7bf7d71432f3d6a9ULL,
+	0xb9e08a83a5e34f07ULL, 0xdaf5ccd93fb0cc53ULL,
+	0xe858ad248f5c22c9ULL, 0xd1b3400f8f9cff68ULL,
+	0x91376c36d99995beULL, 0x23100809b9c21fa1ULL,
+	0xb58547448ffffb2dULL, 0xabd40a0c2832a78aULL,
+	0xe2e69915b3fff9f9ULL, 0x16c90c8f323f516cULL,
+	0x8dd01fad907ffc3bULL, 0xae3da7d97f6792e3ULL,
+	0xb1442798f49ffb4aULL, 0x99cd11cfdf41779cULL,
+	0xdd95317f31c7fa1dULL, 0x40405643d711d583ULL,
+	0x8a7d3eef7f1cfc52ULL, 0x482835ea666b2572ULL,
+	0xad1c8eab5ee43b66ULL, 0xda3243650005eecfULL,
+	0xd863b256369d4a40ULL, 0x90bed43e40076a82ULL,
+	0x873e4f75e2224e68ULL, 0x5a7744a6e804a291ULL,
+	0xa90de3535aaae202ULL, 0x711515d0a205cb36ULL,
+	0xd3515c2831559a83ULL, 0x0d5a5b44ca873e03ULL,
+	0x8412d9991ed58091ULL, 0xe858790afe9486c2ULL,
+	0xa5178fff668ae0b6ULL, 0x626e974dbe39a872ULL,
+	0xce5d73ff402d98e3ULL, 0xfb0a3d212dc8128fULL,
+	0x80fa687f881c7f8eULL, 0x7ce66634bc9d0b99ULL,
+	0xa139029f6a239f72ULL, 0x1c1fffc1ebc44e80ULL,
+	0xc987434744ac874eULL, 0xa327ffb266b56220ULL,
+	0xfbe9141915d7a922ULL, 0x4bf1ff9f0062baa8ULL,
+	0x9d71ac8fada6c9b5ULL, 0x6f773fc3603db4a9ULL,
+	0xc4ce17b399107c22ULL, 0xcb550fb4384d21d3ULL,
+	0xf6019da07f549b2bULL, 0x7e2a53a146606a48ULL,
+	0x99c102844f94e0fbULL, 0x2eda7444cbfc426dULL,
+	0xc0314325637a1939ULL, 0xfa911155fefb5308ULL,
+	0xf03d93eebc589f88ULL, 0x793555ab7eba27caULL,
+	0x96267c7535b763b5ULL, 0x4bc1558b2f3458deULL,
+	0xbbb01b9283253ca2ULL, 0x9eb1aaedfb016f16ULL,
+	0xea9c227723ee8bcbULL, 0x465e15a979c1cadcULL,
+	0x92a1958a7675175fULL, 0x0bfacd89ec191ec9ULL,
+	0xb749faed14125d36ULL, 0xcef980ec671f667bULL,
+	0xe51c79a85916f484ULL, 0x82b7e12780e7401aULL,
+	0x8f31cc0937ae58d2ULL, 0xd1b2ecb8b0908810ULL,
+	0xb2fe3f0b8599ef07ULL, 0x861fa7e6dcb4aa15ULL,
+	0xdfbdcece67006ac9ULL, 0x67a791e093e1d49aULL,
+	0x8bd6a141006042bdULL, 0xe0c8bb2c5c6d24e0ULL,
+	0xaecc49914078536dULL, 0x58fae9f773886e18ULL,
+	0xda7f5bf590966848ULL, 0xaf39a475506a899eULL,
+	0x888f99797a5e012dULL, 0x6d8406c952429603ULL,
+	0xaab37fd7d8f58178ULL, 0xc8e5087ba6d33b83ULL,
+	0xd5605fcdcf32e1d6ULL, 0xfb1e4a9a90880a64ULL,
+	0x855c3be0a17fcd26ULL, 0x5cf2eea09a55067fULL,
+	0xa6b34ad8c9dfc06fULL, 0xf42faa48c0ea481eULL,
+	0xd0601d8efc57b08bULL, 0xf13b94daf124da26ULL,
+	0x823c12795db6ce57ULL, 0x76c53d08d6b70858ULL,
+	0xa2cb1717b52481edULL, 0x54768c4b0c64ca6eULL,
+	0xcb7ddcdda26da268ULL, 0xa9942f5dcf7dfd09ULL,
+	0xfe5d54150b090b02ULL, 0xd3f93b35435d7c4cULL,
+	0x9efa548d26e5a6e1ULL, 0xc47bc5014a1a6dafULL,
+	0xc6b8e9b0709f109aULL, 0x359ab6419ca1091bULL,
+	0xf867241c8cc6d4c0ULL, 0xc30163d203c94b62ULL,
+	0x9b407691d7fc44f8ULL, 0x79e0de63425dcf1dULL,
+	0xc21094364dfb5636ULL, 0x985915fc12f542e4ULL,
+	0xf294b943e17a2bc4ULL, 0x3e6f5b7b17b2939dULL,
+	0x979cf3ca6cec5b5aULL, 0xa705992ceecf9c42ULL,
+	0xbd8430bd08277231ULL, 0x50c6ff782a838353ULL,
+	0xece53cec4a314ebdULL, 0xa4f8bf5635246428ULL,
+	0x940f4613ae5ed136ULL, 0x871b7795e136be99ULL,
+	0xb913179899f68584ULL, 0x28e2557b59846e3fULL,
+	0xe757dd7ec07426e5ULL, 0x331aeada2fe589cfULL,
+	0x9096ea6f3848984fULL, 0x3ff0d2c85def7621ULL,
+	0xb4bca50b065abe63ULL, 0x0fed077a756b53a9ULL,
+	0xe1ebce4dc7f16dfbULL, 0xd3e8495912c62894ULL,
+	0x8d3360f09cf6e4bdULL, 0x64712dd7abbbd95cULL,
+	0xb080392cc4349decULL, 0xbd8d794d96aacfb3ULL,
+	0xdca04777f541c567ULL, 0xecf0d7a0fc5583a0ULL,
+	0x89e42caaf9491b60ULL, 0xf41686c49db57244ULL,
+	0xac5d37d5b79b6239ULL, 0x311c2875c522ced5ULL,
+	0xd77485cb25823ac7ULL, 0x7d633293366b828bULL,
+	0x86a8d39ef77164bcULL, 0xae5dff9c02033197ULL,
+	0xa8530886b54dbdebULL, 0xd9f57f830283fdfcULL,
+	0xd267caa862a12d66ULL, 0xd072df63c324fd7bULL,
+	0x8380dea93da4bc60ULL, 0x4247cb9e59f71e6dULL,
+	0xa46116538d0deb78ULL, 0x52d9be85f074e608ULL,
+	0xcd795be870516656ULL, 0x67902e276c921f8bULL,
+	0x806bd9714632dff6ULL, 0x00ba1cd8a3db53b6ULL,
+	0xa086cfcd97bf97f3ULL, 0x80e8a40eccd228a4ULL,
+	0xc8a883c0fdaf7df0ULL, 0x6122cd128006b2cdULL,
+	0xfad2a4b13d1b5d6cULL, 0x796b805720085f81ULL,
+	0x9cc3a6eec6311a63ULL, 0xcbe3303674053bb0ULL,
+	0xc3f490aa77bd60fcULL, 0xbedbfc4411068a9cULL,
+	0xf4f1b4d515acb93bULL, 0xee92fb5515482d44ULL,
+	0x991711052d8bf3c5ULL, 0x751bdd152d4d1c4aULL,
+	0xbf5cd54678eef0b6ULL, 0xd262d45a78a0635dULL,
+	0xef340a98172aace4ULL, 0x86fb897116c87c34ULL,
+	0x9580869f0e7aac0eULL, 0xd45d35e6ae3d4da0ULL,
+	0xbae0a846d2195712ULL, 0x8974836059cca109ULL,
+	0xe998d258869facd7ULL, 0x2bd1a438703fc94bULL,
+	0x91ff83775423cc06ULL, 0x7b6306a34627ddcfULL,
+	0xb67f6455292cbf08ULL, 0x1a3bc84c17b1d542ULL,
+	0xe41f3d6a7377eecaULL, 0x20caba5f1d9e4a93ULL,
+	0x8e938662882af53eULL, 0x547eb47b7282ee9cULL,
+	0xb23867fb2a35b28dULL, 0xe99e619a4f23aa43ULL,
+	0xdec681f9f4c31f31ULL, 0x6405fa00e2ec94d4ULL,
+	0x8b3c113c38f9f37eULL, 0xde83bc408dd3dd04ULL,
+	0xae0b158b4738705eULL, 0x9624ab50b148d445ULL,
+	0xd98ddaee19068c76ULL, 0x3badd624dd9b0957ULL,
+	0x87f8a8d4cfa417c9ULL, 0xe54ca5d70a80e5d6ULL,
+	0xa9f6d30a038d1dbcULL, 0x5e9fcf4ccd211f4cULL,
+	0xd47487cc8470652bULL, 0x7647c3200069671fULL,
+	0x84c8d4dfd2c63f3bULL, 0x29ecd9f40041e073ULL,
+	0xa5fb0a17c777cf09ULL, 0xf468107100525890ULL,
+	0xcf79cc9db955c2ccULL, 0x7182148d4066eeb4ULL,
+	0x81ac1fe293d599bfULL, 0xc6f14cd848405530ULL,
+	0xa21727db38cb002fULL, 0xb8ada00e5a506a7cULL,
+	0xca9cf1d206fdc03bULL, 0xa6d90811f0e4851cULL,
+	0xfd442e4688bd304aULL, 0x908f4a166d1da663ULL,
+	0x9e4a9cec15763e2eULL, 0x9a598e4e043287feULL,
+	0xc5dd44271ad3cdbaULL, 0x40eff1e1853f29fdULL,
+	0xf7549530e188c128ULL, 0xd12bee59e68ef47cULL,
+	0x9a94dd3e8cf578b9ULL, 0x82bb74f8301958ceULL,
+	0xc13a148e3032d6e7ULL, 0xe36a52363c1faf01ULL,
+	0xf18899b1bc3f8ca1ULL, 0xdc44e6c3cb279ac1ULL,
+	0x96f5600f15a7b7e5ULL, 0x29ab103a5ef8c0b9ULL,
+	0xbcb2b812db11a5deULL, 0x7415d448f6b6f0e7ULL,
+	0xebdf661791d60f56ULL, 0x111b495b3464ad21ULL,
+	0x936b9fcebb25c995ULL, 0xcab10dd900beec34ULL,
+	0xb84687c269ef3bfbULL, 0x3d5d514f40eea742ULL,
+	0xe65829b3046b0afaULL, 0x0cb4a5a3112a5112ULL,
+	0x8ff71a0fe2c2e6dcULL, 0x47f0e785eaba72abULL,
+	0xb3f4e093db73a093ULL, 0x59ed216765690f56ULL,
+	0xe0f218b8d25088b8ULL, 0x306869c13ec3532cULL,
+	0x8c974f7383725573ULL, 0x1e414218c73a13fbULL,
+	0xafbd2350644eeacfULL, 0xe5d1929ef90898faULL,
+	0xdbac6c247d62a583ULL, 0xdf45f746b74abf39ULL,
+	0x894bc396ce5da772ULL, 0x6b8bba8c328eb783ULL,
+	0xab9eb47c81f5114fULL, 0x066ea92f3f326564ULL,
+	0xd686619ba27255a2ULL, 0xc80a537b0efefebdULL,
+	0x8613fd0145877585ULL, 0xbd06742ce95f5f36ULL,
+	0xa798fc4196e952e7ULL, 0x2c48113823b73704ULL,
+	0xd17f3b51fca3a7a0ULL, 0xf75a15862ca504c5ULL,
+	0x82ef85133de648c4ULL, 0x9a984d73dbe722fbULL,
+	0xa3ab66580d5fdaf5ULL, 0xc13e60d0d2e0ebbaULL,
+	0xcc963fee10b7d1b3ULL, 0x318df905079926a8ULL,
+	0xffbbcfe994e5c61fULL, 0xfdf17746497f7052ULL,
+	0x9fd561f1fd0f9bd3ULL, 0xfeb6ea8bedefa633ULL,
+	0xc7caba6e7c5382c8ULL, 0xfe64a52ee96b8fc0ULL,
+	0xf9bd690a1b68637bULL, 0x3dfdce7aa3c673b0ULL,
+	0x9c1661a651213e2dULL, 0x06bea10ca65c084eULL,
+	0xc31bfa0fe5698db8ULL, 0x486e494fcff30a62ULL,
+	0xf3e2f893dec3f126ULL, 0x5a89dba3c3efccfaULL,
+	0x986ddb5c6b3a76b7ULL, 0xf89629465a75e01cULL,
+	0xbe89523386091465ULL, 0xf6bbb397f1135823ULL,
+	0xee2ba6c0678b597fULL, 0x746aa07ded582e2cULL,
+	0x94db483840b717efULL, 0xa8c2a44eb4571cdcULL,
+	0xba121a4650e4ddebULL, 0x92f34d62616ce413ULL,
+	0xe896a0d7e51e1566ULL, 0x77b020baf9c81d17ULL,
+	0x915e2486ef32cd60ULL, 0x0ace1474dc1d122eULL,
+	0xb5b5ada8aaff80b8ULL, 0x0d819992132456baULL,
+	0xe3231912d5bf60e6ULL, 0x10e1fff697ed6c69ULL,
+	0x8df5efabc5979c8fULL, 0xca8d3ffa1ef463c1ULL,
+	0xb1736b96b6fd83b3ULL, 0xbd308ff8a6b17cb2ULL,
+	0xddd0467c64bce4a0ULL, 0xac7cb3f6d05ddbdeULL,
+	0x8aa22c0dbef60ee4ULL, 0x6bcdf07a423aa96bULL,
+	0xad4ab7112eb3929dULL, 0x86c16c98d2c953c6ULL,
+	0xd89d64d57a607744ULL, 0xe871c7bf077ba8b7ULL,
+	0x87625f056c7c4a8bULL, 0x11471cd764ad4972ULL,
+	0xa93af6c6c79b5d2dULL, 0xd598e40d3dd89bcfULL,
+	0xd389b47879823479ULL, 0x4aff1d108d4ec2c3ULL,
+	0x843610cb4bf160cbULL, 0xcedf722a585139baULL,
+	0xa54394fe1eedb8feULL, 0xc2974eb4ee658828ULL,
+	0xce947a3da6a9273eULL, 0x733d226229feea32ULL,
+	0x811ccc668829b887ULL, 0x0806357d5a3f525fULL,
+	0xa163ff802a3426a8ULL, 0xca07c2dcb0cf26f7ULL,
+	0xc9bcff6034c13052ULL, 0xfc89b393dd02f0b5ULL,
+	0xfc2c3f3841f17c67ULL, 0xbbac2078d443ace2ULL,
+	0x9d9ba7832936edc0ULL, 0xd54b944b84aa4c0dULL,
+	0xc5029163f384a931ULL, 0x0a9e795e65d4df11ULL,
+	0xf64335bcf065d37dULL, 0x4d4617b5ff4a16d5ULL,
+	0x99ea0196163fa42eULL, 0x504bced1bf8e4e45ULL,
+	0xc06481fb9bcf8d39ULL, 0xe45ec2862f71e1d6ULL,
+	0xf07da27a82c37088ULL, 0x5d767327bb4e5a4cULL,
+	0x964e858c91ba2655ULL, 0x3a6a07f8d510f86fULL,
+	0xbbe226efb628afeaULL, 0x890489f70a55368bULL,
+	0xeadab0aba3b2dbe5ULL, 0x2b45ac74ccea842eULL,
+	0x92c8ae6b464fc96fULL, 0x3b0b8bc90012929dULL,
+	0xb77ada0617e3bbcbULL, 0x09ce6ebb40173744ULL,
+	0xe55990879ddcaabdULL, 0xcc420a6a101d0515ULL,
+	0x8f57fa54c2a9eab6ULL, 0x9fa946824a12232dULL,
+	0xb32df8e9f3546564ULL, 0x47939822dc96abf9ULL,
+	0xdff9772470297ebdULL, 0x59787e2b93bc56f7ULL,
+	0x8bfbea76c619ef36ULL, 0x57eb4edb3c55b65aULL,
+	0xaefae51477a06b03ULL, 0xede622920b6b23f1ULL,
+	0xdab99e59958885c4ULL, 0xe95fab368e45ecedULL,
+	0x88b402f7fd75539bULL, 0x11dbcb0218ebb414ULL,
+	0xaae103b5fcd2a881ULL, 0xd652bdc29f26a119ULL,
+	0xd59944a37c0752a2ULL, 0x4be76d3346f0495fULL,
+	0x857fcae62d8493a5ULL, 0x6f70a4400c562ddbULL,
+	0xa6dfbd9fb8e5b88eULL, 0xcb4ccd500f6bb952ULL,
+	0xd097ad07a71f26b2ULL, 0x7e2000a41346a7a7ULL,
+	0x825ecc24c873782fULL, 0x8ed400668c0c28c8ULL,
+	0xa2f67f2dfa90563bULL, 0x728900802f0f32faULL,
+	0xcbb41ef979346bcaULL, 0x4f2b40a03ad2ffb9ULL,
+	0xfea126b7d78186bcULL, 0xe2f610c84987bfa8ULL,
+	0x9f24b832e6b0f436ULL, 0x0dd9ca7d2df4d7c9ULL,
+	0xc6ede63fa05d3143ULL, 0x91503d1c79720dbbULL,
+	0xf8a95fcf88747d94ULL, 0x75a44c6397ce912aULL,
+	0x9b69dbe1b548ce7cULL, 0xc986afbe3ee11abaULL,
+	0xc24452da229b021bULL, 0xfbe85badce996168ULL,
+	0xf2d56790ab41c2a2ULL, 0xfae27299423fb9c3ULL,
+	0x97c560ba6b0919a5ULL, 0xdccd879fc967d41aULL,
+	0xbdb6b8e905cb600fULL, 0x5400e987bbc1c920ULL,
+	0xed246723473e3813ULL, 0x290123e9aab23b68ULL,
+	0x9436c0760c86e30bULL, 0xf9a0b6720aaf6521ULL,
+	0xb94470938fa89bceULL, 0xf808e40e8d5b3e69ULL,
+	0xe7958cb87392c2c2ULL, 0xb60b1d1230b20e04ULL,
+	0x90bd77f3483bb9b9ULL, 0xb1c6f22b5e6f48c2ULL,
+	0xb4ecd5f01a4aa828ULL, 0x1e38aeb6360b1af3ULL,
+	0xe2280b6c20dd5232ULL, 0x25c6da63c38de1b0ULL,
+	0x8d590723948a535fULL, 0x579c487e5a38ad0eULL,
+	0xb0af48ec79ace837ULL, 0x2d835a9df0c6d851ULL,
+	0xdcdb1b2798182244ULL, 0xf8e431456cf88e65ULL,
+	0x8a08f0f8bf0f156bULL, 0x1b8e9ecb641b58ffULL,
+	0xac8b2d36eed2dac5ULL, 0xe272467e3d222f3fULL,
+	0xd7adf884aa879177ULL, 0x5b0ed81dcc6abb0fULL,
+	0x86ccbb52ea94baeaULL, 0x98e947129fc2b4e9ULL,
+	0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL,
+	0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL,
+	0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL,
+	0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL,
+	0xcdb02555653131b6ULL, 0x3792f412cb06794dULL,
+	0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd0ULL,
+	0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL,
+	0xc8de047564d20a8bULL, 0xf245825a5a445275ULL,
+	0xfb158592be068d2eULL, 0xeed6e2f0f0d56712ULL,
+	0x9ced737bb6c4183dULL, 0x55464dd69685606bULL,
+	0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL,
+	0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL,
+	0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL,
+	0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL,
+	0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL,
+	0x95a8637627989aadULL, 0xdde7001379a44aa8ULL,
+	0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL,
+	0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a6ULL,
+	0x9226712162ab070dULL, 0xcab3961304ca70e8ULL,
+	0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL,
+	0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506aULL,
+	0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL,
+	0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL,
+	0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL,
+	0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL,
+	0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL,
+	0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL,
+	0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL,
+	0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL,
+	0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL,
+	0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL,
+	0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL,
+	0xcfb11ead453994baULL, 0x67de18eda5814af2ULL,
+	0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL,
+	0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL,
+	0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL,
+	0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL,
+	0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL,
+	0xc612062576589ddaULL, 0x95364afe032a819eULL,
+	0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL,
+	0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL,
+	0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL,
+	0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL,
+	0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL,
+	0xbce5086492111aeaULL, 0x88f4bb1ca6bcf585ULL,
+	0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL,
+	0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL,
+	0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL,
+	0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL,
+	0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL,
+	0xb424dc35095cd80fULL, 0x538484c19ef38c95ULL,
+	0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL,
+	0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL,
+	0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL,
+	0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL,
+	0x89705f4136b4a597ULL, 0x31680a88f8953031ULL,
+	0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3eULL,
+	0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL,
+	0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL,
+	0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL,
+	0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL,
+	0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL,
+	0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL,
+	0xccccccccccccccccULL, 0xcccccccccccccccdULL,
+	0x8000000000000000ULL, 0x0000000000000000ULL,
+	0xa000000000000000ULL, 0x0000000000000000ULL,
+	0xc800000000000000ULL, 0x0000000000000000ULL,
+	0xfa00000000000000ULL, 0x0000000000000000ULL,
+	0x9c40000000000000ULL, 0x0000000000000000ULL,
+	0xc350000000000000ULL, 0x0000000000000000ULL,
+	0xf424000000000000ULL, 0x0000000000000000ULL,
+	0x9896800000000000ULL, 0x0000000000000000ULL,
+	0xbebc200000000000ULL, 0x0000000000000000ULL,
+	0xee6b280000000000ULL, 0x0000000000000000ULL,
+	0x9502f90000000000ULL, 0x0000000000000000ULL,
+	0xba43b74000000000ULL, 0x0000000000000000ULL,
+	0xe8d4a51000000000ULL, 0x0000000000000000ULL,
+	0x9184e72a00000000ULL, 0x0000000000000000ULL,
+	0xb5e620f480000000ULL, 0x0000000000000000ULL,
+	0xe35fa931a0000000ULL, 0x0000000000000000ULL,
+	0x8e1bc9bf04000000ULL, 0x0000000000000000ULL,
+	0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL,
+	0xde0b6b3a76400000ULL, 0x0000000000000000ULL,
+	0x8ac7230489e80000ULL, 0x0000000000000000ULL,
+	0xad78ebc5ac620000ULL, 0x0000000000000000ULL,
+	0xd8d726b7177a8000ULL, 0x0000000000000000ULL,
+	0x878678326eac9000ULL, 0x0000000000000000ULL,
+	0xa968163f0a57b400ULL, 0x0000000000000000ULL,
+	0xd3c21bcecceda100ULL, 0x0000000000000000ULL,
+	0x84595161401484a0ULL, 0x0000000000000000ULL,
+	0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL,
+	0xcecb8f27f4200f3aULL, 0x0000000000000000ULL,
+	0x813f3978f8940984ULL, 0x4000000000000000ULL,
+	0xa18f07d736b90be5ULL, 0x5000000000000000ULL,
+	0xc9f2c9cd04674edeULL, 0xa400000000000000ULL,
+	0xfc6f7c4045812296ULL, 0x4d00000000000000ULL,
+	0x9dc5ada82b70b59dULL, 0xf020000000000000ULL,
+	0xc5371912364ce305ULL, 0x6c28000000000000ULL,
+	0xf684df56c3e01bc6ULL, 0xc732000000000000ULL,
+	0x9a130b963a6c115cULL, 0x3c7f400000000000ULL,
+	0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL,
+	0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL,
+	0x96769950b50d88f4ULL, 0x1314448000000000ULL,
+	0xbc143fa4e250eb31ULL, 0x17d955a000000000ULL,
+	0xeb194f8e1ae525fdULL, 0x5dcfab0800000000ULL,
+	0x92efd1b8d0cf37beULL, 0x5aa1cae500000000ULL,
+	0xb7abc627050305adULL, 0xf14a3d9e40000000ULL,
+	0xe596b7b0c643c719ULL, 0x6d9ccd05d0000000ULL,
+	0x8f7e32ce7bea5c6fULL, 0xe4820023a2000000ULL,
+	0xb35dbf821ae4f38bULL, 0xdda2802c8a800000ULL,
+	0xe0352f62a19e306eULL, 0xd50b2037ad200000ULL,
+	0x8c213d9da502de45ULL, 0x4526f422cc340000ULL,
+	0xaf298d050e4395d6ULL, 0x9670b12b7f410000ULL,
+	0xdaf3f04651d47b4cULL, 0x3c0cdd765f114000ULL,
+	0x88d8762bf324cd0fULL, 0xa5880a69fb6ac800ULL,
+	0xab0e93b6efee0053ULL, 0x8eea0d047a457a00ULL,
+	0xd5d238a4abe98068ULL, 0x72a4904598d6d880ULL,
+	0x85a36366eb71f041ULL, 0x47a6da2b7f864750ULL,
+	0xa70c3c40a64e6c51ULL, 0x999090b65f67d924ULL,
+	0xd0cf4b50cfe20765ULL, 0xfff4b4e3f741cf6dULL,
+	0x82818f1281ed449fULL, 0xbff8f10e7a8921a4ULL,
+	0xa321f2d7226895c7ULL, 0xaff72d52192b6a0dULL,
+	0xcbea6f8ceb02bb39ULL, 0x9bf4f8a69f764490ULL,
+	0xfee50b7025c36a08ULL, 0x02f236d04753d5b4ULL,
+	0x9f4f2726179a2245ULL, 0x01d762422c946590ULL,
+	0xc722f0ef9d80aad6ULL, 0x424d3ad2b7b97ef5ULL,
+	0xf8ebad2b84e0d58bULL, 0xd2e0898765a7deb2ULL,
+	0x9b934c3b330c8577ULL, 0x63cc55f49f88eb2fULL,
+	0xc2781f49ffcfa6d5ULL, 0x3cbf6b71c76b25fbULL,
+	0xf316271c7fc3908aULL, 0x8bef464e3945ef7aULL,
+	0x97edd871cfda3a56ULL, 0x97758bf0e3cbb5acULL,
+	0xbde94e8e43d0c8ecULL, 0x3d52eeed1cbea317ULL,
+	0xed63a231d4c4fb27ULL, 0x4ca7aaa863ee4bddULL,
+	0x945e455f24fb1cf8ULL, 0x8fe8caa93e74ef6aULL,
+	0xb975d6b6ee39e436ULL, 0xb3e2fd538e122b44ULL,
+	0xe7d34c64a9c85d44ULL, 0x60dbbca87196b616ULL,
+	0x90e40fbeea1d3a4aULL, 0xbc8955e946fe31cdULL,
+	0xb51d13aea4a488ddULL, 0x6babab6398bdbe41ULL,
+	0xe264589a4dcdab14ULL, 0xc696963c7eed2dd1ULL,
+	0x8d7eb76070a08aecULL, 0xfc1e1de5cf543ca2ULL,
+	0xb0de65388cc8ada8ULL, 0x3b25a55f43294bcbULL,
+	0xdd15fe86affad912ULL, 0x49ef0eb713f39ebeULL,
+	0x8a2dbf142dfcc7abULL, 0x6e3569326c784337ULL,
+	0xacb92ed9397bf996ULL, 0x49c2c37f07965404ULL,
+	0xd7e77a8f87daf7fbULL, 0xdc33745ec97be906ULL,
+	0x86f0ac99b4e8dafdULL, 0x69a028bb3ded71a3ULL,
+	0xa8acd7c0222311bcULL, 0xc40832ea0d68ce0cULL,
+	0xd2d80db02aabd62bULL, 0xf50a3fa490c30190ULL,
+	0x83c7088e1aab65dbULL, 0x792667c6da79e0faULL,
+	0xa4b8cab1a1563f52ULL, 0x577001b891185938ULL,
+	0xcde6fd5e09abcf26ULL, 0xed4c0226b55e6f86ULL,
+	0x80b05e5ac60b6178ULL, 0x544f8158315b05b4ULL,
+	0xa0dc75f1778e39d6ULL, 0x696361ae3db1c721ULL,
+	0xc913936dd571c84cULL, 0x03bc3a19cd1e38e9ULL,
+	0xfb5878494ace3a5fULL, 0x04ab48a04065c723ULL,
+	0x9d174b2dcec0e47bULL, 0x62eb0d64283f9c76ULL,
+	0xc45d1df942711d9aULL, 0x3ba5d0bd324f8394ULL,
+	0xf5746577930d6500ULL, 0xca8f44ec7ee36479ULL,
+	0x9968bf6abbe85f20ULL, 0x7e998b13cf4e1ecbULL,
+	0xbfc2ef456ae276e8ULL, 0x9e3fedd8c321a67eULL,
+	0xefb3ab16c59b14a2ULL, 0xc5cfe94ef3ea101eULL,
+	0x95d04aee3b80ece5ULL, 0xbba1f1d158724a12ULL,
+	0xbb445da9ca61281fULL, 0x2a8a6e45ae8edc97ULL,
+	0xea1575143cf97226ULL, 0xf52d09d71a3293bdULL,
+	0x924d692ca61be758ULL, 0x593c2626705f9c56ULL,
+	0xb6e0c377cfa2e12eULL, 0x6f8b2fb00c77836cULL,
+	0xe498f455c38b997aULL, 0x0b6dfb9c0f956447ULL,
+	0x8edf98b59a373fecULL, 0x4724bd4189bd5eacULL,
+	0xb2977ee300c50fe7ULL, 0x58edec91ec2cb657ULL,
+	0xdf3d5e9bc0f653e1ULL, 0x2f2967b66737e3edULL,
+	0x8b865b215899f46cULL, 0xbd79e0d20082ee74ULL,
+	0xae67f1e9aec07187ULL, 0xecd8590680a3aa11ULL,
+	0xda01ee641a708de9ULL, 0xe80e6f4820cc9495ULL,
+	0x884134fe908658b2ULL, 0x3109058d147fdcddULL,
+	0xaa51823e34a7eedeULL, 0xbd4b46f0599fd415ULL,
+	0xd4e5e2cdc1d1ea96ULL, 0x6c9e18ac7007c91aULL,
+	0x850fadc09923329eULL, 0x03e2cf6bc604ddb0ULL,
+	0xa6539930bf6bff45ULL, 0x84db8346b786151cULL,
+	0xcfe87f7cef46ff16ULL, 0xe612641865679a63ULL,
+	0x81f14fae158c5f6eULL, 0x4fcb7e8f3f60c07eULL,
+	0xa26da3999aef7749ULL, 0xe3be5e330f38f09dULL,
+	0xcb090c8001ab551cULL, 0x5cadf5bfd3072cc5ULL,
+	0xfdcb4fa002162a63ULL, 0x73d9732fc7c8f7f6ULL,
+	0x9e9f11c4014dda7eULL, 0x2867e7fddcdd9afaULL,
+	0xc646d63501a1511dULL, 0xb281e1fd541501b8ULL,
+	0xf7d88bc24209a565ULL, 0x1f225a7ca91a4226ULL,
+	0x9ae757596946075fULL, 0x3375788de9b06958ULL,
+	0xc1a12d2fc3978937ULL, 0x0052d6b1641c83aeULL,
+	0xf209787bb47d6b84ULL, 0xc0678c5dbd23a49aULL,
+	0x9745eb4d50ce6332ULL, 0xf840b7ba963646e0ULL,
+	0xbd176620a501fbffULL, 0xb650e5a93bc3d898ULL,
+	0xec5d3fa8ce427affULL, 0xa3e51f138ab4cebeULL,
+	0x93ba47c980e98cdfULL, 0xc66f336c36b10137ULL,
+	0xb8a8d9bbe123f017ULL, 0xb80b0047445d4184ULL,
+	0xe6d3102ad96cec1dULL, 0xa60dc059157491e5ULL,
+	0x9043ea1ac7e41392ULL, 0x87c89837ad68db2fULL,
+	0xb454e4a179dd1877ULL, 0x29babe4598c311fbULL,
+	0xe16a1dc9d8545e94ULL, 0xf4296dd6fef3d67aULL,
+	0x8ce2529e2734bb1dULL, 0x1899e4a65f58660cULL,
+	0xb01ae745b101e9e4ULL, 0x5ec05dcff72e7f8fULL,
+	0xdc21a1171d42645dULL, 0x76707543f4fa1f73ULL,
+	0x899504ae72497ebaULL, 0x6a06494a791c53a8ULL,
+	0xabfa45da0edbde69ULL, 0x0487db9d17636892ULL,
+	0xd6f8d7509292d603ULL, 0x45a9d2845d3c42b6ULL,
+	0x865b86925b9bc5c2ULL, 0x0b8a2392ba45a9b2ULL,
+	0xa7f26836f282b732ULL, 0x8e6cac7768d7141eULL,
+	0xd1ef0244af2364ffULL, 0x3207d795430cd926ULL,
+	0x8335616aed761f1fULL, 0x7f44e6bd49e807b8ULL,
+	0xa402b9c5a8d3a6e7ULL, 0x5f16206c9c6209a6ULL,
+	0xcd036837130890a1ULL, 0x36dba887c37a8c0fULL,
+	0x802221226be55a64ULL, 0xc2494954da2c9789ULL,
+	0xa02aa96b06deb0fdULL, 0xf2db9baa10b7bd6cULL,
+	0xc83553c5c8965d3dULL, 0x6f92829494e5acc7ULL,
+	0xfa42a8b73abbf48cULL, 0xcb772339ba1f17f9ULL,
+	0x9c69a97284b578d7ULL, 0xff2a760414536efbULL,
+	0xc38413cf25e2d70dULL, 0xfef5138519684abaULL,
+	0xf46518c2ef5b8cd1ULL, 0x7eb258665fc25d69ULL,
+	0x98bf2f79d5993802ULL, 0xef2f773ffbd97a61ULL,
+	0xbeeefb584aff8603ULL, 0xaafb550ffacfd8faULL,
+	0xeeaaba2e5dbf6784ULL, 0x95ba2a53f983cf38ULL,
+	0x952ab45cfa97a0b2ULL, 0xdd945a747bf26183ULL,
+	0xba756174393d88dfULL, 0x94f971119aeef9e4ULL,
+	0xe912b9d1478ceb17ULL, 0x7a37cd5601aab85dULL,
+	0x91abb422ccb812eeULL, 0xac62e055c10ab33aULL,
+	0xb616a12b7fe617aaULL, 0x577b986b314d6009ULL,
+	0xe39c49765fdf9d94ULL, 0xed5a7e85fda0b80bULL,
+	0x8e41ade9fbebc27dULL, 0x14588f13be847307ULL,
+	0xb1d219647ae6b31cULL, 0x596eb2d8ae258fc8ULL,
+	0xde469fbd99a05fe3ULL, 0x6fca5f8ed9aef3bbULL,
+	0x8aec23d680043beeULL, 0x25de7bb9480d5854ULL,
+	0xada72ccc20054ae9ULL, 0xaf561aa79a10ae6aULL,
+	0xd910f7ff28069da4ULL, 0x1b2ba1518094da04ULL,
+	0x87aa9aff79042286ULL, 0x90fb44d2f05d0842ULL,
+	0xa99541bf57452b28ULL, 0x353a1607ac744a53ULL,
+	0xd3fa922f2d1675f2ULL, 0x42889b8997915ce8ULL,
+	0x847c9b5d7c2e09b7ULL, 0x69956135febada11ULL,
+	0xa59bc234db398c25ULL, 0x43fab9837e699095ULL,
+	0xcf02b2c21207ef2eULL, 0x94f967e45e03f4bbULL,
+	0x8161afb94b44f57dULL, 0x1d1be0eebac278f5ULL,
+	0xa1ba1ba79e1632dcULL, 0x6462d92a69731732ULL,
+	0xca28a291859bbf93ULL, 0x7d7b8f7503cfdcfeULL,
+	0xfcb2cb35e702af78ULL, 0x5cda735244c3d43eULL,
+	0x9defbf01b061adabULL, 0x3a0888136afa64a7ULL,
+	0xc56baec21c7a1916ULL, 0x088aaa1845b8fdd0ULL,
+	0xf6c69a72a3989f5bULL, 0x8aad549e57273d45ULL,
+	0x9a3c2087a63f6399ULL, 0x36ac54e2f678864bULL,
+	0xc0cb28a98fcf3c7fULL, 0x84576a1bb416a7ddULL,
+	0xf0fdf2d3f3c30b9fULL, 0x656d44a2a11c51d5ULL,
+	0x969eb7c47859e743ULL, 0x9f644ae5a4b1b325ULL,
+	0xbc4665b596706114ULL, 0x873d5d9f0dde1feeULL,
+	0xeb57ff22fc0c7959ULL, 0xa90cb506d155a7eaULL,
+	0x9316ff75dd87cbd8ULL, 0x09a7f12442d588f2ULL,
+	0xb7dcbf5354e9beceULL, 0x0c11ed6d538aeb2fULL,
+	0xe5d3ef282a242e81ULL, 0x8f1668c8a86da5faULL,
+	0x8fa475791a569d10ULL, 0xf96e017d694487bcULL,
+	0xb38d92d760ec4455ULL, 0x37c981dcc395a9acULL,
+	0xe070f78d3927556aULL, 0x85bbe253f47b1417ULL,
+	0x8c469ab843b89562ULL, 0x93956d7478ccec8eULL,
+	0xaf58416654a6babbULL, 0x387ac8d1970027b2ULL,
+	0xdb2e51bfe9d0696aULL, 0x06997b05fcc0319eULL,
+	0x88fcf317f22241e2ULL, 0x441fece3bdf81f03ULL,
+	0xab3c2fddeeaad25aULL, 0xd527e81cad7626c3ULL,
+	0xd60b3bd56a5586f1ULL, 0x8a71e223d8d3b074ULL,
+	0x85c7056562757456ULL, 0xf6872d5667844e49ULL,
+	0xa738c6bebb12d16cULL, 0xb428f8ac016561dbULL,
+	0xd106f86e69d785c7ULL, 0xe13336d701beba52ULL,
+	0x82a45b450226b39cULL, 0xecc0024661173473ULL,
+	0xa34d721642b06084ULL, 0x27f002d7f95d0190ULL,
+	0xcc20ce9bd35c78a5ULL, 0x31ec038df7b441f4ULL,
+	0xff290242c83396ceULL, 0x7e67047175a15271ULL,
+	0x9f79a169bd203e41ULL, 0x0f0062c6e984d386ULL,
+	0xc75809c42c684dd1ULL, 0x52c07b78a3e60868ULL,
+	0xf92e0c3537826145ULL, 0xa7709a56ccdf8a82ULL,
+	0x9bbcc7a142b17ccbULL, 0x88a66076400bb691ULL,
+	0xc2abf989935ddbfeULL, 0x6acff893d00ea435ULL,
+	0xf356f7ebf83552feULL, 0x0583f6b8c4124d43ULL,
+	0x98165af37b2153deULL, 0xc3727a337a8b704aULL,
+	0xbe1bf1b059e9a8d6ULL, 0x744f18c0592e4c5cULL,
+	0xeda2ee1c7064130cULL, 0x1162def06f79df73ULL,
+	0x9485d4d1c63e8be7ULL, 0x8addcb5645ac2ba8ULL,
+	0xb9a74a0637ce2ee1ULL, 0x6d953e2bd7173692ULL,
+	0xe8111c87c5c1ba99ULL, 0xc8fa8db6ccdd0437ULL,
+	0x910ab1d4db9914a0ULL, 0x1d9c9892400a22a2ULL,
+	0xb54d5e4a127f59c8ULL, 0x2503beb6d00cab4bULL,
+	0xe2a0b5dc971f303aULL, 0x2e44ae64840fd61dULL,
+	0x8da471a9de737e24ULL, 0x5ceaecfed289e5d2ULL,
+	0xb10d8e1456105dadULL, 0x7425a83e872c5f47ULL,
+	0xdd50f1996b947518ULL, 0xd12f124e28f77719ULL,
+	0x8a5296ffe33cc92fULL, 0x82bd6b70d99aaa6fULL,
+	0xace73cbfdc0bfb7bULL, 0x636cc64d1001550bULL,
+	0xd8210befd30efa5aULL, 0x3c47f7e05401aa4eULL,
+	0x8714a775e3e95c78ULL, 0x65acfaec34810a71ULL,
+	0xa8d9d1535ce3b396ULL, 0x7f1839a741a14d0dULL,
+	0xd31045a8341ca07cULL, 0x1ede48111209a050ULL,
+	0x83ea2b892091e44dULL, 0x934aed0aab460432ULL,
+	0xa4e4b66b68b65d60ULL, 0xf81da84d5617853fULL,
+	0xce1de40642e3f4b9ULL, 0x36251260ab9d668eULL,
+	0x80d2ae83e9ce78f3ULL, 0xc1d72b7c6b426019ULL,
+	0xa1075a24e4421730ULL, 0xb24cf65b8612f81fULL,
+	0xc94930ae1d529cfcULL, 0xdee033f26797b627ULL,
+	0xfb9b7cd9a4a7443cULL, 0x169840ef017da3b1ULL,
+	0x9d412e0806e88aa5ULL, 0x8e1f289560ee864eULL,
+	0xc491798a08a2ad4eULL, 0xf1a6f2bab92a27e2ULL,
+	0xf5b5d7ec8acb58a2ULL, 0xae10af696774b1dbULL,
+	0x9991a6f3d6bf1765ULL, 0xacca6da1e0a8ef29ULL,
+	0xbff610b0cc6edd3fULL, 0x17fd090a58d32af3ULL,
+	0xeff394dcff8a948eULL, 0xddfc4b4cef07f5b0ULL,
+	0x95f83d0a1fb69cd9ULL, 0x4abdaf101564f98eULL,
+	0xbb764c4ca7a4440fULL, 0x9d6d1ad41abe37f1ULL,
+	0xea53df5fd18d5513ULL, 0x84c86189216dc5edULL,
+	0x92746b9be2f8552cULL, 0x32fd3cf5b4e49bb4ULL,
+	0xb7118682dbb66a77ULL, 0x3fbc8c33221dc2a1ULL,
+	0xe4d5e82392a40515ULL, 0x0fabaf3feaa5334aULL,
+	0x8f05b1163ba6832dULL, 0x29cb4d87f2a7400eULL,
+	0xb2c71d5bca9023f8ULL, 0x743e20e9ef511012ULL,
+	0xdf78e4b2bd342cf6ULL, 0x914da9246b255416ULL,
+	0x8bab8eefb6409c1aULL, 0x1ad089b6c2f7548eULL,
+	0xae9672aba3d0c320ULL, 0xa184ac2473b529b1ULL,
+	0xda3c0f568cc4f3e8ULL, 0xc9e5d72d90a2741eULL,
+	0x8865899617fb1871ULL, 0x7e2fa67c7a658892ULL,
+	0xaa7eebfb9df9de8dULL, 0xddbb901b98feeab7ULL,
+	0xd51ea6fa85785631ULL, 0x552a74227f3ea565ULL,
+	0x8533285c936b35deULL, 0xd53a88958f87275fULL,
+	0xa67ff273b8460356ULL, 0x8a892abaf368f137ULL,
+	0xd01fef10a657842cULL, 0x2d2b7569b0432d85ULL,
+	0x8213f56a67f6b29bULL, 0x9c3b29620e29fc73ULL,
+	0xa298f2c501f45f42ULL, 0x8349f3ba91b47b8fULL,
+	0xcb3f2f7642717713ULL, 0x241c70a936219a73ULL,
+	0xfe0efb53d30dd4d7ULL, 0xed238cd383aa0110ULL,
+	0x9ec95d1463e8a506ULL, 0xf4363804324a40aaULL,
+	0xc67bb4597ce2ce48ULL, 0xb143c6053edcd0d5ULL,
+	0xf81aa16fdc1b81daULL, 0xdd94b7868e94050aULL,
+	0x9b10a4e5e9913128ULL, 0xca7cf2b4191c8326ULL,
+	0xc1d4ce1f63f57d72ULL, 0xfd1c2f611f63a3f0ULL,
+	0xf24a01a73cf2dccfULL, 0xbc633b39673c8cecULL,
+	0x976e41088617ca01ULL, 0xd5be0503e085d813ULL,
+	0xbd49d14aa79dbc82ULL, 0x4b2d8644d8a74e18ULL,
+	0xec9c459d51852ba2ULL, 0xddf8e7d60ed1219eULL,
+	0x93e1ab8252f33b45ULL, 0xcabb90e5c942b503ULL,
+	0xb8da1662e7b00a17ULL, 0x3d6a751f3b936243ULL,
+	0xe7109bfba19c0c9dULL, 0x0cc512670a783ad4ULL,
+	0x906a617d450187e2ULL, 0x27fb2b80668b24c5ULL,
+	0xb484f9dc9641e9daULL, 0xb1f9f660802dedf6ULL,
+	0xe1a63853bbd26451ULL, 0x5e7873f8a0396973ULL,
+	0x8d07e33455637eb2ULL, 0xdb0b487b6423e1e8ULL,
+	0xb049dc016abc5e5fULL, 0x91ce1a9a3d2cda62ULL,
+	0xdc5c5301c56b75f7ULL, 0x7641a140cc7810fbULL,
+	0x89b9b3e11b6329baULL, 0xa9e904c87fcb0a9dULL,
+	0xac2820d9623bf429ULL, 0x546345fa9fbdcd44ULL,
+	0xd732290fbacaf133ULL, 0xa97c177947ad4095ULL,
+	0x867f59a9d4bed6c0ULL, 0x49ed8eabcccc485dULL,
+	0xa81f301449ee8c70ULL, 0x5c68f256bfff5a74ULL,
+	0xd226fc195c6a2f8cULL, 0x73832eec6fff3111ULL,
+	0x83585d8fd9c25db7ULL, 0xc831fd53c5ff7eabULL,
+	0xa42e74f3d032f525ULL, 0xba3e7ca8b77f5e55ULL,
+	0xcd3a1230c43fb26fULL, 0x28ce1bd2e55f35ebULL,
+	0x80444b5e7aa7cf85ULL, 0x7980d163cf5b81b3ULL,
+	0xa0555e361951c366ULL, 0xd7e105bcc332621fULL,
+	0xc86ab5c39fa63440ULL, 0x8dd9472bf3fefaa7ULL,
+	0xfa856334878fc150ULL, 0xb14f98f6f0feb951ULL,
+	0x9c935e00d4b9d8d2ULL, 0x6ed1bf9a569f33d3ULL,
+	0xc3b8358109e84f07ULL, 0x0a862f80ec4700c8ULL,
+	0xf4a642e14c6262c8ULL, 0xcd27bb612758c0faULL,
+	0x98e7e9cccfbd7dbdULL, 0x8038d51cb897789cULL,
+	0xbf21e44003acdd2cULL, 0xe0470a63e6bd56c3ULL,
+	0xeeea5d5004981478ULL, 0x1858ccfce06cac74ULL,
+	0x95527a5202df0ccbULL, 0x0f37801e0c43ebc8ULL,
+	0xbaa718e68396cffdULL, 0xd30560258f54e6baULL,
+	0xe950df20247c83fdULL, 0x47c6b82ef32a2069ULL,
+	0x91d28b7416cdd27eULL, 0x4cdc331d57fa5441ULL,
+	0xb6472e511c81471dULL, 0xe0133fe4adf8e952ULL,
+	0xe3d8f9e563a198e5ULL, 0x58180fddd97723a6ULL,
+	0x8e679c2f5e44ff8fULL, 0x570f09eaa7ea7648ULL,
+};
+
+// Returns the 128 bit product of `a` and `b`.
+inline
+void FullMultiplication(uint64_t a, uint64_t b, uint64_t *high, uint64_t *low)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+	*high = static_cast<uint64_t>(r >> 64);
+	*low = static_cast<uint64_t>(r);
+#else
+	uint64_t aLo = a & 0xFFFFFFFF, aHi = a >> 32;
+	uint64_t bLo = b & 0xFFFFFFFF, bHi = b >> 32;
+	uint64_t loLo = aLo * bLo;
+	uint64_t hiLo = aHi * bLo;
+	uint64_t loHi = aLo * bHi;
+	uint64_t hiHi = aHi * bHi;
+	uint64_t cross = (loLo >> 32) + (hiLo & 0xFFFFFFFF) + loHi;
+	*high = hiHi + (hiLo >> 32) + (cross >> 32);
+	*low = (cross << 32) | (loLo & 0xFFFFFFFF);
+#endif
+}
+
+inline
+int CountLeadingZeros(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_clzll(x);
+#else
+	int cnt = 0;
+	while ((x & (uint64_t(1) << 63)) == 0)
+	{
+		x <<= 1;
+		++cnt;
+	}
+	return cnt;
+#endif
+}
+
+// Converts `w * 10^q` to the nearest double. Small values that are exactly
+// representable are computed with a single floating point operation, others
+// with the algorithm from Daniel Lemire, "Number Parsing at a Gigabyte per
+// Second" using the 128 bit powers of five above.
+//
+// Returns false in the rare cases when the result can not be decided this
+// way, then a slower conversion should be used.
+inline
+bool DecimalToDouble(uint64_t w, int64_t q, bool negative, double *out)
+{
+	static const double exactPowersOfTen[] = {
+		1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+	};
+
+	if (w <= (uint64_t(1) << 53) && q >= -22 && q <= 22)
+	{
+		// Both w and 10^q are exact, so is the correctly rounded result of
+		// one operation
+		double d = static_cast<double>(w);
+		d = q < 0 ? d / exactPowersOfTen[-q] : d * exactPowersOfTen[q];
+		*out = negative ? -d : d;
+		return true;
+	}
+
+	const int mantissaBits = 52;
+	uint64_t mantissa = 0;
+	int64_t power2 = 0;
+
+	if (w == 0 || q < -342)
+	{
+		// Rounds to zero
+	}
+	else if (q > 308)
+	{
+		power2 = 0x7FF;
+	}
+	else
+	{
+		int lz = CountLeadingZeros(w);
+		w <<= lz;
+
+		// Only the top bits of the product are needed, the lower 64 bits of
+		// 5^q are used when the result is close to a rounding boundary
+		const uint64_t *pow5 = &PowersOfFive128[2 * (q + 342)];
+		const uint64_t precisionMask = ~uint64_t(0) >> (mantissaBits + 3);
+		uint64_t high, low;
+		FullMultiplication(w, pow5[0], &high, &low);
+		if ((high & precisionMask) == precisionMask)
+		{
+			uint64_t secondHigh, secondLow;
+			FullMultiplication(w, pow5[1], &secondHigh, &secondLow);
+			low += secondHigh;
+			if (secondHigh > low)
+			{
+				++high;
+			}
+		}
+		// 5^q is truncated, so the product might still be off unless it is
+		// exact for this q
+		if (QUANTUMJSON_UNLIKELY(low == ~uint64_t(0)) && (q < -27 || q > 55))
+		{
+			return false;
+		}
+
+		int upperBit = static_cast<int>(high >> 63);
+		int shift = upperBit + 64 - mantissaBits - 3;
+		mantissa = high >> shift;
+		// floor(log2(10^q)) + 63, plus the exponent bias of 1023
+		power2 = (((152170 + 65536) * q) >> 16) + 63 + upperBit - lz + 1023;
+
+		if (power2 <= 0)
+		{
+			// Subnormal
+			if (-power2 + 1 >= 64)
+			{
+				mantissa = 0;
+				power2 = 0;
+			}
+			else
+			{
+				mantissa >>= -power2 + 1;
+				mantissa += (mantissa & 1);
+				mantissa >>= 1;
+				power2 = mantissa < (uint64_t(1) << mantissaBits) ? 0 : 1;
+			}
+		}
+		else
+		{
+			// Exactly halfway between two doubles, round to even. This is
+			// only possible for small q.
+			if (low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1
+			    && (mantissa << shift) == high)
+			{
+				mantissa &= ~uint64_t(1);
+			}
+
+			mantissa += (mantissa & 1);
+			mantissa >>= 1;
+			if (mantissa >= (uint64_t(2) << mantissaBits))
+			{
+				mantissa = uint64_t(1) << mantissaBits;
+				++power2;
+			}
+			mantissa &= ~(uint64_t(1) << mantissaBits);
+
+			if (power2 >= 0x7FF)
+			{
+				power2 = 0x7FF;
+				mantissa = 0;
+			}
+		}
+	}
+
+	uint64_t bits = mantissa | (static_cast<uint64_t>(power2) << mantissaBits)
+	              | (static_cast<uint64_t>(negative) << 63);
+	memcpy(out, &bits, sizeof(bits));
+	return true;
+}
+
+// Holds the strings `std::string_view` fields refer to when they can't point
+// into the input, i.e. when the json string has escapes or the input is not
+// contiguous. Parsed views are valid as long as both the input and this
+// storage are alive and unmodified.
+struct StringStorage
+{
+	// Returns an empty string whose address stays stable until `Clear`
+	std::string& NewString()
+	{
+		strings.emplace_back();
+		return strings.back();
+	}
+
+	void Clear()
+	{
+		strings.clear();
+	}
+
+	std::deque<std::string> strings;
+};
+
+// Kinds of the open containers while skipping nested values, a bit per
+// level that is set for objects. Levels up to 1024 are kept inline, deeper
+// ones are only reached with a larger `QUANTUMJSON_MAX_DEPTH`. The current
+// depth is tracked by the caller.
+class BracketStack
+{
+public:
+	void Set(int level, bool isObject)
+	{
+		uint64_t &word = Word(level / 64);
+		uint64_t bit = uint64_t(1) << (level % 64);
+		word = isObject ? (word | bit) : (word & ~bit);
+	}
+
+	bool IsObject(int level)
+	{
+		return (Word(level / 64) >> (level % 64)) & 1;
+	}
+
+private:
+	static constexpr int InlineWords = 16;
+
+	uint64_t& Word(int idx)
+	{
+		if (QUANTUMJSON_LIKELY(idx < InlineWords))
+		{
+			return inlineWords[idx];
+		}
+		return SpillWord(idx - InlineWords);
+	}
+
+	QUANTUMJSON_NOINLINE
+	uint64_t& SpillWord(int idx)
+	{
+		if (idx >= static_cast<int>(spill.size()))
+		{
+			spill.resize(idx + 1);
+		}
+		return spill[idx];
+	}
+
+	uint64_t inlineWords[InlineWords];
+	std::vector<uint64_t> spill;
+};
+
+// Calls `visit(offset)` in order with the offsets of the structural
+// characters in [begin, end): brackets, colons and commas outside strings,
+// and the opening quotes of strings. Stops early when `visit` returns false.
+// Returns false if the input ends in a string.
+template <typename Visitor>
+bool VisitStructurals(const char *begin, const char *end, Visitor &&visit)
+{
+	uint64_t nextIsEscaped = 0;
+	uint64_t prevInString = 0;
+	void (*classifyBlock)(const char *block, BlockMasks *out) = ActiveKernels().classifyBlock;
+
+	for (const char *block = begin; block < end; block += 64)
+	{
+		BlockMasks masks;
+		if (QUANTUMJSON_LIKELY(end - block >= 64))
+		{
+			classifyBlock(block, &masks);
+		}
+		else
+		{
+			// Pad the last block with whitespace
+			char padded[64];
+			memset(padded, ' ', sizeof(padded));
+			memcpy(padded, block, end - block);
+			classifyBlock(padded, &masks);
+		}
+
+		uint64_t escaped = FindEscapedChars(masks.backslash, &nextIsEscaped);
+		uint64_t quote = masks.quote & ~escaped;
+		// Includes opening quotes, excludes closing ones
+		uint64_t inString = PrefixXor(quote) ^ prevInString;
+		prevInString = uint64_t(int64_t(inString) >> 63);
+
+		uint64_t structural = (masks.op & ~inString) | (quote & inString);
+		const uint32_t blockOffset = static_cast<uint32_t>(block - begin);
+
+		while (structural != 0)
+		{
+			const uint32_t offset = blockOffset + CountTrailingZeros(structural);
+			structural &= structural - 1;
+
+			if (!visit(offset))
+			{
+				return true;
+			}
+		}
+	}
+	return prevInString == 0;
+}
+
+// Finds where the elements of the list at `begin` start, skipping the
+// whitespace before them, and the size of the list, so the elements can be
+// parsed separately. Only the nesting of brackets is followed, elements and
+// separators are left to be checked by their parsers. Returns false if the
+// list does not end.
+inline
+bool FindListElements(const char *begin, const char *end,
+                      std::vector<uint32_t> *elements, size_t *listSize)
+{
+	if (static_cast<uint64_t>(end - begin) >= std::numeric_limits<uint32_t>::max())
+	{
+		return false;
+	}
+
+	auto valueAfter = [&](uint32_t offset)
+	{
+		const char *p = begin + offset + 1;
+		return static_cast<uint32_t>(p + WhitespaceRunLength(p, end) - begin);
+	};
+
+	int depth = 0;
+	bool closed = false;
+	VisitStructurals(begin, end, [&](uint32_t offset) -> bool
+	{
+		switch (begin[offset])
+		{
+		case '{':
+		case '[':
+			if (++depth == 1)
+			{
+				elements->push_back(valueAfter(offset));
+			}
+			break;
+		case '}':
+		case ']':
+			if (--depth == 0)
+			{
+				*listSize = offset + 1;
+				closed = true;
+				return false;
+			}
+			break;
+		case ',':
+			if (depth == 1)
+			{
+				elements->push_back(valueAfter(offset));
+			}
+			break;
+		}
+		return true;
+	});
+	return closed;
+}
+
+// Stage one of on-demand parsing, positions of the structural characters
+// of a json document: brackets, colons and commas outside strings, and the
+// opening quotes of strings. Brackets also point at their matching bracket,
+// so values can be stepped over without reading them. Scalars are not
+// indexed, they are found after the preceding colon or comma.
+//
+// Views into the document refer to the index, which is kept between parses
+// to reuse its memory.
+struct StructuralIndex
+{
+	struct Entry
+	{
+		uint32_t offset;
+		// Entry of the matching bracket, unused for others
+		uint32_t match;
+	};
+
+	// Indexes the json value at `begin`, up to the end of its outermost
+	// container. The input must stay alive and unmodified while it is
+	// viewed. Only strings and brackets are checked here, values are
+	// validated as they are read.
+	ErrorCode Build(const char *begin, const char *end)
+	{
+		input = begin;
+		inputEnd = end;
+		entryCount = 0;
+		openBrackets.clear();
+		unescapedStrings.clear();
+		strings.Clear();
+
+		if (static_cast<uint64_t>(end - begin) >= std::numeric_limits<uint32_t>::max())
+		{
+			return ErrorCode::InputTooLarge;
+		}
+
+		// Typical json has a structural character every 8 to 16 bytes
+		const size_t expectedCount = static_cast<size_t>(end - begin) / 8 + 64;
+		if (capacity < expectedCount)
+		{
+			Reallocate(expectedCount);
+		}
+
+		ErrorCode result = ErrorCode::NoError;
+		bool done = false;
+		const bool stringsClosed = VisitStructurals(begin, end, [&](uint32_t offset) -> bool
+		{
+			if (QUANTUMJSON_UNLIKELY(entryCount == capacity))
+			{
+				Reallocate(capacity * 2);
+			}
+			const uint32_t idx = static_cast<uint32_t>(entryCount++);
+			entries[idx] = Entry{offset, 0};
+
+			const char c = begin[offset];
+			if (c == '{' || c == '[')
+			{
+				if (QUANTUMJSON_UNLIKELY(static_cast<int>(openBrackets.size()) >= maxDepth))
+				{
+					result = ErrorCode::DepthLimitExceeded;
+					done = true;
+					return false;
+				}
+				openBrackets.push_back(idx);
+			}
+			else if (c == '}' || c == ']')
+			{
+				if (QUANTUMJSON_UNLIKELY(openBrackets.empty()
+				    || begin[entries[openBrackets.back()].offset] != (c == '}' ? '{' : '[')))
+				{
+					result = ErrorCode::UnexpectedChar;
+					done = true;
+					return false;
+				}
+				entries[openBrackets.back()].match = idx;
+				entries[idx].match = openBrackets.back();
+				openBrackets.pop_back();
+
+				// Only the first value is indexed
+				done = openBrackets.empty();
+				return !done;
+			}
+			return true;
+		});
+
+		if (!done && (!stringsClosed || !openBrackets.empty()))
+		{
+			return ErrorCode::UnexpectedEOF;
+		}
+		return result;
+	}
+
+	char CharAt(uint32_t entry) const
+	{
+		return input[entries[entry].offset];
+	}
+
+	// Offset of the value after the colon, comma or open bracket at `entry`.
+	// Every such entry is in a container, so the value is followed at least
+	// by its closing bracket.
+	uint32_t ValueOffsetAfter(uint32_t entry) const
+	{
+		const char *p = input + entries[entry].offset + 1;
+		p += WhitespaceRunLength(p, inputEnd);
+		return static_cast<uint32_t>(p - input);
+	}
+
+	// Returns the first entry after the value at `offset`, `entry` being the
+	// first entry at or after the value.
+	uint32_t SkipValue(uint32_t entry, uint32_t offset) const
+	{
+		const char c = input[offset];
+		if (c == '{' || c == '[')
+		{
+			return entries[entry].match + 1;
+		}
+		if (c == '"')
+		{
+			return entry + 1;
+		}
+		return entry;
+	}
+
+	struct Element
+	{
+		// First entry at or after the element
+		uint32_t entry;
+		uint32_t offset;
+	};
+
+	// Appends the elements of the list at `entry` to `elements`. Returns
+	// false if they are not separated by commas, the elements themselves
+	// are not checked.
+	bool ListElements(uint32_t entry, std::vector<Element> *elements) const
+	{
+		if (input[ValueOffsetAfter(entry)] == ']')
+		{
+			return true;
+		}
+
+		uint32_t e = entry;
+		while (true)
+		{
+			const uint32_t offset = ValueOffsetAfter(e);
+			if (input[offset] == ',' || input[offset] == ']')
+			{
+				return false;
+			}
+			elements->push_back(Element{e + 1, offset});
+
+			e = SkipValue(e + 1, offset);
+			if (CharAt(e) == ']')
+			{
+				return true;
+			}
+			if (CharAt(e) != ',')
+			{
+				return false;
+			}
+		}
+	}
+
+	const char *input = nullptr;
+	const char *inputEnd = nullptr;
+
+	// Left uninitialized past `entryCount`, so a new index does not write
+	// its whole capacity before use
+	std::unique_ptr<Entry[]> entries;
+	size_t entryCount = 0;
+
+	// Unescaped `std::string_view` values read from the views, by offset.
+	// Each is decoded on its first read, so reading a field repeatedly
+	// doesn't grow the index.
+	mutable std::unordered_map<uint32_t, std::string> unescapedStrings;
+	// Holds escaped `std::string_view`s within other decoded values, e.g.
+	// maps, which are unescaped again on each read
+	mutable StringStorage strings;
+	// Guards both, so views of the index can be read from several threads
+	mutable std::mutex stringsMutex;
+
+	int maxDepth = QUANTUMJSON_MAX_DEPTH;
+
+private:
+	QUANTUMJSON_NOINLINE
+	void Reallocate(size_t newCapacity)
+	{
+		std::unique_ptr<Entry[]> newEntries(new Entry[newCapacity]);
+		std::copy(entries.get(), entries.get() + entryCount, newEntries.get());
+		entries = std::move(newEntries);
+		capacity = newCapacity;
+	}
+
+	size_t capacity = 0;
+
+	std::vector<uint32_t> openBrackets;
+};
+
+// Gives the input of a `ChunkIterator` one contiguous chunk at a time
+class ChunkSource
+{
+public:
+	// Returns the next chunk, which stays valid until the next call, or an
+	// empty one at the end of the input. May wait for input to arrive.
+	virtual std::string_view Next() = 0;
+
+protected:
+	~ChunkSource() = default;
+};
+
+// Chunks pushed by one thread and parsed by another, which waits for the
+// next chunk at the end of each
+class ChunkQueue final : public ChunkSource
+{
+public:
+	// Queues the chunk, waiting while `maxBuffered` or more bytes are
+	// queued. Returns false if the chunk is not needed, because parsing
+	// stopped.
+	bool Push(std::string &&chunk)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		changed.wait(lock, [&]() { return stopped || maxBuffered == 0 || bufferedBytes < maxBuffered; });
+		if (stopped)
+		{
+			return false;
+		}
+
+		if (!chunk.empty())
+		{
+			bufferedBytes += chunk.size();
+			pending.push_back(std::move(chunk));
+			changed.notify_all();
+		}
+		return true;
+	}
+
+	bool Push(const char *data, size_t size)
+	{
+		return Push(std::string(data, size));
+	}
+
+	// Marks the end of the input
+	void Close()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		closed = true;
+		changed.notify_all();
+	}
+
+	// Ends the input with an error, rethrown by `Next` after the queued
+	// chunks
+	void Fail(std::exception_ptr e)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		error = e;
+		closed = true;
+		changed.notify_all();
+	}
+
+	// Drops queued and later chunks, e.g. when parsing stopped early
+	void Stop()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopped = true;
+		pending.clear();
+		bufferedBytes = 0;
+		changed.notify_all();
+	}
+
+	// Returns the memory of a chunk already parsed, if any, so producers
+	// can reuse it for the next one
+	std::string TakeSpare()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		std::string buffer;
+		buffer.swap(spare);
+		return buffer;
+	}
+
+	std::string_view Next() override
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		if (spare.capacity() < current.capacity())
+		{
+			spare.swap(current);
+		}
+		current.clear();
+		changed.wait(lock, [&]() { return !pending.empty() || closed || stopped; });
+		if (pending.empty())
+		{
+			if (error && !stopped)
+			{
+				std::rethrow_exception(error);
+			}
+			return std::string_view();
+		}
+
+		current.swap(pending.front());
+		pending.pop_front();
+		bufferedBytes -= current.size();
+		changed.notify_all();
+		return current;
+	}
+
+	size_t maxBuffered = 0;
+
+private:
+	std::mutex mutex;
+	std::condition_variable changed;
+	std::deque<std::string> pending;
+	std::string current;
+	std::string spare;
+	size_t bufferedBytes = 0;
+	bool closed = false;
+	bool stopped = false;
+	std::exception_ptr error;
+};
+
+// Reads up to `size` bytes from `fd`, retrying when interrupted. Returns 0
+// at the end of the input, throws `std::system_error` on errors.
+inline
+size_t ReadSome(int fd, char *data, size_t size)
+{
+	while (1)
+	{
+		const ssize_t n = read(fd, data, size);
+		if (n >= 0)
+		{
+			return static_cast<size_t>(n);
+		}
+		if (errno != EINTR)
+		{
+			throw std::system_error(errno, std::generic_category(), "read");
+		}
+	}
+}
+
+// Reads from a file descriptor on a thread that another thread can stop,
+// waking it from waiting for input with a pipe. No reads are done once it
+// is stopped, so the thread can be joined without further input arriving.
+class StoppableFdReader
+{
+public:
+	explicit StoppableFdReader(int fd)
+	  : fd(fd)
+	{
+		if (pipe(wakeFds) != 0)
+		{
+			throw std::system_error(errno, std::generic_category(), "pipe");
+		}
+	}
+
+	StoppableFdReader(const StoppableFdReader&) = delete;
+	StoppableFdReader& operator=(const StoppableFdReader&) = delete;
+
+	~StoppableFdReader()
+	{
+		close(wakeFds[0]);
+		close(wakeFds[1]);
+	}
+
+	// Same as `ReadSome`, except it returns 0 once stopped
+	size_t Read(char *data, size_t size)
+	{
+		// Negative descriptors are ignored by poll, let read report them
+		if (fd < 0)
+		{
+			return ReadSome(fd, data, size);
+		}
+
+		pollfd fds[2] = {{wakeFds[0], POLLIN, 0}, {fd, POLLIN, 0}};
+		while (1)
+		{
+			if (poll(fds, 2, -1) < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				throw std::system_error(errno, std::generic_category(), "poll");
+			}
+
+			// The wake pipe is never drained, so it's seen by later reads too
+			if (fds[0].revents != 0)
+			{
+				return 0;
+			}
+			if (fds[1].revents != 0)
+			{
+				return ReadSome(fd, data, size);
+			}
+		}
+	}
+
+	// Wakes a waiting `Read`, may be called from any thread
+	void Stop()
+	{
+		const char c = 0;
+		while (write(wakeFds[1], &c, 1) < 0 && errno == EINTR)
+		{
+		}
+	}
+
+private:
+	int fd;
+	int wakeFds[2];
+};
+
+// Reads chunks from a file descriptor as they are needed, into a single
+// buffer
+class FdChunkSource final : public ChunkSource
+{
+public:
+	FdChunkSource(int fd, size_t chunkSize)
+	  : fd(fd), buffer(chunkSize)
+	{
+	}
+
+	std::string_view Next() override
+	{
+		return std::string_view(buffer.data(), ReadSome(fd, buffer.data(), buffer.size()));
+	}
+
+private:
+	int fd;
+	std::vector<char> buffer;
+};
+
+#ifdef QUANTUMJSON_WITH_ZLIB
+// Streaming gzip decompression, also accepting zlib streams. Members of
+// concatenated gzip files, as written by parallel compressors, are
+// decompressed one after the other.
+class GzipDecoder
+{
+public:
+	GzipDecoder()
+	{
+		memset(&stream, 0, sizeof(stream));
+		// Detects gzip or zlib headers
+		if (inflateInit2(&stream, 15 + 32) != Z_OK)
+		{
+			throw std::bad_alloc();
+		}
+	}
+
+	GzipDecoder(const GzipDecoder&) = delete;
+	GzipDecoder& operator=(const GzipDecoder&) = delete;
+
+	~GzipDecoder()
+	{
+		inflateEnd(&stream);
+	}
+
+	// Decompresses from `*in` into `*out`, advancing both as far as it can.
+	// Throws `std::runtime_error` for invalid data.
+	void Decode(const char **in, const char *inEnd, char **out, char *outEnd)
+	{
+		if (streamEnded && *in != inEnd)
+		{
+			inflateReset(&stream);
+			streamEnded = false;
+		}
+
+		stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(*in));
+		stream.avail_in = static_cast<uInt>(std::min<size_t>(inEnd - *in, std::numeric_limits<uInt>::max()));
+		stream.next_out = reinterpret_cast<Bytef*>(*out);
+		stream.avail_out = static_cast<uInt>(std::min<size_t>(outEnd - *out, std::numeric_limits<uInt>::max()));
+
+		const int result = streamEnded ? Z_STREAM_END : inflate(&stream, Z_NO_FLUSH);
+		if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR)
+		{
+			throw std::runtime_error(std::string("Invalid gzip data: ")
+			                         + (stream.msg != nullptr ? stream.msg : "unknown error"));
+		}
+
+		if (stream.next_in != reinterpret_cast<const Bytef*>(*in))
+		{
+			inStream = true;
+		}
+		if (result == Z_STREAM_END)
+		{
+			streamEnded = true;
+			inStream = false;
+		}
+		*in = reinterpret_cast<const char*>(stream.next_in);
+		*out = reinterpret_cast<char*>(stream.next_out);
+	}
+
+	// Whether the input decoded so far ends with a complete stream
+	bool AtStreamEnd() const
+	{
+		return !inStream;
+	}
+
+	static constexpr const char *name = "gzip";
+
+private:
+	z_stream stream;
+	bool inStream = false;
+	bool streamEnded = false;
+};
+#endif
+
+#ifdef QUANTUMJSON_WITH_ZSTD
+// Streaming zstd decompression, of one or more frames
+class ZstdDecoder
+{
+public:
+	ZstdDecoder()
+	  : stream(ZSTD_createDStream())
+	{
+		if (stream == nullptr || ZSTD_isError(ZSTD_initDStream(stream)))
+		{
+			ZSTD_freeDStream(stream);
+			throw std::bad_alloc();
+		}
+	}
+
+	ZstdDecoder(const ZstdDecoder&) = delete;
+	ZstdDecoder& operator=(const ZstdDecoder&) = delete;
+
+	~ZstdDecoder()
+	{
+		ZSTD_freeDStream(stream);
+	}
+
+	// Same as `GzipDecoder::Decode`
+	void Decode(const char **in, const char *inEnd, char **out, char *outEnd)
+	{
+		ZSTD_inBuffer input = {*in, static_cast<size_t>(inEnd - *in), 0};
+		ZSTD_outBuffer output = {*out, static_cast<size_t>(outEnd - *out), 0};
+
+		const size_t result = ZSTD_decompressStream(stream, &output, &input);
+		if (ZSTD_isError(result))
+		{
+			throw std::runtime_error(std::string("Invalid zstd data: ") + ZSTD_getErrorName(result));
+		}
+
+		// 0 when a frame is fully decoded and flushed
+		if (input.pos > 0 || output.pos > 0)
+		{
+			inFrame = result != 0;
+		}
+		*in += input.pos;
+		*out += output.pos;
+	}
+
+	bool AtStreamEnd() const
+	{
+		return !inFrame;
+	}
+
+	static constexpr const char *name = "zstd";
+
+private:
+	ZSTD_DStream *stream;
+	bool inFrame = false;
+};
+#endif
+
+// Decompresses blocks given by `read(const char **block)`, which returns
+// their size or 0 at the end of the input, pushing the output to `queue` in
+// chunks of up to `chunkSize`, cut short at the end of each block. Errors,
+// such as a truncated stream, end the queue with an exception.
+template <typename Decoder, typename ReadFunction>
+void DecompressInto(ChunkQueue &queue, ReadFunction read, size_t chunkSize)
+{
+	try
+	{
+		Decoder decoder;
+		const char *in = nullptr;
+		const char *inEnd = nullptr;
+		bool inputEnded = false;
+		bool decoderDone = false;
+
+		while (!decoderDone)
+		{
+			std::string chunk = queue.TakeSpare();
+			chunk.resize(chunkSize);
+			char *out = &chunk[0];
+			char *outEnd = out + chunkSize;
+
+			while (out < outEnd)
+			{
+				if (in == inEnd && !inputEnded)
+				{
+					// Hands over what's decompressed before waiting for more
+					// input, which may not arrive until it's parsed
+					if (out != &chunk[0])
+					{
+						break;
+					}
+					const size_t n = read(&in);
+					inEnd = in + n;
+					inputEnded = n == 0;
+				}
+
+				const char *inBefore = in;
+				char *outBefore = out;
+				decoder.Decode(&in, inEnd, &out, outEnd);
+
+				// Without progress, the decoder needs more input
+				if (in == inBefore && out == outBefore && inputEnded)
+				{
+					if (!decoder.AtStreamEnd())
+					{
+						throw std::runtime_error(std::string("Truncated ") + Decoder::name + " data");
+					}
+					decoderDone = true;
+					break;
+				}
+			}
+
+			chunk.resize(out - &chunk[0]);
+			if (!queue.Push(std::move(chunk)))
+			{
+				return;
+			}
+		}
+		queue.Close();
+	}
+	catch (...)
+	{
+		queue.Fail(std::current_exception());
+	}
+}
+
+// Input iterator over the chunks of a `ChunkSource`. Like
+// `std::istreambuf_iterator`, copies share the source and only one of them
+// can be advanced. A default constructed iterator is the end. At the end it
+// points to a '\0' rather than nowhere, and stays there when incremented,
+// so an end of input check missed by a parser reads a character that
+// doesn't match anything instead of crashing.
+//
+// Parsers scan each chunk in blocks where contiguous inputs would be
+// scanned as a whole, using `ChunkPtr`, `ChunkEndPtr` and `Advance`.
+class ChunkIterator
+{
+public:
+	using iterator_category = std::input_iterator_tag;
+	using value_type = char;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const char*;
+	using reference = const char&;
+
+	ChunkIterator() = default;
+
+	explicit ChunkIterator(ChunkSource *source)
+	  : source(source)
+	{
+		NextChunk();
+	}
+
+	const char& operator*() const
+	{
+		return *pos;
+	}
+
+	ChunkIterator& operator++()
+	{
+		if (QUANTUMJSON_UNLIKELY(pos + 1 >= chunkEnd))
+		{
+			// Last character of the chunk, or already at the end
+			if (pos != chunkEnd && ++pos == chunkEnd)
+			{
+				NextChunk();
+			}
+			return *this;
+		}
+		++pos;
+		return *this;
+	}
+
+	// Holds the character instead of pointing to it, as its chunk may be
+	// released by the increment
+	struct PostIncrementProxy
+	{
+		char operator*() const
+		{
+			return c;
+		}
+
+		char c;
+	};
+
+	PostIncrementProxy operator++(int)
+	{
+		PostIncrementProxy prev{*pos};
+		++*this;
+		return prev;
+	}
+
+	// Iterators compare equal when both are at the end
+	bool operator==(const ChunkIterator &other) const
+	{
+		return (pos == chunkEnd) == (other.pos == other.chunkEnd);
+	}
+
+	bool operator!=(const ChunkIterator &other) const
+	{
+		return !(*this == other);
+	}
+
+	// The rest of the current chunk, empty only at the end of the input
+	const char* ChunkPtr() const
+	{
+		return pos;
+	}
+
+	const char* ChunkEndPtr() const
+	{
+		return chunkEnd;
+	}
+
+	// Skips `n` characters, up to the end of the current chunk
+	void Advance(size_t n)
+	{
+		pos += n;
+		if (pos == chunkEnd && n > 0)
+		{
+			NextChunk();
+		}
+	}
+
+private:
+	void NextChunk()
+	{
+		// Only the end of the input is an empty chunk
+		std::string_view chunk = source->Next();
+		if (chunk.empty())
+		{
+			pos = chunkEnd = &endSentinel;
+			return;
+		}
+		pos = chunk.data();
+		chunkEnd = chunk.data() + chunk.size();
+	}
+
+	static constexpr char endSentinel = '\0';
+
+	ChunkSource *source = nullptr;
+	const char *pos = &endSentinel;
+	const char *chunkEnd = &endSentinel;
+};
+
+template <typename T>
+struct IsChunkedInput : std::is_same<T, ChunkIterator>
+{
+};
+
+// When `Trusted` is set the input is assumed to be valid json. Control
+// characters and UTF-8 in strings are not checked, and literals and scalars
+// are only skipped rather than matched. Invalid input then parses into
+// unspecified values, but is still not read past its end.
+template <typename InputIteratorType, bool Trusted = false>
+struct InputProcessor
+{
+	InputProcessor(InputIteratorType begin, InputIteratorType end)
+	  : it(begin), end(end)
+	{
+	}
+
+	// Padded inputs have `InputPadding` readable bytes after `end`
+	static constexpr bool isPadded = IsPaddedInput<InputIteratorType>::value;
+
+	static constexpr bool isTrusted = Trusted;
+
+	// Raw pointers to the remaining input, only valid for contiguous inputs
+	// and when `it != end`.
+	const char* ItPtr() const
+	{
+		return &*it;
+	}
+
+	const char* EndPtr() const
+	{
+		return &*it + (end - it);
+	}
+
+	// Returns the number of plain string characters at the current position,
+	// which is everything up to a quote or an escape for trusted inputs.
+	// Only used for contiguous inputs, others are processed byte by byte.
+	size_t PlainStringRunLength() const
+	{
+		if (QUANTUMJSON_UNLIKELY(it == end))
+		{
+			return 0;
+		}
+		if constexpr (isTrusted)
+		{
+			return QuantumJsonImpl__::QuoteOrBackslashRunLength(ItPtr(), EndPtr());
+		}
+		else if constexpr (isPadded)
+		{
+			return QuantumJsonImpl__::PlainStringRunLengthPadded(ItPtr(), EndPtr());
+		}
+		return QuantumJsonImpl__::PlainStringRunLength(ItPtr(), EndPtr());
+	}
+
+	// Same as `PlainStringRunLength`, within the current chunk of chunked
+	// inputs
+	size_t ChunkPlainStringRunLength() const
+	{
+		if (QUANTUMJSON_UNLIKELY(it == end))
+		{
+			return 0;
+		}
+		if constexpr (isTrusted)
+		{
+			return QuantumJsonImpl__::QuoteOrBackslashRunLength(it.ChunkPtr(), it.ChunkEndPtr());
+		}
+		return QuantumJsonImpl__::PlainStringRunLength(it.ChunkPtr(), it.ChunkEndPtr());
+	}
+
+	// End of input checks for the generated field name matchers, where
+	// `matchedCharCnt` characters of the name are already consumed. Padded
+	// inputs only check once the read could go beyond the padding, and
+	// `FieldNameOverranEnd` after the name is matched.
+	bool FieldNameAtEnd(int matchedCharCnt) const
+	{
+		if constexpr (isPadded)
+		{
+			return matchedCharCnt >= static_cast<int>(InputPadding) - 1 && it >= end;
+		}
+		return it == end;
+	}
+
+	bool FieldNameAtEnd() const
+	{
+		return FieldNameAtEnd(std::numeric_limits<int>::max());
+	}
+
+	bool FieldNameOverranEnd() const
+	{
+		if constexpr (isPadded)
+		{
+			return it > end;
+		}
+		return false;
+	}
+
+	// Skips `literal` as a whole when the input is contiguous, returns false
+	// if it does not match so the caller can report the error. Trusted
+	// inputs are not compared, the first character already told the literal.
+	template <size_t N>
+	bool SkipLiteral(const char (&literal)[N])
+	{
+		constexpr size_t len = N - 1;
+		if constexpr (IsContiguousInput<InputIteratorType>::value)
+		{
+			if (static_cast<size_t>(end - it) >= len && (isTrusted || memcmp(ItPtr(), literal, len) == 0))
+			{
+				it += len;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void SkipWhitespace()
+	{
+		// Most JSON data are compact, so whitespace is marked as unlikely
+		if (QUANTUMJSON_LIKELY(it == end || !IsWhitespace(*it)))
+		{
+			return;
+		}
+
+		if constexpr (isPadded)
+		{
+			it += WhitespaceRunLengthPadded(ItPtr(), EndPtr());
+		}
+		else if constexpr (IsContiguousInput<InputIteratorType>::value)
+		{
+			it += WhitespaceRunLength(ItPtr(), EndPtr());
+		}
+		else if constexpr (IsChunkedInput<InputIteratorType>::value)
+		{
+			// Whitespace may go on in the next chunk
+			while (it != end && IsWhitespace(*it))
+			{
+				it.Advance(WhitespaceRunLength(it.ChunkPtr(), it.ChunkEndPtr()));
+			}
+		}
+		else
+		{
+			while (it != end && IsWhitespace(*it))
+			{
+				++it;
+			}
+		}
+	}
+
+	inline
+	int parseHexadecimalByte()
+	{
+		// FIXME can't use QUANTUMJSON_CHECK_EOF_AND_PROPAGATE as return value is non void
+		if (QUANTUMJSON_UNLIKELY(this->it == this->end))
+		{
+			this->errorCode = ErrorCode::UnexpectedEOF;
+			return -1;
+		}
+		char c = *(this->it++);
+		if (QUANTUMJSON_LIKELY(c >= '0' && c <= '9')) return c - '0';
+		if (QUANTUMJSON_LIKELY(c >= 'a' && c <= 'f')) return c - 'a' + 10;
+		if (QUANTUMJSON_LIKELY(c >= 'A' && c <= 'F')) return c - 'A' + 10;
+		this->errorCode = ErrorCode::UnexpectedChar;
+		return -1;
+	}
+
+	// Parses the 4 byte hex region for excaped characters \uFFFF
+	//                                                       <-->
+	// and returns the corresponding unicode code point.
+	inline
+	int getEscapedCharCodePoint()
+	{
+		if constexpr (IsContiguousInput<InputIteratorType>::value)
+		{
+			if (QUANTUMJSON_LIKELY(end - it >= 4))
+			{
+				uint32_t value = DecodeHex4(ItPtr());
+				if (QUANTUMJSON_LIKELY(value <= 0xFFFF))
+				{
+					it += 4;
+					return value;
+				}
+			}
+			// Errors are reported by the loop below
+		}
+
+		int codePoint = 0;
+
+		for (int i = 0; i < 4; ++i)
+		{
+			codePoint <<= 4;
+			int hexValue = parseHexadecimalByte();
+			// FIXME can't use QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE as return value is non void
+			if (QUANTUMJSON_UNLIKELY(this->errorCode != ErrorCode::NoError))
+			{
+				return -1;
+			}
+			codePoint |= hexValue;
+		}
+
+		return codePoint;
+	}
+
+	// Gets the code point assuming \u is already parsed,
+	// also parses the next \uXXXX sequence if this is a surrogate pair.
+	inline
+	void getCodePoint(int *out)
+	{
+		// Code-point consists of 4 hexadecimal numbers
+		int cp = getEscapedCharCodePoint(); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+
+		// Check if value is UTF-16 surrogate pair
+		if (cp >= 0xD800 && cp <= 0xDFFF)
+		{
+			if (cp >= 0xDC00)
+			{
+				// Must start with high surrogate
+				this->errorCode = ErrorCode::InvalidSurrogate;
+				return;
+			}
+
+			// Take a well formed pair in one step
+			if constexpr (IsContiguousInput<InputIteratorType>::value)
+			{
+				if (end - it >= 6 && it[0] == '\\' && it[1] == 'u')
+				{
+					uint32_t cp2 = DecodeHex4(ItPtr() + 2);
+					if (QUANTUMJSON_LIKELY(cp2 >= 0xDC00 && cp2 <= 0xDFFF))
+					{
+						it += 6;
+						*out = 0x10000 + ((cp & 0x3FF) << 10) + (cp2 & 0x3FF);
+						return;
+					}
+				}
+			}
+
+			// Parse the pair
+			this->SkipChar('\\'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+			this->SkipChar('u'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+
+			int cp2 = getEscapedCharCodePoint(); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+			if (cp2 < 0xDC00 || cp2 > 0xDFFF)
+			{
+				// Surrogate pair must be followed by low surrogate
+				this->errorCode = ErrorCode::InvalidSurrogate;
+				return;
+			}
+
+			cp = 0x10000 + ((cp & 0x3FF) << 10) + (cp2 & 0x3FF);
+		}
+
+		*out = cp;
+	}
+
+	// Returns the length of code point when encoded in UTF-8
+	int codePointUtf8Bytes(int codePoint)
+	{
+		if (QUANTUMJSON_LIKELY(codePoint <= 0x7f))
+		{
+			return 1;
+		}
+		if (QUANTUMJSON_LIKELY(codePoint <= 0x7ff))
+		{
+			return 2;
+		}
+		if (QUANTUMJSON_LIKELY(codePoint <= 0xffff))
+		{
+			return 3;
+		}
+		if (QUANTUMJSON_LIKELY(codePoint <= 0x10ffff))
+		{
+			return 4;
+		}
+		else
+		{
+			// Should not happen
+			this->errorCode = ErrorCode::UnsupportedUnicodeRange;
+			return -1;
+		}
+	}
+
+	// Skips string and returns number of bytes required to store the string,
+	// exluding the null terminator.
+	void SkipString(int64_t *outStrSize = nullptr)
+	{
+		int64_t strSize = 0;
+		SkipChar('"'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+
+		while (1)
+		{
+			if constexpr (IsContiguousInput<InputIteratorType>::value)
+			{
+				size_t runLength = PlainStringRunLength();
+				it += runLength;
+				strSize += runLength;
+			}
+			else if constexpr (IsChunkedInput<InputIteratorType>::value)
+			{
+				size_t runLength = ChunkPlainStringRunLength();
+				it.Advance(runLength);
+				strSize += runLength;
+			}
+
+			QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+
+			if constexpr (!isTrusted)
+			{
+				if (QUANTUMJSON_UNLIKELY((*it & 0b11100000) == 0))
+				{
+					errorCode = ErrorCode::ControlCharacterInString;
+					return;
+				}
+			}
+
+			if (QUANTUMJSON_UNLIKELY(*it == '"'))
+			{
+				++it;
+				if (outStrSize)
+				{
+					*outStrSize = strSize;
+				}
+				return;
+			}
+
+			if (QUANTUMJSON_UNLIKELY(*it == '\\'))
+			{
+				++it;
+
+				QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+
+				// TODO check escape character
+				if (*it == '"' || *it == '\\' || *it == '/' || *it == 'b' || *it == 'f'
+				    || *it == 'n' || *it == 'r' || *it == 't')
+				{
+					++it;
+					++strSize;
+					continue;
+				}
+
+				if (*it == 'u')
+				{
+					++it;
+					int codePoint = -1;
+					getCodePoint(&codePoint); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+
+					strSize += codePointUtf8Bytes(codePoint);
+					continue;
+				}
+
+				errorCode = ErrorCode::InvalidEscape;
+				return;
+			}
+
+			++strSize;
+			++it;
+		}
+	}
+
+	void SkipDigits()
+	{
+		while (it != end && *it >= '0' && *it <= '9')
+		{
+			++it;
+		}
+	}
+
+	void SkipNumber()
+	{
+		QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+		if (*it == '-')
+		{
+			++it;
+			QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+		}
+
+		// Integer part
+		if (*it == '0')
+		{
+			++it;
+		}
+		else if (QUANTUMJSON_LIKELY(*it > '0' && *it <= '9'))
+		{
+			SkipDigits();
+		}
+		else
+		{
+			errorCode = ErrorCode::UnexpectedToken;
+			return;
+		}
+
+		// Fraction part
+		if (it != end && *it == '.')
+		{
+			++it;
+			QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+			if (QUANTUMJSON_UNLIKELY(*it < '0' || *it > '9'))
+			{
+				errorCode = ErrorCode::UnexpectedToken;
+				return;
+			}
+			SkipDigits();
+		}
+
+		// Exponent part
+		if (it != end && (*it == 'e' || *it == 'E'))
+		{
+			++it;
+			QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+			if (*it == '-' || *it == '+')
+			{
+				++it;
+				QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+			}
+			if (QUANTUMJSON_UNLIKELY(*it < '0' || *it > '9'))
+			{
+				errorCode = ErrorCode::UnexpectedToken;
+				return;
+			}
+			SkipDigits();
+		}
+	}
+
+	void SkipNull()
+	{
+		if (QUANTUMJSON_LIKELY(SkipLiteral("null")))
+		{
+			return;
+		}
+		SkipChar('n'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		SkipChar('u'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		SkipChar('l'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		SkipChar('l'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+	}
+
+	void SkipTrue()
+	{
+		if (QUANTUMJSON_LIKELY(SkipLiteral("true")))
+		{
+			return;
+		}
+		SkipChar('t'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		SkipChar('r'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		SkipChar('u'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		SkipChar('e'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+	}
+
+	void SkipFalse()
+	{
+		if (QUANTUMJSON_LIKELY(SkipLiteral("false")))
+		{
+			return;
+		}
+		SkipChar('f'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		SkipChar('a'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		SkipChar('l'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		SkipChar('s'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		SkipChar('e'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+	}
+
+	// Skips the object or list at `it` one character at a time. Open
+	// containers are kept in a bracket stack rather than on the call stack,
+	// so the nesting is only limited by `maxDepth`.
+	void SkipContainer()
+	{
+		BracketStack scopes;
+		const int depthLimit = maxDepth - depth;
+		int scopeDepth = 0;
+		// Kind of the innermost open container
+		bool inObject;
+
+	scope_begin:
+		// `it` is at an opening bracket
+		if (QUANTUMJSON_UNLIKELY(scopeDepth >= depthLimit))
+		{
+			errorCode = ErrorCode::DepthLimitExceeded;
+			return;
+		}
+		inObject = (*it == '{');
+		scopes.Set(scopeDepth++, inObject);
+		++it;
+		SkipWhitespace();
+		QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+		if (*it == (inObject ? '}' : ']'))
+		{
+			++it;
+			goto scope_end;
+		}
+		goto element;
+
+	element_end:
+		SkipWhitespace();
+		QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+		if (*it == (inObject ? '}' : ']'))
+		{
+			++it;
+			goto scope_end;
+		}
+		SkipChar(','); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		SkipWhitespace();
+		QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+
+	element:
+		if (inObject)
+		{
+			SkipString(); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+			SkipWhitespace();
+			SkipChar(':'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+			SkipWhitespace();
+			QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+		}
+		if (*it == '{' || *it == '[')
+		{
+			goto scope_begin;
+		}
+		SkipValue(); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		goto element_end;
+
+	scope_end:
+		--scopeDepth;
+		if (scopeDepth > 0)
+		{
+			inObject = scopes.IsObject(scopeDepth - 1);
+			goto element_end;
+		}
+	}
+
+	// Skips the object or list at `it` for contiguous inputs.
+	//
+	// Input is classified in 64 byte blocks into bitmasks of quotes,
+	// backslashes and structural characters. Escaped quotes are found with
+	// carry between blocks, and the characters inside strings are marked
+	// with a prefix xor over the quotes, so strings are skipped without
+	// looking at their contents. Only structural characters and scalar
+	// values are visited one by one to validate the grammar, which ends at
+	// the matching close bracket.
+	//
+	// Nesting is limited by `maxDepth` like in `SkipContainer`. Returns false
+	// if the limit allows nesting deeper than the inline bracket stack and
+	// the input goes there, `SkipContainer` should be used then.
+	bool SkipContainerVectorized()
+	{
+		const int inlineDepth = 1024;
+		// Bit `d` is set when the container at depth `d` is an object
+		uint64_t isObject[inlineDepth / 64];
+		const int depthLimit = maxDepth - depth;
+		const int scopeLimit = std::min(depthLimit, inlineDepth);
+		int scopeDepth = 0;
+
+		const char *begin = ItPtr();
+		const char *endPtr = EndPtr();
+
+		const char *block = begin;
+		uint64_t tokens = 0;
+		uint64_t special = 0;
+		uint64_t nextIsEscaped = 0;
+		uint64_t prevInString = 0;
+		uint64_t prevIsScalar = 0;
+		// Escapes before this are already validated as a part of surrogate pairs
+		const char *validatedUntil = begin;
+		bool firstBlock = true;
+		void (*classifyBlock)(const char *block, BlockMasks *out) = ActiveKernels().classifyBlock;
+
+		// Returns the position of the next token, or nullptr when an error
+		// is set.
+		auto nextToken = [&]() -> const char*
+		{
+			while (QUANTUMJSON_UNLIKELY(tokens == 0))
+			{
+				if (QUANTUMJSON_UNLIKELY(special)
+				    && !ValidateStringSpecials(block, &special, block + 64, endPtr, &validatedUntil))
+				{
+					return nullptr;
+				}
+
+				if (!firstBlock)
+				{
+					block += 64;
+				}
+				if (QUANTUMJSON_UNLIKELY(block >= endPtr))
+				{
+					it += endPtr - begin;
+					errorCode = ErrorCode::UnexpectedEOF;
+					return nullptr;
+				}
+
+				BlockMasks masks;
+				if (QUANTUMJSON_LIKELY(endPtr - block >= 64))
+				{
+					classifyBlock(block, &masks);
+				}
+				else if constexpr (isPadded)
+				{
+					// Treat the bytes past the end as whitespace
+					classifyBlock(block, &masks);
+					uint64_t pastEnd = ~uint64_t(0) << (endPtr - block);
+					masks.quote &= ~pastEnd;
+					masks.backslash &= ~pastEnd;
+					masks.control &= ~pastEnd;
+					masks.op &= ~pastEnd;
+					masks.whitespace |= pastEnd;
+				}
+				else
+				{
+					// Pad the last block with whitespace
+					char padded[64];
+					memset(padded, ' ', sizeof(padded));
+					memcpy(padded, block, endPtr - block);
+					classifyBlock(padded, &masks);
+				}
+
+				uint64_t escaped = FindEscapedChars(masks.backslash, &nextIsEscaped);
+				uint64_t quote = masks.quote & ~escaped;
+				// Includes opening quotes, excludes closing ones
+				uint64_t inString = PrefixXor(quote) ^ prevInString;
+				prevInString = uint64_t(int64_t(inString) >> 63);
+
+				uint64_t scalar = ~(masks.whitespace | masks.op | quote | inString);
+				uint64_t scalarStart = scalar & ~((scalar << 1) | prevIsScalar);
+				prevIsScalar = scalar >> 63;
+
+				tokens = (masks.op & ~inString) | (quote & inString) | scalarStart;
+				// Characters in strings that need a closer look
+				if constexpr (!isTrusted)
+				{
+					special = (masks.control | (masks.backslash & ~escaped)) & inString;
+				}
+
+				if (firstBlock)
+				{
+					// Opening bracket is already consumed
+					tokens &= ~uint64_t(1);
+					firstBlock = false;
+				}
+			}
+
+			const char *p = block + CountTrailingZeros(tokens);
+			tokens &= tokens - 1;
+
+			if (QUANTUMJSON_UNLIKELY(special)
+			    && !ValidateStringSpecials(block, &special, p, endPtr, &validatedUntil))
+			{
+				return nullptr;
+			}
+			return p;
+		};
+
+		const char *p = begin;
+
+		// Each label below is a parser state, `p` points to the token that
+		// moved into the state.
+		#define QUANTUMJSON_NEXT_TOKEN \
+			if (QUANTUMJSON_LIKELY((tokens != 0) & (special == 0))) \
+			{ \
+				p = block + CountTrailingZeros(tokens); \
+				tokens &= tokens - 1; \
+			} \
+			else \
+			{ \
+				p = nextToken(); \
+				if (QUANTUMJSON_UNLIKELY(p == nullptr)) \
+				{ \
+					return true; \
+				} \
+			}
+
+		#define QUANTUMJSON_PUSH_SCOPE(objectScope) \
+			if (QUANTUMJSON_UNLIKELY(scopeDepth >= scopeLimit)) \
+			{ \
+				goto too_deep; \
+			} \
+			if (objectScope) \
+			{ \
+				isObject[scopeDepth / 64] |= uint64_t(1) << (scopeDepth % 64); \
+			} \
+			else \
+			{ \
+				isObject[scopeDepth / 64] &= ~(uint64_t(1) << (scopeDepth % 64)); \
+			} \
+			++scopeDepth;
+
+		if (*p == '{')
+		{
+			QUANTUMJSON_PUSH_SCOPE(true);
+			goto object_begin;
+		}
+		else
+		{
+			QUANTUMJSON_PUSH_SCOPE(false);
+			goto array_begin;
+		}
+
+	object_begin:
+		QUANTUMJSON_NEXT_TOKEN;
+		if (QUANTUMJSON_LIKELY(*p == '"'))
+		{
+			goto object_key;
+		}
+		if (*p == '}')
+		{
+			goto scope_end;
+		}
+		goto unexpected_char;
+
+	object_key:
+		QUANTUMJSON_NEXT_TOKEN;
+		if (QUANTUMJSON_UNLIKELY(*p != ':'))
+		{
+			goto unexpected_char;
+		}
+		QUANTUMJSON_NEXT_TOKEN;
+		switch (*p)
+		{
+		case '"':
+			goto object_continue;
+		case '{':
+			QUANTUMJSON_PUSH_SCOPE(true);
+			goto object_begin;
+		case '[':
+			QUANTUMJSON_PUSH_SCOPE(false);
+			goto array_begin;
+		case '}':
+		case ']':
+		case ',':
+		case ':':
+			goto unexpected_char;
+		default:
+			if (QUANTUMJSON_UNLIKELY(!isTrusted && !SkipScalarToken(p, endPtr)))
+			{
+				return true;
+			}
+			goto object_continue;
+		}
+
+	object_continue:
+		QUANTUMJSON_NEXT_TOKEN;
+		if (QUANTUMJSON_LIKELY(*p == ','))
+		{
+			QUANTUMJSON_NEXT_TOKEN;
+			if (QUANTUMJSON_UNLIKELY(*p != '"'))
+			{
+				goto unexpected_char;
+			}
+			goto object_key;
+		}
+		if (*p == '}')
+		{
+			goto scope_end;
+		}
+		goto unexpected_char;
+
+	scope_end:
+		--scopeDepth;
+		if (scopeDepth == 0)
+		{
+			it += (p + 1) - begin;
+			return true;
+		}
+		if ((isObject[(scopeDepth - 1) / 64] >> ((scopeDepth - 1) % 64)) & 1)
+		{
+			goto object_continue;
+		}
+		goto array_continue;
+
+	array_begin:
+		QUANTUMJSON_NEXT_TOKEN;
+		if (*p == ']')
+		{
+			goto scope_end;
+		}
+
+	array_value:
+		switch (*p)
+		{
+		case '"':
+			goto array_continue;
+		case '{':
+			QUANTUMJSON_PUSH_SCOPE(true);
+			goto object_begin;
+		case '[':
+			QUANTUMJSON_PUSH_SCOPE(false);
+			goto array_begin;
+		case '}':
+		case ']':
+		case ',':
+		case ':':
+			goto unexpected_char;
+		default:
+			if (QUANTUMJSON_UNLIKELY(!isTrusted && !SkipScalarToken(p, endPtr)))
+			{
+				return true;
+			}
+			goto array_continue;
+		}
+
+	array_continue:
+		QUANTUMJSON_NEXT_TOKEN;
+		if (QUANTUMJSON_LIKELY(*p == ','))
+		{
+			QUANTUMJSON_NEXT_TOKEN;
+			goto array_value;
+		}
+		if (*p == ']')
+		{
+			goto scope_end;
+		}
+		goto unexpected_char;
+
+	unexpected_char:
+		it += p - ItPtr();
+		errorCode = ErrorCode::UnexpectedChar;
+		return true;
+
+	too_deep:
+		if (scopeDepth < depthLimit)
+		{
+			return false;
+		}
+		it += p - ItPtr();
+		errorCode = ErrorCode::DepthLimitExceeded;
+		return true;
+
+		#undef QUANTUMJSON_NEXT_TOKEN
+		#undef QUANTUMJSON_PUSH_SCOPE
+	}
+
+	// Validates the scalar value (number, true, false, null) at `p`, which
+	// must be followed by a non-scalar character. Returns false and sets
+	// the error on invalid values.
+	bool SkipScalarToken(const char *p, const char *endPtr)
+	{
+		// Fast path for plain integers, anything else is checked below
+		const char *q = p + (*p == '-');
+		if (q != endPtr && *q >= '1' && *q <= '9')
+		{
+			++q;
+			q += DigitRunLength(q, endPtr);
+
+			if (q == endPtr || *q == ',' || *q == '}' || *q == ']' || *q == ' ' || *q == '\n')
+			{
+				return true;
+			}
+		}
+		return SkipScalarTokenSlow(p, endPtr);
+	}
+
+	QUANTUMJSON_NOINLINE bool SkipScalarTokenSlow(const char *p, const char *endPtr)
+	{
+		InputProcessor<const char*> scalarValue(p, endPtr);
+		scalarValue.SkipValue();
+		if (QUANTUMJSON_UNLIKELY(scalarValue.errorCode != ErrorCode::NoError))
+		{
+			it += scalarValue.it - ItPtr();
+			errorCode = scalarValue.errorCode;
+			return false;
+		}
+
+		const char *valueEnd = scalarValue.it;
+		if (QUANTUMJSON_UNLIKELY(valueEnd != endPtr && *valueEnd != '"'
+		    && *valueEnd != ' ' && *valueEnd != '\t' && *valueEnd != '\n' && *valueEnd != '\r'
+		    && *valueEnd != '{' && *valueEnd != '}' && *valueEnd != '['
+		    && *valueEnd != ']' && *valueEnd != ':' && *valueEnd != ','))
+		{
+			it += valueEnd - ItPtr();
+			errorCode = ErrorCode::UnexpectedToken;
+			return false;
+		}
+		return true;
+	}
+
+	// Validates control characters and escapes in strings marked in
+	// `special` that are before `until`, and clears them from the mask.
+	// Returns false and sets the error on invalid ones.
+	bool ValidateStringSpecials(const char *block, uint64_t *special, const char *until,
+	                            const char *endPtr, const char **validatedUntil)
+	{
+		const char *begin = ItPtr();
+
+		while (*special)
+		{
+			const char *p = block + CountTrailingZeros(*special);
+			if (p >= until)
+			{
+				break;
+			}
+			*special &= *special - 1;
+
+			if (static_cast<unsigned char>(*p) < 0x20)
+			{
+				it += p - begin;
+				errorCode = ErrorCode::ControlCharacterInString;
+				return false;
+			}
+			if (p < *validatedUntil)
+			{
+				continue;
+			}
+
+			InputProcessor<const char*> escape(p, endPtr);
+			escape.SkipEscape();
+			*validatedUntil = escape.it;
+			if (QUANTUMJSON_UNLIKELY(escape.errorCode != ErrorCode::NoError))
+			{
+				it += escape.it - begin;
+				errorCode = escape.errorCode;
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Validates the escape sequence at `it` in a string, including the
+	// following low surrogate when it is a high surrogate.
+	void SkipEscape()
+	{
+		SkipChar('\\'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+
+		switch (*(it++))
+		{
+		case '"':
+		case '\\':
+		case '/':
+		case 'b':
+		case 'f':
+		case 'n':
+		case 'r':
+		case 't':
+			return;
+		case 'u':
+		{
+			int codePoint = -1;
+			getCodePoint(&codePoint);
+			return;
+		}
+		default:
+			--it;
+			errorCode = ErrorCode::InvalidEscape;
+			return;
+		}
+	}
+
+	void SkipValue()
+	{
+		QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+
+		switch (*it)
+		{
+			case '"':
+				SkipString();
+				return;
+			case '-':
+			case '0':
+			case '1':
+			case '2':
+			case '3':
+			case '4':
+			case '5':
+			case '6':
+			case '7':
+			case '8':
+			case '9':
+				SkipNumber();
+				return;
+			case 'f':
+				SkipFalse();
+				return;
+			case 'n':
+				SkipNull();
+				return;
+			case 't':
+				SkipTrue();
+				return;
+			case '{':
+			case '[':
+				if constexpr (IsContiguousInput<InputIteratorType>::value)
+				{
+					if (QUANTUMJSON_LIKELY(SkipContainerVectorized()))
+					{
+						return;
+					}
+				}
+				SkipContainer();
+				return;
+
+			// TODO implement others
+			default:
+				errorCode = ErrorCode::UnexpectedToken;
+				return;
+		}
+	}
+
+	// Called when parsing into a nested object or list starts, fails if it
+	// is nested deeper than `maxDepth`.
+	void EnterContainer()
+	{
+		if (QUANTUMJSON_UNLIKELY(depth >= maxDepth))
+		{
+			errorCode = ErrorCode::DepthLimitExceeded;
+			return;
+		}
+		++depth;
+	}
+
+	void LeaveContainer()
+	{
+		--depth;
+	}
+
+	void SkipChar(char c)
+	{
+		QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+
+		if (QUANTUMJSON_UNLIKELY(*it != c))
+		{
+			errorCode = ErrorCode::UnexpectedChar;
+			return;
+		}
+
+		++it;
+	}
+
+	void MaybeSkipNull(bool *skipped)
+	{
+		*skipped = false;
+
+		QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+		if (QUANTUMJSON_UNLIKELY(*it == 'n'))
+		{
+			SkipNull(); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+			QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+			*skipped = true;
+		}
+	}
+
+
+	// Number of objects and lists open around the current position, and
+	// how deep they may be nested
+	int depth = 0;
+	int maxDepth = QUANTUMJSON_MAX_DEPTH;
+
+	ErrorCode errorCode = ErrorCode::NoError;
+	InputIteratorType it;
+	InputIteratorType end;
+};
+
+
+// Size of a string/vector, or for objects the tape index their fields end
+// at, recorded by `PreAllocator`. Field entries also carry the field tag.
+struct FieldSizeInfo
+{
+	int64_t fieldTag:   16;
+	int64_t objectSize: 48;
+
+	FieldSizeInfo()
+	    : fieldTag(0), objectSize(0)
+	{
+	}
+
+	FieldSizeInfo(int16_t fieldTag, int64_t objectSize)
+	    : fieldTag(fieldTag), objectSize(objectSize)
+	{
+	}
+};
+
+// Flat array of sizes written by the first pass of `PreAllocator` and read
+// back in order by the second. Small documents fit in the inline buffer,
+// larger ones spill to a thread local vector that keeps its capacity for
+// the next parse on the thread, so a steady state parse does not allocate
+// for the tape. Tapes of very large documents are freed after use rather
+// than held on to.
+class SizeTape
+{
+public:
+	SizeTape() = default;
+	SizeTape(const SizeTape &) = delete;
+	SizeTape& operator=(const SizeTape &) = delete;
+
+	~SizeTape()
+	{
+		if (spill == &ThreadLocalStorage().buffer)
+		{
+			if (spill->capacity() > MaxRetainedCapacity)
+			{
+				std::vector<FieldSizeInfo>().swap(*spill);
+			}
+			ThreadLocalStorage().inUse = false;
+		}
+	}
+
+	size_t size() const
+	{
+		return count;
+	}
+
+	void push_back(FieldSizeInfo info)
+	{
+		if (QUANTUMJSON_UNLIKELY(count == capacity))
+		{
+			Grow();
+		}
+		data[count++] = info;
+	}
+
+	FieldSizeInfo& operator[](size_t idx)
+	{
+		return data[idx];
+	}
+
+private:
+	struct Storage
+	{
+		std::vector<FieldSizeInfo> buffer;
+		bool inUse = false;
+	};
+
+	static Storage& ThreadLocalStorage()
+	{
+		static thread_local Storage storage;
+		return storage;
+	}
+
+	QUANTUMJSON_NOINLINE
+	void Grow()
+	{
+		if (spill == nullptr)
+		{
+			// Thread local buffer is taken if another tape on this thread
+			// is alive, fall back to a buffer of our own then
+			Storage &tls = ThreadLocalStorage();
+			if (!tls.inUse)
+			{
+				tls.inUse = true;
+				spill = &tls.buffer;
+			}
+			else
+			{
+				spill = &ownBuffer;
+			}
+
+			spill->resize(std::max(spill->capacity(), capacity * 2));
+			std::copy(inlineBuffer, inlineBuffer + count, spill->data());
+		}
+		else
+		{
+			spill->resize(capacity * 2);
+		}
+
+		data = spill->data();
+		capacity = spill->size();
+	}
+
+	static constexpr size_t InlineCapacity = 32;
+	static constexpr size_t MaxRetainedCapacity = 64 * 1024;
+
+	FieldSizeInfo inlineBuffer[InlineCapacity];
+	FieldSizeInfo *data = inlineBuffer;
+	size_t count = 0;
+	size_t capacity = InlineCapacity;
+
+	std::vector<FieldSizeInfo> *spill = nullptr;
+	std::vector<FieldSizeInfo> ownBuffer;
+};
+
+// Class that goes over the JSON and allocates string/vector members to
+// relevant sizes. Later, `Parser` goes over the JSON again and parses the
+// data into vectors/strings that have reserved capacities. This prevents
+// strings/vectors growing with `push_back` calls and prevents copying of
+// data. Vectors are resized rather than reserved, so the parser needs
+// `reuseCapacity` set to parse into the prepared elements.
+//
+// In the first pass, JSON list/string sizes are computed and stored in
+// `fieldSizes` tape. Second pass is over the tape which is used to
+// reserve space in containers.
+//
+// Enabled with `QuantumJson::Parse<QuantumJson::Preallocate>(...)`.
+template <typename InputIteratorType>
+struct PreAllocator : InputProcessor<InputIteratorType>
+{
+	// PreAllocator does not instantiate when the input is not a
+	// `random_acceess_iterator`.
+	static_assert(IsRandomAccessIterator<InputIteratorType>::value,
+	              "PreAllocator only works with random access iterators");
+
+	PreAllocator(InputIteratorType begin, InputIteratorType end)
+	  : InputProcessor<InputIteratorType>(begin, end)
+	{
+	}
+
+	// // TODO ReserveSpaceIn shoudl be the only public member function
+	template <typename T>
+	void ReserveSpaceIn(T &obj)
+	{
+		if constexpr (HasSize<T>::value)
+		{
+			size_t idx = AllocateSizeIndexForElem(&obj);
+			this->SkipWhitespace();
+			CalculateSpaceToReserveIn(idx, static_cast<const T*>(nullptr));
+
+			// Nothing is reserved for invalid input, parser reports the error
+			if (this->errorCode != ErrorCode::NoError)
+			{
+				return;
+			}
+
+			ReserveCalculatedSpaceIn(obj);
+		}
+	}
+
+	size_t VisitingField(int fieldTag)
+	{
+		// TODO restrict fieldTag to int16_t?
+
+		size_t idx = fieldSizes.size();
+		fieldSizes.push_back( FieldSizeInfo(fieldTag, 0) );
+
+		return idx;
+	}
+
+	void SetFieldSize(size_t fieldSizeIdx, size_t size)
+	{
+		fieldSizes[fieldSizeIdx].objectSize = size;
+	}
+
+	size_t GetFieldTag()
+	{
+		return fieldSizes[fieldSizeIdx].fieldTag;
+	}
+
+	size_t GetObjectSize()
+	{
+		return fieldSizes[fieldSizeIdx].objectSize;
+	}
+
+	void PopObject()
+	{
+		fieldSizeIdx++;
+	}
+
+	size_t GetCurIdx()
+	{
+		return fieldSizeIdx;
+	}
+
+	template <typename Allocator>
+	void CalculateSpaceToReserveIn(size_t fieldSizeIdx, const BasicString<Allocator> *)
+	{
+		if (SkipIfNull())
+		{
+			SetFieldSize(fieldSizeIdx, 0);
+			return;
+		}
+
+		// Reserve just enough space
+		int64_t strSize = -1;
+		this->SkipString(&strSize); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		SetFieldSize(fieldSizeIdx, strSize);
+	}
+
+	template <typename Allocator>
+	void ReserveCalculatedSpaceIn(BasicString<Allocator> &obj)
+	{
+		obj.reserve( GetObjectSize() );
+		PopObject();
+	}
+
+	// Argument is only provided for template overloading, it is not used
+	template <typename ElemType, typename Allocator>
+	void CalculateSpaceToReserveIn(size_t fieldSizeIdx, const std::vector<ElemType, Allocator> *)
+	{
+		if (SkipIfNull())
+		{
+			SetFieldSize(fieldSizeIdx, 0);
+			return;
+		}
+
+		// Reserve just enough space
+		size_t elemCnt = 0;
+
+		this->SkipChar('['); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		this->EnterContainer(); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		this->SkipWhitespace();
+
+		while (1)
+		{
+			QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+
+			if (QUANTUMJSON_UNLIKELY(*(this->it) == ']'))
+			{
+				++this->it;
+				this->LeaveContainer();
+				break;
+			}
+
+			if (elemCnt > 0)
+			{
+				this->SkipChar(','); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+				this->SkipWhitespace();
+			}
+
+			size_t elemSizeIdx = AllocateSizeIndexForElem(static_cast<const ElemType*>(nullptr));
+			CalculateSpaceToReserveIn(elemSizeIdx, static_cast<const ElemType*>(nullptr));
+			QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+
+			this->SkipWhitespace();
+			++elemCnt;
+		}
+
+		SetFieldSize(fieldSizeIdx, elemCnt);
+	}
+
+	template <typename ObjectType>
+	void CalculateSpaceToReserveIn(size_t fieldSizeIdx, const ObjectType *obj)
+	{
+		if constexpr (HasSize<ObjectType>::value)
+		{
+			CalculateSpaceToReserveInObject(fieldSizeIdx, obj);
+		}
+		else
+		{
+			// Basic types, nothing to reserve
+			// TODO find a nicer solution here with no unnecessary function calls
+			this->SkipValue();
+		}
+	}
+
+	template <typename ObjectType>
+	void CalculateSpaceToReserveInObject(size_t fieldSizeIdx, const ObjectType *)
+	{
+		this->SkipWhitespace();
+
+		if (SkipIfNull())
+		{
+			SetFieldSize(fieldSizeIdx, fieldSizes.size());
+			return;
+		}
+
+		this->SkipChar('{'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		this->EnterContainer(); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		this->SkipWhitespace();
+
+		if (this->it != this->end && *(this->it) != '}')
+		{
+			// TODO Or call static function via nullptr?
+			ObjectType::ReserveNextField(*this); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+			this->SkipWhitespace();
+		}
+
+		while (this->it != this->end && *(this->it) != '}')
+		{
+			this->SkipChar(','); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+			this->SkipWhitespace();
+
+			ObjectType::ReserveNextField(*this); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+			this->SkipWhitespace();
+		}
+
+		this->SkipChar('}'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		this->LeaveContainer();
+
+		// Set object size as current unallocated index
+		SetFieldSize(fieldSizeIdx, fieldSizes.size());
+	}
+
+	template <typename ObjectType>
+	void ReserveCalculatedSpaceIn(ObjectType &obj)
+	{
+		if constexpr (HasSize<ObjectType>::value)
+		{
+			obj.ReserveCalculatedSpace(*this);
+		}
+	}
+
+	template <typename ElemType, typename Allocator>
+	void ReserveCalculatedSpaceIn(std::vector<ElemType, Allocator> &obj)
+	{
+		obj.resize( GetObjectSize() );
+		PopObject();
+
+		if constexpr (HasSize<ElemType>::value)
+		{
+			for (auto &e : obj)
+			{
+				ReserveCalculatedSpaceIn(e);
+			}
+		}
+	}
+
+
+private:
+	template <typename ElemType>
+	size_t AllocateSizeIndexForElem(const ElemType *)
+	{
+		if constexpr (HasSize<ElemType>::value)
+		{
+			size_t idx = fieldSizes.size();
+			fieldSizes.push_back( FieldSizeInfo() );
+			return idx;
+		}
+		else
+		{
+			return -1;
+		}
+	}
+
+	// Nulls get nothing reserved, parser decides whether they are valid
+	bool SkipIfNull()
+	{
+		if (this->it != this->end && *(this->it) == 'n')
+		{
+			this->SkipNull();
+			return true;
+		}
+		return false;
+	}
+
+	// Used in PopSize calls while reserving
+	size_t fieldSizeIdx = 0;
+	SizeTape fieldSizes;
+};
+
+
+template <typename InputIteratorType, bool Trusted = false>
+struct Parser : InputProcessor<InputIteratorType, Trusted>
+{
+	Parser(InputIteratorType begin, InputIteratorType end)
+	  : InputProcessor<InputIteratorType, Trusted>(begin, end)
+	{
+	}
+
+	template <typename Allocator>
+	void Utf8Append(int codePoint, BasicString<Allocator> &str)
+	{
+		if (QUANTUMJSON_LIKELY(codePoint <= 0x7f))
+		{
+			str.push_back( codePoint );
+			return;
+		}
+		if (codePoint <= 0x10ffff)
+		{
+			char bytes[4];
+			str.append(bytes, EncodeUtf8(codePoint, bytes));
+			return;
+		}
+		else
+		{
+			// TODO this check should be moved to surrogate pair parsing place
+			this->errorCode = ErrorCode::UnsupportedUnicodeRange;
+			return;
+		}
+	}
+
+	// Decodes the \uXXXX escape after `it`, and the ones directly following
+	// it on contiguous inputs, appending them to `str` at once. Text escaped
+	// as a whole is mostly made of such runs.
+	template <typename Allocator>
+	void AppendUnicodeEscapes(BasicString<Allocator> &str)
+	{
+		if constexpr (IsContiguousInput<InputIteratorType>::value)
+		{
+			char bytes[64];
+			size_t len = 0;
+			while (true)
+			{
+				int cp = -1;
+				this->getCodePoint(&cp); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+				len += EncodeUtf8(cp, bytes + len);
+
+				if (len + 4 > sizeof(bytes) || this->end - this->it < 2
+				    || this->it[0] != '\\' || this->it[1] != 'u')
+				{
+					break;
+				}
+				this->it += 2;
+			}
+			str.append(bytes, len);
+		}
+		else
+		{
+			int cp = -1;
+			this->getCodePoint(&cp); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+			Utf8Append(cp, str);
+		}
+	}
+
+	// Copies the UTF-8 sequence at `it` into `obj`, one byte at a time for
+	// inputs that are not contiguous. Allowed second bytes follow the
+	// "Well-Formed UTF-8 Byte Sequences" table of the Unicode standard,
+	// which rules out overlongs, surrogates and values above U+10FFFF.
+	template <typename Allocator>
+	void CopyUtf8Sequence(BasicString<Allocator> &obj)
+	{
+		unsigned char lead = *(this->it);
+		int len;
+		unsigned char secondMin = 0x80, secondMax = 0xbf;
+
+		if (lead >= 0xc2 && lead <= 0xdf)
+		{
+			len = 2;
+		}
+		else if (lead >= 0xe0 && lead <= 0xef)
+		{
+			len = 3;
+			if (lead == 0xe0) secondMin = 0xa0;
+			if (lead == 0xed) secondMax = 0x9f;
+		}
+		else if (lead >= 0xf0 && lead <= 0xf4)
+		{
+			len = 4;
+			if (lead == 0xf0) secondMin = 0x90;
+			if (lead == 0xf4) secondMax = 0x8f;
+		}
+		else
+		{
+			this->errorCode = ErrorCode::InvalidUtf8Sequence;
+			return;
+		}
+
+		obj.push_back(*(this->it));
+		++this->it;
+
+		for (int i = 1; i < len; ++i)
+		{
+			if (this->it == this->end)
+			{
+				this->errorCode = ErrorCode::InvalidUtf8Sequence;
+				return;
+			}
+
+			unsigned char c = *(this->it);
+			unsigned char minValue = (i == 1) ? secondMin : 0x80;
+			unsigned char maxValue = (i == 1) ? secondMax : 0xbf;
+			if (c < minValue || c > maxValue)
+			{
+				this->errorCode = ErrorCode::InvalidUtf8Sequence;
+				return;
+			}
+
+			obj.push_back(*(this->it));
+			++this->it;
+		}
+	}
+
+	void ParseValueInto(bool &obj)
+	{
+		QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+
+		if (QUANTUMJSON_LIKELY(*(this->it) == 't'))
+		{
+			this->SkipTrue(); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+			obj = true;
+			return;
+		}
+		else if (QUANTUMJSON_LIKELY(*(this->it) == 'f'))
+		{
+			this->SkipFalse(); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+			obj = false;
+			return;
+		}
+
+		this->errorCode = ErrorCode::UnexpectedToken;
+	}
+
+	template <typename Allocator>
+	void ParseValueInto(BasicString<Allocator> &obj)
+	{
+		// Keeps the capacity of the previous value
+		obj.clear();
+
+		this->SkipChar('"'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+
+		// Parse string characters
+		while (QUANTUMJSON_LIKELY(this->it != this->end && *(this->it) != '"'))
+		{
+			// Copy runs of plain characters at once
+			if constexpr (IsContiguousInput<InputIteratorType>::value)
+			{
+				size_t runLength = this->PlainStringRunLength();
+				if (QUANTUMJSON_LIKELY(runLength > 0))
+				{
+					obj.append(this->ItPtr(), runLength);
+					this->it += runLength;
+					continue;
+				}
+
+				// Non-ASCII text is validated up to the next quote, escape
+				// or control character and copied at once
+				if (!Trusted && static_cast<unsigned char>(*(this->it)) >= 0x80)
+				{
+					const char *runBegin = this->ItPtr();
+					runLength = EscapeFreeRunLength(runBegin, this->EndPtr());
+					if (QUANTUMJSON_UNLIKELY(!IsValidUtf8(runBegin, runBegin + runLength)))
+					{
+						this->errorCode = ErrorCode::InvalidUtf8Sequence;
+						return;
+					}
+					obj.append(runBegin, runLength);
+					this->it += runLength;
+					continue;
+				}
+			}
+			else if constexpr (IsChunkedInput<InputIteratorType>::value)
+			{
+				size_t runLength = this->ChunkPlainStringRunLength();
+				if (QUANTUMJSON_LIKELY(runLength > 0))
+				{
+					obj.append(this->it.ChunkPtr(), runLength);
+					this->it.Advance(runLength);
+					continue;
+				}
+			}
+
+			if (!Trusted && (*(this->it) & 0b11100000) == 0)
+			{
+				this->errorCode = ErrorCode::ControlCharacterInString;
+				return;
+			}
+
+			if (*(this->it) == '\\')
+			{
+				++this->it;
+
+				QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+
+				switch (*(this->it++))
+				{
+					case '"':  obj.push_back('"');  break;
+					case '\\': obj.push_back('\\'); break;
+					case '/':  obj.push_back('/');  break;
+					case 'b':  obj.push_back('\b'); break;
+					case 'f':  obj.push_back('\f'); break;
+					case 'n':  obj.push_back('\n'); break;
+					case 'r':  obj.push_back('\r'); break;
+					case 't':  obj.push_back('\t'); break;
+					case 'u':
+						AppendUnicodeEscapes(obj); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+						break;
+
+					default:
+						this->errorCode = ErrorCode::InvalidEscape;
+						return;
+				}
+			}
+			else if (!Trusted && static_cast<unsigned char>(*(this->it)) >= 0x80)
+			{
+				CopyUtf8Sequence(obj); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+			}
+			else
+			{
+				obj.push_back(*(this->it));
+				++this->it;
+			}
+		}
+
+		this->SkipChar('"'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+	}
+
+	// Points `obj` into the input when the string has no escapes, otherwise
+	// unescapes it into a string owned by `stringStorage`.
+	void ParseValueInto(std::string_view &obj)
+	{
+		if constexpr (IsContiguousInput<InputIteratorType>::value)
+		{
+			QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+			if (QUANTUMJSON_LIKELY(*(this->it) == '"'))
+			{
+				const char *begin = this->ItPtr() + 1;
+				const char *end = this->EndPtr();
+				const char *p = begin;
+				while (true)
+				{
+					if constexpr (Trusted)
+					{
+						p += QuoteOrBackslashRunLength(p, end);
+					}
+					else if constexpr (IsPaddedInput<InputIteratorType>::value)
+					{
+						p += PlainStringRunLengthPadded(p, end);
+					}
+					else
+					{
+						p += PlainStringRunLength(p, end);
+					}
+					if (p == end)
+					{
+						break;
+					}
+					if (QUANTUMJSON_LIKELY(*p == '"'))
+					{
+						obj = std::string_view(begin, p - begin);
+						this->it += (p + 1) - this->ItPtr();
+						return;
+					}
+
+					// Let the copying parser deal with escapes and report
+					// errors for anything that isn't valid UTF-8
+					if (static_cast<unsigned char>(*p) < 0x80)
+					{
+						break;
+					}
+					size_t len = EscapeFreeRunLength(p, end);
+					if (!IsValidUtf8(p, p + len))
+					{
+						break;
+					}
+					p += len;
+				}
+			}
+		}
+
+		if (QUANTUMJSON_UNLIKELY(stringStorage == nullptr))
+		{
+			// Invalid strings and other values report their own error, only
+			// valid strings that need unescaping need the storage
+			std::string str;
+			ParseValueInto(str); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+			this->errorCode = ErrorCode::MissingStringStorage;
+			return;
+		}
+
+		std::string &str = stringStorage->NewString();
+		ParseValueInto(str); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		obj = str;
+	}
+
+	void ParseValueInto(double &obj)
+	{
+		QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+
+		InputIteratorType begin = this->it;
+		NumberText text;
+		DecimalNumber num;
+
+		if (*(this->it) == '-')
+		{
+			num.negative = true;
+			NextNumberChar(&text);
+			QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+		}
+
+		// Integer part
+		if (*(this->it) == '0')
+		{
+			NextNumberChar(&text);
+		}
+		else if (QUANTUMJSON_LIKELY(*(this->it) > '0' && *(this->it) <= '9'))
+		{
+			ParseDecimalDigits(&num, false, &text);
+		}
+		else
+		{
+			this->errorCode = ErrorCode::UnexpectedToken;
+			return;
+		}
+
+		// Fraction part
+		if (this->it != this->end && *(this->it) == '.')
+		{
+			NextNumberChar(&text);
+			QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+
+			if (QUANTUMJSON_UNLIKELY(*(this->it) < '0' || *(this->it) > '9'))
+			{
+				// There must be a number after separator
+				this->errorCode = ErrorCode::UnexpectedToken;
+				return;
+			}
+			ParseDecimalDigits(&num, true, &text);
+		}
+
+		// Exponent part
+		if (this->it != this->end && (*(this->it) == 'e' || *(this->it) == 'E'))
+		{
+			NextNumberChar(&text);
+			QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+
+			bool negativeExponent = false;
+			if (*(this->it) == '-' || *(this->it) == '+')
+			{
+				negativeExponent = (*(this->it) == '-');
+				NextNumberChar(&text);
+				QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+			}
+
+			if (QUANTUMJSON_UNLIKELY(*(this->it) < '0' || *(this->it) > '9'))
+			{
+				this->errorCode = ErrorCode::UnexpectedToken;
+				return;
+			}
+
+			int64_t exponent = 0;
+			while (this->it != this->end && *(this->it) >= '0' && *(this->it) <= '9')
+			{
+				// Saturate, anything this large is zero or infinity anyway
+				if (exponent < 100000)
+				{
+					exponent = exponent * 10 + (*(this->it) - '0');
+				}
+				NextNumberChar(&text);
+			}
+			num.exponent += negativeExponent ? -exponent : exponent;
+		}
+
+		if (QUANTUMJSON_LIKELY(!num.truncated))
+		{
+			if (QUANTUMJSON_LIKELY(DecimalToDouble(num.mantissa, num.exponent, num.negative, &obj)))
+			{
+				return;
+			}
+		}
+		else
+		{
+			// Value is between mantissa and mantissa + 1 (times 10^exponent),
+			// it is only decided if both round to the same double
+			double lower, upper;
+			if (DecimalToDouble(num.mantissa, num.exponent, num.negative, &lower)
+			    && DecimalToDouble(num.mantissa + 1, num.exponent, num.negative, &upper)
+			    && lower == upper)
+			{
+				obj = lower;
+				return;
+			}
+		}
+
+		if constexpr (IsMultiPassInput<InputIteratorType>::value)
+		{
+			ParseDoubleSlow(std::string(begin, this->it), obj);
+		}
+		else
+		{
+			ParseDoubleSlow(text.Str(), obj);
+		}
+	}
+
+	// Decimal value of a JSON number, as mantissa * 10^exponent. Only the
+	// first 19 significant digits are kept in the mantissa, `truncated` is
+	// set if any of the dropped digits are non-zero.
+	struct DecimalNumber
+	{
+		uint64_t mantissa = 0;
+		int64_t exponent = 0;
+		int significantDigits = 0;
+		bool truncated = false;
+		bool negative = false;
+	};
+
+	// Characters of a number read from a single pass input, as
+	// ParseDoubleSlow can't read them again from the input. Numbers longer
+	// than `local` spill to the heap.
+	struct NumberText
+	{
+		void Append(char c)
+		{
+			if (QUANTUMJSON_LIKELY(size < sizeof(local)))
+			{
+				local[size++] = c;
+				return;
+			}
+			if (spill.empty())
+			{
+				spill.assign(local, size);
+			}
+			spill.push_back(c);
+		}
+
+		std::string Str() const
+		{
+			return spill.empty() ? std::string(local, size) : spill;
+		}
+
+		char local[64];
+		size_t size = 0;
+		std::string spill;
+	};
+
+	// Moves past a character of a number, keeping it in `text` when the
+	// input is single pass
+	void NextNumberChar(NumberText *text)
+	{
+		if constexpr (!IsMultiPassInput<InputIteratorType>::value)
+		{
+			text->Append(*(this->it));
+		}
+		++this->it;
+	}
+
+	// Parses the digits at `it` into `num`.
+	void ParseDecimalDigits(DecimalNumber *num, bool isFraction, NumberText *text)
+	{
+		while (this->it != this->end && *(this->it) >= '0' && *(this->it) <= '9')
+		{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+			if constexpr (IsContiguousInput<InputIteratorType>::value)
+			{
+				// Take 8 digits at once, after leading zeros are skipped
+				if (num->significantDigits > 0 && num->significantDigits <= 19 - 8
+				    && this->EndPtr() - this->ItPtr() >= 8)
+				{
+					uint64_t chunk;
+					memcpy(&chunk, this->ItPtr(), sizeof(chunk));
+					if (IsEightDigits(chunk))
+					{
+						num->mantissa = num->mantissa * 100000000 + ParseEightDigits(chunk);
+						num->significantDigits += 8;
+						if (isFraction)
+						{
+							num->exponent -= 8;
+						}
+						this->it += 8;
+						continue;
+					}
+				}
+			}
+#endif
+
+			unsigned digit = *(this->it) - '0';
+			if (num->significantDigits < 19)
+			{
+				num->mantissa = num->mantissa * 10 + digit;
+				if (num->mantissa != 0)
+				{
+					++num->significantDigits;
+				}
+				if (isFraction)
+				{
+					--num->exponent;
+				}
+			}
+			else
+			{
+				num->truncated |= (digit != 0);
+				if (!isFraction)
+				{
+					++num->exponent;
+				}
+			}
+			NextNumberChar(text);
+		}
+	}
+
+	// Converts the number in `doubleStr` with the standard library. Only
+	// used when DecimalToDouble can not decide on the rounding.
+	QUANTUMJSON_NOINLINE void ParseDoubleSlow(const std::string &doubleStr, double &obj)
+	{
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+		// Locale independent, unlike strtod
+		auto res = std::from_chars(doubleStr.data(), doubleStr.data() + doubleStr.size(), obj);
+		if (QUANTUMJSON_LIKELY(res.ec == std::errc()))
+		{
+			return;
+		}
+#endif
+
+		obj = strtod(doubleStr.c_str(), nullptr);
+
+		// No error checks done here, as the format is already validated.
+		// Clear possible ERANGE error from strtod.
+		errno = 0;
+	}
+
+	// Integers are parsed into all integral types via this overload set, so
+	// aliases like int64_t and uint32_t resolve to one of them.
+	void ParseValueInto(int &obj)                { ParseIntegerInto(obj); }
+	void ParseValueInto(unsigned &obj)           { ParseIntegerInto(obj); }
+	void ParseValueInto(long &obj)               { ParseIntegerInto(obj); }
+	void ParseValueInto(unsigned long &obj)      { ParseIntegerInto(obj); }
+	void ParseValueInto(long long &obj)          { ParseIntegerInto(obj); }
+	void ParseValueInto(unsigned long long &obj) { ParseIntegerInto(obj); }
+
+	// Parses a JSON integer (no fraction or exponent parts) into `obj`,
+	// setting `NumberOutOfRange` if it does not fit into IntegerType.
+	//
+	// TODO add flag to accept double values like (1234.0) as integers?
+	template <typename IntegerType>
+	void ParseIntegerInto(IntegerType &obj)
+	{
+		QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+
+		bool negative = false;
+		if (*(this->it) == '-')
+		{
+			negative = true;
+			++this->it;
+			QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+		}
+
+		if (QUANTUMJSON_UNLIKELY(*(this->it) < '0' || *(this->it) > '9'))
+		{
+			this->errorCode = ErrorCode::UnexpectedToken;
+			return;
+		}
+
+		uint64_t value = 0;
+		if (*(this->it) == '0')
+		{
+			++this->it;
+			if (QUANTUMJSON_UNLIKELY(this->it != this->end
+			                         && *(this->it) >= '0' && *(this->it) <= '9'))
+			{
+				// Leading zeros are not allowed
+				this->errorCode = ErrorCode::UnexpectedToken;
+				return;
+			}
+		}
+		else
+		{
+			// 19 digits always fit into uint64_t, only the ones after need
+			// overflow checks
+			int digitCnt = 0;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+			// Take up to 8 leading digits at once
+			if constexpr (IsContiguousInput<InputIteratorType>::value)
+			{
+				size_t remaining = this->end - this->it;
+				if (IsPaddedInput<InputIteratorType>::value || remaining >= 8)
+				{
+					uint64_t chunk;
+					memcpy(&chunk, this->ItPtr(), sizeof(chunk));
+					digitCnt = std::min<size_t>(LeadingDigitCount(chunk), remaining);
+					if (digitCnt < 8)
+					{
+						// Move the digits to the end, filling the start with '0'
+						chunk = (chunk << (8 * (8 - digitCnt)))
+						    | (0x3030303030303030ULL >> (8 * digitCnt));
+					}
+					value = ParseEightDigits(chunk);
+					this->it += digitCnt;
+				}
+			}
+#endif
+
+			while (this->it != this->end && *(this->it) >= '0' && *(this->it) <= '9')
+			{
+				unsigned digit = *(this->it) - '0';
+				if (QUANTUMJSON_UNLIKELY(digitCnt >= 19)
+				    && value > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+				{
+					this->errorCode = ErrorCode::NumberOutOfRange;
+					return;
+				}
+				value = value * 10 + digit;
+				++digitCnt;
+				++this->it;
+			}
+		}
+
+		if (negative)
+		{
+			// Magnitude of the minimum value is one more than the maximum
+			uint64_t limit = std::is_signed<IntegerType>::value
+			    ? static_cast<uint64_t>(std::numeric_limits<IntegerType>::max()) + 1
+			    : 0;
+			if (QUANTUMJSON_UNLIKELY(value > limit))
+			{
+				this->errorCode = ErrorCode::NumberOutOfRange;
+				return;
+			}
+			obj = value == 0 ? 0 : static_cast<IntegerType>(-static_cast<int64_t>(value - 1) - 1);
+		}
+		else
+		{
+			if (QUANTUMJSON_UNLIKELY(value > static_cast<uint64_t>(std::numeric_limits<IntegerType>::max())))
+			{
+				this->errorCode = ErrorCode::NumberOutOfRange;
+				return;
+			}
+			obj = static_cast<IntegerType>(value);
+		}
+	}
+
+	template <typename ArrayElemType, typename Allocator>
+	void ParseValueInto(std::vector<ArrayElemType, Allocator> &obj)
+	{
+		// When reusing, elements already in `obj` are parsed into in place so
+		// their buffers are kept, and new ones are only created past them.
+		size_t reusable = reuseCapacity ? obj.size() : 0;
+		if (!reuseCapacity)
+		{
+			obj.clear();
+		}
+
+		this->SkipChar('['); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		this->EnterContainer(); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		this->SkipWhitespace();
+
+		size_t count = 0;
+		while (1)
+		{
+			QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+
+			if (QUANTUMJSON_UNLIKELY(*(this->it) == ']'))
+			{
+				++this->it;
+				this->LeaveContainer();
+				if (count < obj.size())
+				{
+					obj.erase(obj.begin() + count, obj.end());
+				}
+				return;
+			}
+
+			if (count > 0)
+			{
+				this->SkipChar(','); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+				this->SkipWhitespace();
+			}
+
+			if (count < reusable)
+			{
+				if constexpr (std::is_same<ArrayElemType, bool>::value)
+				{
+					// std::vector<bool> elements can't be referenced
+					bool elem;
+					ParseValueInto(elem); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+					obj[count] = elem;
+				}
+				else
+				{
+					ParseValueInto(obj[count]); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+				}
+			}
+			else
+			{
+				ArrayElemType elem = ConstructWithAllocator<ArrayElemType>(obj.get_allocator());
+				ParseValueInto(elem); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+				obj.push_back( std::move(elem) );
+			}
+			++count;
+
+			this->SkipWhitespace();
+		}
+	}
+
+	// Lists smaller than this are parsed by the calling thread alone
+	static constexpr size_t MinParallelListSize = 64 * 1024;
+
+	// Parses a list with up to `threadCount` threads. Elements are found
+	// with `FindListElements`, and threads take turns parsing ranges of
+	// them in place. Lists that are small or not in contiguous input are
+	// parsed as usual, as are elements that can't be parsed concurrently:
+	// `std::vector<bool>` bits, and containers allocating from a memory
+	// resource or holding views into the string storage, neither of which
+	// are thread safe.
+	template <typename ArrayElemType, typename Allocator>
+	void ParseValueIntoParallel(std::vector<ArrayElemType, Allocator> &obj)
+	{
+		if constexpr (IsContiguousInput<InputIteratorType>::value
+		              && !std::is_same<ArrayElemType, bool>::value
+		              && std::is_same<Allocator, std::allocator<ArrayElemType>>::value)
+		{
+			if (threadCount > 1 && stringStorage == nullptr
+			    && this->it != this->end && *(this->it) == '[')
+			{
+				ParseListInParallel(obj);
+				return;
+			}
+		}
+		ParseValueInto(obj);
+	}
+
+	template <typename T>
+	void ParseValueIntoParallel(T &obj)
+	{
+		ParseValueInto(obj);
+	}
+
+	template <typename ArrayElemType, typename Allocator>
+	QUANTUMJSON_NOINLINE
+	void ParseListInParallel(std::vector<ArrayElemType, Allocator> &obj)
+	{
+		const InputIteratorType start = this->it;
+		const char *begin = this->ItPtr();
+
+		size_t listSize = 0;
+		std::vector<uint32_t> elements;
+		if (!FindListElements(begin, this->EndPtr(), &elements, &listSize)
+		    || listSize < MinParallelListSize || elements.size() < 2)
+		{
+			ParseValueInto(obj);
+			return;
+		}
+
+		if (!reuseCapacity)
+		{
+			obj.clear();
+		}
+		obj.resize(elements.size());
+
+		// More chunks than threads, so a thread that is done takes over the
+		// remaining work instead of waiting for slower ones
+		const size_t chunkCount = std::min(elements.size(), static_cast<size_t>(threadCount) * 8);
+		std::vector<char> chunkFailed(chunkCount, 0);
+		std::atomic<size_t> nextChunk(0);
+		std::mutex errorMutex;
+		std::exception_ptr error;
+
+		auto parseChunks = [&]()
+		{
+			for (size_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++)
+			{
+				const size_t first = elements.size() * chunk / chunkCount;
+				const size_t last = elements.size() * (chunk + 1) / chunkCount;
+
+				Parser<const char*, Trusted> parser(begin + elements[first], this->EndPtr());
+				parser.depth = this->depth + 1;
+				parser.maxDepth = this->maxDepth;
+				parser.reuseCapacity = reuseCapacity;
+
+				for (size_t i = first; i < last; ++i)
+				{
+					parser.ParseValueInto(obj[i]);
+					if (parser.errorCode != ErrorCode::NoError)
+					{
+						break;
+					}
+					parser.SkipWhitespace();
+					parser.SkipChar(i + 1 == elements.size() ? ']' : ',');
+					if (parser.errorCode != ErrorCode::NoError)
+					{
+						break;
+					}
+					parser.SkipWhitespace();
+				}
+
+				// Each chunk must end where the next one starts
+				if (parser.errorCode == ErrorCode::NoError && last < elements.size()
+				    && parser.it != begin + elements[last])
+				{
+					parser.errorCode = ErrorCode::UnexpectedChar;
+				}
+				chunkFailed[chunk] = parser.errorCode != ErrorCode::NoError;
+			}
+		};
+
+		// Stops all threads on the first exception, e.g. std::bad_alloc, to
+		// rethrow it from the calling thread
+		auto guardedParseChunks = [&]()
+		{
+			try
+			{
+				parseChunks();
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(errorMutex);
+				if (!error)
+				{
+					error = std::current_exception();
+				}
+				nextChunk = chunkCount;
+			}
+		};
+
+		std::vector<std::thread> workers;
+		for (size_t t = 1; t < std::min(static_cast<size_t>(threadCount), chunkCount); ++t)
+		{
+			try
+			{
+				workers.emplace_back(guardedParseChunks);
+			}
+			catch (const std::system_error &)
+			{
+				// Out of threads, the rest of the chunks are parsed by the
+				// threads already running
+				break;
+			}
+		}
+		guardedParseChunks();
+		for (std::thread &worker : workers)
+		{
+			worker.join();
+		}
+
+		if (error)
+		{
+			std::rethrow_exception(error);
+		}
+
+		// Invalid lists are parsed again as usual, to report the error at the
+		// same place
+		for (char failed : chunkFailed)
+		{
+			if (failed)
+			{
+				this->it = start;
+				ParseValueInto(obj);
+				return;
+			}
+		}
+		this->it += listSize;
+	}
+
+	template <typename KeyAllocator, typename MapElemType, typename Compare, typename Allocator>
+	void ParseValueInto(std::map<BasicString<KeyAllocator>, MapElemType, Compare, Allocator> &obj)
+	{
+		// When reusing, entries are moved out to `old` and nodes of keys that
+		// appear again are put back after parsing into their values in place.
+		std::map<BasicString<KeyAllocator>, MapElemType, Compare, Allocator> old(obj.get_allocator());
+		if (reuseCapacity)
+		{
+			old.swap(obj);
+		}
+		else
+		{
+			obj.clear();
+		}
+
+		this->SkipChar('{'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		this->EnterContainer(); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		this->SkipWhitespace();
+
+		BasicString<KeyAllocator> key(obj.get_allocator());
+		bool firstEntry = true;
+		while (1)
+		{
+			QUANTUMJSON_CHECK_EOF_AND_PROPAGATE;
+
+			if (QUANTUMJSON_UNLIKELY(*(this->it) == '}'))
+			{
+				++this->it;
+				this->LeaveContainer();
+				return;
+			}
+
+			if (!firstEntry)
+			{
+				this->SkipChar(','); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+				this->SkipWhitespace();
+			}
+			firstEntry = false;
+
+			ParseValueInto(key); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+			this->SkipWhitespace();
+
+			this->SkipChar(':'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+			this->SkipWhitespace();
+
+			if (reuseCapacity)
+			{
+				auto node = old.extract(key);
+				if (!node.empty())
+				{
+					ParseValueInto(node.mapped()); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+					this->SkipWhitespace();
+
+					obj.insert(std::move(node));
+					continue;
+				}
+			}
+
+			MapElemType value = ConstructWithAllocator<MapElemType>(obj.get_allocator());
+			ParseValueInto(value); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+			this->SkipWhitespace();
+
+			obj.emplace( std::move(key), std::move(value) );
+		}
+	}
+
+	template <typename ObjectType>
+	void ParseObject(ObjectType &obj)
+	{
+		this->SkipWhitespace();
+
+		this->SkipChar('{'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		this->EnterContainer(); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		this->SkipWhitespace();
+
+		if (this->it != this->end && *(this->it) != '}')
+		{
+			obj.ParseNextField(*this); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+			this->SkipWhitespace();
+		}
+
+		while (this->it != this->end && *(this->it) != '}')
+		{
+			this->SkipChar(','); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+			this->SkipWhitespace();
+
+			obj.ParseNextField(*this); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+			this->SkipWhitespace();
+		}
+
+		this->SkipChar('}'); QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE;
+		this->LeaveContainer();
+	}
+
+	template <typename ObjectType>
+	void ParseValueInto(ObjectType &obj)
+	{
+		ParseObject(obj);
+	}
+
+	// Owner of unescaped `std::string_view` values, may be null when no
+	// views are parsed
+	StringStorage *stringStorage = nullptr;
+
+	// Parse into existing vector elements and map values instead of
+	// replacing them, see `QuantumJson::ParseInto`
+	bool reuseCapacity = false;
+
+	// Threads `ParseValueIntoParallel` may use, including the calling one
+	int threadCount = 1;
+};
+
+// Runs the generated field name matchers on the keys of an indexed object.
+// Instead of parsing the value, the matched action records the field.
+struct FieldNameMatcher : InputProcessor<const char*>
+{
+	FieldNameMatcher(const char *begin, const char *end)
+	  : InputProcessor<const char*>(begin, end)
+	{
+	}
+
+	int matchedField = -1;
+};
+
+template <typename ElemType>
+class ArrayView;
+
+// What is read from a view for values parsed as `T`. Generated structs are
+// read as their `View`, lists as `ArrayView`s, and other types are decoded.
+template <typename T, typename = void>
+struct ViewOf
+{
+	using Type = T;
+	static constexpr bool isView = false;
+};
+
+template <typename T>
+struct ViewOf<T, std::void_t<typename T::View>>
+{
+	using Type = typename T::View;
+	static constexpr bool isView = true;
+};
+
+template <typename ElemType, typename Allocator>
+struct ViewOf<std::vector<ElemType, Allocator>>
+{
+	using Type = ArrayView<ElemType>;
+	static constexpr bool isView = true;
+};
+
+// Reads the value at `offset` that has escaped `std::string_view`s in it
+template <typename T>
+QUANTUMJSON_NOINLINE
+T ReadUnescapedValue(const StructuralIndex *index, uint32_t offset)
+{
+	std::lock_guard<std::mutex> lock(index->stringsMutex);
+
+	Parser<const char*> parser(index->input + offset, index->inputEnd);
+	if constexpr (std::is_same<T, std::string_view>::value)
+	{
+		auto found = index->unescapedStrings.find(offset);
+		if (found != index->unescapedStrings.end())
+		{
+			return found->second;
+		}
+
+		std::string str;
+		parser.ParseValueInto(str);
+		if (parser.errorCode != ErrorCode::NoError)
+		{
+			throw JsonError(parser.errorCode);
+		}
+		return index->unescapedStrings.emplace(offset, std::move(str)).first->second;
+	}
+	else
+	{
+		parser.stringStorage = &index->strings;
+		T val{};
+		parser.ParseValueInto(val);
+		if (parser.errorCode != ErrorCode::NoError)
+		{
+			throw JsonError(parser.errorCode);
+		}
+		return val;
+	}
+}
+
+// Reads the value at `offset` of an indexed input as `T`, `entry` being the
+// first entry at or after it. Throws `JsonError` if it is not a valid `T`.
+template <typename T>
+typename ViewOf<T>::Type ReadValue(const StructuralIndex *index, uint32_t entry,
+                                   uint32_t offset, bool skipNull)
+{
+	using ValueType = typename ViewOf<T>::Type;
+
+	Parser<const char*> parser(index->input + offset, index->inputEnd);
+
+	if (skipNull)
+	{
+		bool skipped = false;
+		parser.MaybeSkipNull(&skipped);
+		if (parser.errorCode != ErrorCode::NoError)
+		{
+			throw JsonError(parser.errorCode);
+		}
+		if (skipped)
+		{
+			return ValueType();
+		}
+	}
+
+	if constexpr (ViewOf<T>::isView)
+	{
+		if (index->input[offset] != ValueType::openBracket)
+		{
+			throw JsonError(ErrorCode::UnexpectedChar);
+		}
+		return ValueType(index, entry);
+	}
+	else
+	{
+		ValueType val{};
+		parser.ParseValueInto(val);
+		if (QUANTUMJSON_UNLIKELY(parser.errorCode == ErrorCode::MissingStringStorage))
+		{
+			return ReadUnescapedValue<T>(index, offset);
+		}
+		if (parser.errorCode != ErrorCode::NoError)
+		{
+			throw JsonError(parser.errorCode);
+		}
+		return val;
+	}
+}
+
+// Base of the generated `View` structs. Keys are matched on the first field
+// access, recording where the values of known fields are. Values are then
+// decoded, or viewed, each time their accessor is called. Fields missing in
+// the json read as default constructed values.
+template <size_t FieldCount>
+class ObjectView
+{
+public:
+	static constexpr char openBracket = '{';
+
+	ObjectView() = default;
+
+	ObjectView(const StructuralIndex *index, uint32_t entry)
+	  : index(index), entry(entry)
+	{
+	}
+
+protected:
+	template <typename T>
+	typename ViewOf<T>::Type FieldValue(size_t field, void (*matchField)(FieldNameMatcher &),
+	                                    bool skipNull) const
+	{
+		if (!scanned)
+		{
+			// Scanned again on the next access if this throws
+			Scan(matchField);
+			scanned = true;
+		}
+		if (valueOffsets[field] == 0)
+		{
+			return typename ViewOf<T>::Type();
+		}
+		return ReadValue<T>(index, valueEntries[field], valueOffsets[field], skipNull);
+	}
+
+private:
+	void Scan(void (*matchField)(FieldNameMatcher &)) const
+	{
+		valueOffsets.fill(0);
+		if (index == nullptr)
+		{
+			return;
+		}
+
+		if (index->input[index->ValueOffsetAfter(entry)] == '}')
+		{
+			return;
+		}
+
+		uint32_t e = entry + 1;
+
+		while (true)
+		{
+			if (index->CharAt(e) != '"')
+			{
+				throw JsonError(ErrorCode::UnexpectedChar);
+			}
+
+			FieldNameMatcher matcher(index->input + index->entries[e].offset, index->inputEnd);
+			matchField(matcher);
+			if (matcher.errorCode != ErrorCode::NoError)
+			{
+				throw JsonError(matcher.errorCode);
+			}
+
+			// Matchers stop at the value, which must follow the colon after
+			// the key
+			const uint32_t valueOffset = index->ValueOffsetAfter(e + 1);
+			if (index->CharAt(e + 1) != ':' || matcher.it != index->input + valueOffset)
+			{
+				throw JsonError(ErrorCode::UnexpectedChar);
+			}
+
+			if (matcher.matchedField >= 0)
+			{
+				valueOffsets[matcher.matchedField] = valueOffset;
+				valueEntries[matcher.matchedField] = e + 2;
+			}
+
+			e = index->SkipValue(e + 2, valueOffset);
+			if (index->CharAt(e) == '}')
+			{
+				return;
+			}
+			if (index->CharAt(e) != ',')
+			{
+				throw JsonError(ErrorCode::UnexpectedChar);
+			}
+			++e;
+		}
+	}
+
+	const StructuralIndex *index = nullptr;
+	uint32_t entry = 0;
+
+	mutable bool scanned = false;
+	// Zero for missing fields, values never start at the beginning
+	mutable std::array<uint32_t, FieldCount> valueOffsets;
+	mutable std::array<uint32_t, FieldCount> valueEntries;
+};
+
+// View of a json list. Elements are located on first access, and decoded,
+// or viewed, each time they are read.
+template <typename ElemType>
+class ArrayView
+{
+public:
+	static constexpr char openBracket = '[';
+
+	using value_type = typename ViewOf<ElemType>::Type;
+
+	class const_iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = typename ArrayView::value_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = value_type;
+
+		const_iterator(const ArrayView *view, size_t idx)
+		  : view(view), idx(idx)
+		{
+		}
+
+		value_type operator*() const
+		{
+			return (*view)[idx];
+		}
+
+		const_iterator& operator++()
+		{
+			++idx;
+			return *this;
+		}
+
+		bool operator==(const const_iterator &o) const
+		{
+			return idx == o.idx;
+		}
+
+		bool operator!=(const const_iterator &o) const
+		{
+			return idx != o.idx;
+		}
+
+	private:
+		const ArrayView *view;
+		size_t idx;
+	};
+
+	ArrayView() = default;
+
+	ArrayView(const StructuralIndex *index, uint32_t entry)
+	  : index(index), entry(entry)
+	{
+	}
+
+	size_t size() const
+	{
+		Scan();
+		return elements.size();
+	}
+
+	bool empty() const
+	{
+		return size() == 0;
+	}
+
+	value_type operator[](size_t idx) const
+	{
+		Scan();
+		return ReadValue<ElemType>(index, elements[idx].entry, elements[idx].offset, false);
+	}
+
+	const_iterator begin() const
+	{
+		return const_iterator(this, 0);
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(this, size());
+	}
+
+private:
+	void Scan() const
+	{
+		if (scanned)
+		{
+			return;
+		}
+		// Scanned again on the next access if this throws
+		elements.clear();
+		if (index != nullptr && !index->ListElements(entry, &elements))
+		{
+			throw JsonError(ErrorCode::UnexpectedChar);
+		}
+		scanned = true;
+	}
+
+	const StructuralIndex *index = nullptr;
+	uint32_t entry = 0;
+
+	mutable bool scanned = false;
+	mutable std::vector<StructuralIndex::Element> elements;
+};
+
+// Shortest decimal representation of doubles, using the Grisu2 algorithm
+// from Florian Loitsch, "Printing Floating-Point Numbers Quickly and
+// Accurately with Integers". Output always parses back to the same double,
+// and it is the shortest such output in all but very few cases.
+
+// Floating point number f * 2^e, with 64 bit significand
+struct DiyFp
+{
+	uint64_t f;
+	int e;
+
+	DiyFp(uint64_t f, int e)
+	  : f(f), e(e)
+	{
+	}
+
+	static DiyFp Sub(const DiyFp &x, const DiyFp &y)
+	{
+		return DiyFp(x.f - y.f, x.e);
+	}
+
+	// Returns x * y rounded to 64 bits
+	static DiyFp Mul(const DiyFp &x, const DiyFp &y)
+	{
+		uint64_t high, low;
+		FullMultiplication(x.f, y.f, &high, &low);
+		// Round, ties up
+		high += (low >> 63);
+		return DiyFp(high, x.e + y.e + 64);
+	}
+
+	static DiyFp Normalize(DiyFp x)
+	{
+		int lz = CountLeadingZeros(x.f);
+		return DiyFp(x.f << lz, x.e - lz);
+	}
+
+	static DiyFp NormalizeTo(const DiyFp &x, int targetExponent)
+	{
+		return DiyFp(x.f << (x.e - targetExponent), targetExponent);
+	}
+};
+
+// Normalized 10^k as f * 2^e, for k in [-300, 324] with steps of 8
+struct CachedPower
+{
+	uint64_t f;
+	int e;
+	int k;
+};
+
+// Returns the cached power c = 10^-k such that the binary exponent of
+// c * 2^e is in [-60, -32].
+inline
+CachedPower GetCachedPowerForBinaryExponent(int e)
+{
+	static const CachedPower cachedPowers[] = {
+		{ 0xAB70FE17C79AC6CAULL, -1060, -300 },
+		{ 0xFF77B1FCBEBCDC4FULL, -1034, -292 },
+		{ 0xBE5691EF416BD60CULL, -1007, -284 },
+		{ 0x8DD01FAD907FFC3CULL,  -980, -276 },
+		{ 0xD3515C2831559A83ULL,  -954, -268 },
+		{ 0x9D71AC8FADA6C9B5ULL,  -927, -260 },
+		{ 0xEA9C227723EE8BCBULL,  -901, -252 },
+		{ 0xAECC49914078536DULL,  -874, -244 },
+		{ 0x823C12795DB6CE57ULL,  -847, -236 },
+		{ 0xC21094364DFB5637ULL,  -821, -228 },
+		{ 0x9096EA6F3848984FULL,  -794, -220 },
+		{ 0xD77485CB25823AC7ULL,  -768, -212 },
+		{ 0xA086CFCD97BF97F4ULL,  -741, -204 },
+		{ 0xEF340A98172AACE5ULL,  -715, -196 },
+		{ 0xB23867FB2A35B28EULL,  -688, -188 },
+		{ 0x84C8D4DFD2C63F3BULL,  -661, -180 },
+		{ 0xC5DD44271AD3CDBAULL,  -635, -172 },
+		{ 0x936B9FCEBB25C996ULL,  -608, -164 },
+		{ 0xDBAC6C247D62A584ULL,  -582, -156 },
+		{ 0xA3AB66580D5FDAF6ULL,  -555, -148 },
+		{ 0xF3E2F893DEC3F126ULL,  -529, -140 },
+		{ 0xB5B5ADA8AAFF80B8ULL,  -502, -132 },
+		{ 0x87625F056C7C4A8BULL,  -475, -124 },
+		{ 0xC9BCFF6034C13053ULL,  -449, -116 },
+		{ 0x964E858C91BA2655ULL,  -422, -108 },
+		{ 0xDFF9772470297EBDULL,  -396, -100 },
+		{ 0xA6DFBD9FB8E5B88FULL,  -369,  -92 },
+		{ 0xF8A95FCF88747D94ULL,  -343,  -84 },
+		{ 0xB94470938FA89BCFULL,  -316,  -76 },
+		{ 0x8A08F0F8BF0F156BULL,  -289,  -68 },
+		{ 0xCDB02555653131B6ULL,  -263,  -60 },
+		{ 0x993FE2C6D07B7FACULL,  -236,  -52 },
+		{ 0xE45C10C42A2B3B06ULL,  -210,  -44 },
+		{ 0xAA242499697392D3ULL,  -183,  -36 },
+		{ 0xFD87B5F28300CA0EULL,  -157,  -28 },
+		{ 0xBCE5086492111AEBULL,  -130,  -20 },
+		{ 0x8CBCCC096F5088CCULL,  -103,  -12 },
+		{ 0xD1B71758E219652CULL,   -77,   -4 },
+		{ 0x9C40000000000000ULL,   -50,    4 },
+		{ 0xE8D4A51000000000ULL,   -24,   12 },
+		{ 0xAD78EBC5AC620000ULL,     3,   20 },
+		{ 0x813F3978F8940984ULL,    30,   28 },
+		{ 0xC097CE7BC90715B3ULL,    56,   36 },
+		{ 0x8F7E32CE7BEA5C70ULL,    83,   44 },
+		{ 0xD5D238A4ABE98068ULL,   109,   52 },
+		{ 0x9F4F2726179A2245ULL,   136,   60 },
+		{ 0xED63A231D4C4FB27ULL,   162,   68 },
+		{ 0xB0DE65388CC8ADA8ULL,   189,   76 },
+		{ 0x83C7088E1AAB65DBULL,   216,   84 },
+		{ 0xC45D1DF942711D9AULL,   242,   92 },
+		{ 0x924D692CA61BE758ULL,   269,  100 },
+		{ 0xDA01EE641A708DEAULL,   295,  108 },
+		{ 0xA26DA3999AEF774AULL,   322,  116 },
+		{ 0xF209787BB47D6B85ULL,   348,  124 },
+		{ 0xB454E4A179DD1877ULL,   375,  132 },
+		{ 0x865B86925B9BC5C2ULL,   402,  140 },
+		{ 0xC83553C5C8965D3DULL,   428,  148 },
+		{ 0x952AB45CFA97A0B3ULL,   455,  156 },
+		{ 0xDE469FBD99A05FE3ULL,   481,  164 },
+		{ 0xA59BC234DB398C25ULL,   508,  172 },
+		{ 0xF6C69A72A3989F5CULL,   534,  180 },
+		{ 0xB7DCBF5354E9BECEULL,   561,  188 },
+		{ 0x88FCF317F22241E2ULL,   588,  196 },
+		{ 0xCC20CE9BD35C78A5ULL,   614,  204 },
+		{ 0x98165AF37B2153DFULL,   641,  212 },
+		{ 0xE2A0B5DC971F303AULL,   667,  220 },
+		{ 0xA8D9D1535CE3B396ULL,   694,  228 },
+		{ 0xFB9B7CD9A4A7443CULL,   720,  236 },
+		{ 0xBB764C4CA7A44410ULL,   747,  244 },
+		{ 0x8BAB8EEFB6409C1AULL,   774,  252 },
+		{ 0xD01FEF10A657842CULL,   800,  260 },
+		{ 0x9B10A4E5E9913129ULL,   827,  268 },
+		{ 0xE7109BFBA19C0C9DULL,   853,  276 },
+		{ 0xAC2820D9623BF429ULL,   880,  284 },
+		{ 0x80444B5E7AA7CF85ULL,   907,  292 },
+		{ 0xBF21E44003ACDD2DULL,   933,  300 },
+		{ 0x8E679C2F5E44FF8FULL,   960,  308 },
+		{ 0xD433179D9C8CB841ULL,   986,  316 },
+		{ 0x9E19DB92B4E31BA9ULL,  1013,  324 },
+	};
+
+	const int alpha = -60;
+	const int minDecimalExponent = -300;
+	const int decimalExponentStep = 8;
+
+	// ceil(log10(2^(alpha - e - 1)))
+	int f = alpha - e - 1;
+	int k = (f * 78913) / (1 << 18) + static_cast<int>(f > 0);
+	int index = (-minDecimalExponent + k + (decimalExponentStep - 1)) / decimalExponentStep;
+	return cachedPowers[index];
+}
+
+// Moves the last digit of buf closer to the exact value while the result
+// is still in the rounding interval
+inline
+void Grisu2Round(char *buf, int len, uint64_t dist, uint64_t delta, uint64_t rest, uint64_t tenK)
+{
+	while (rest < dist && delta - rest >= tenK
+	       && (rest + tenK < dist || dist - rest > rest + tenK - dist))
+	{
+		--buf[len - 1];
+		rest += tenK;
+	}
+}
+
+// Generates the shortest digits of w in (mMinus, mPlus), the value is
+// digits * 10^decimalExponent
+inline
+void Grisu2DigitGen(char *buf, int *len, int *decimalExponent,
+                    DiyFp mMinus, DiyFp w, DiyFp mPlus)
+{
+	static const uint32_t powersOfTen[] = {
+		1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+	};
+
+	uint64_t delta = DiyFp::Sub(mPlus, mMinus).f;
+	uint64_t dist = DiyFp::Sub(mPlus, w).f;
+
+	const DiyFp one(uint64_t(1) << -mPlus.e, mPlus.e);
+
+	uint32_t p1 = static_cast<uint32_t>(mPlus.f >> -one.e);
+	uint64_t p2 = mPlus.f & (one.f - 1);
+
+	// Integral part
+	int n = 10;
+	while (n > 1 && p1 < powersOfTen[n - 1])
+	{
+		--n;
+	}
+
+	while (n > 0)
+	{
+		uint32_t pow10 = powersOfTen[n - 1];
+		uint32_t d = p1 / pow10;
+		p1 %= pow10;
+		buf[(*len)++] = static_cast<char>('0' + d);
+		--n;
+
+		uint64_t rest = (static_cast<uint64_t>(p1) << -one.e) + p2;
+		if (rest <= delta)
+		{
+			*decimalExponent += n;
+			Grisu2Round(buf, *len, dist, delta, rest, static_cast<uint64_t>(pow10) << -one.e);
+			return;
+		}
+	}
+
+	// Fractional part
+	int m = 0;
+	while (1)
+	{
+		p2 *= 10;
+		uint64_t d = p2 >> -one.e;
+		p2 &= one.f - 1;
+		buf[(*len)++] = static_cast<char>('0' + d);
+		++m;
+
+		delta *= 10;
+		dist *= 10;
+		if (p2 <= delta)
+		{
+			break;
+		}
+	}
+
+	*decimalExponent -= m;
+	Grisu2Round(buf, *len, dist, delta, p2, one.f);
+}
+
+// Writes the shortest digits of a finite positive double into buf, and
+// returns the number of digits. The value is digits * 10^decimalExponent.
+inline
+int Grisu2(double value, char *buf, int *decimalExponent)
+{
+	const int bias = 1023 + 52;
+	const uint64_t hiddenBit = uint64_t(1) << 52;
+
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	int biasedExponent = static_cast<int>(bits >> 52);
+	uint64_t fraction = bits & (hiddenBit - 1);
+
+	DiyFp v = biasedExponent == 0
+	    ? DiyFp(fraction, 1 - bias)
+	    : DiyFp(fraction + hiddenBit, biasedExponent - bias);
+
+	// Boundaries are halfway to the neighbouring doubles, the lower one
+	// is closer on powers of two
+	bool lowerBoundaryIsCloser = (fraction == 0 && biasedExponent > 1);
+	DiyFp mPlus = DiyFp::Normalize(DiyFp(2 * v.f + 1, v.e - 1));
+	DiyFp mMinus = DiyFp::NormalizeTo(lowerBoundaryIsCloser
+	    ? DiyFp(4 * v.f - 1, v.e - 2)
+	    : DiyFp(2 * v.f - 1, v.e - 1), mPlus.e);
+	v = DiyFp::Normalize(v);
+
+	CachedPower cached = GetCachedPowerForBinaryExponent(mPlus.e);
+	DiyFp c(cached.f, cached.e);
+
+	DiyFp w = DiyFp::Mul(v, c);
+	DiyFp wMinus = DiyFp::Mul(mMinus, c);
+	DiyFp wPlus = DiyFp::Mul(mPlus, c);
+
+	// Products are off by at most one ulp, shrink the interval to be safe
+	int len = 0;
+	*decimalExponent = -cached.k;
+	Grisu2DigitGen(buf, &len, decimalExponent,
+	               DiyFp(wMinus.f + 1, wMinus.e), w, DiyFp(wPlus.f - 1, wPlus.e));
+	return len;
+}
+
+// Writes the shortest representation of a finite double into buf, which
+// must have space for 32 characters, and returns the end of output. Like
+// JavaScript, exponent notation is only used for values below 1e-6 or from
+// 1e21 on.
+inline
+char* FormatShortestDouble(double value, char *buf)
+{
+	if (std::signbit(value))
+	{
+		*(buf++) = '-';
+		value = -value;
+	}
+
+	if (value == 0)
+	{
+		*(buf++) = '0';
+		return buf;
+	}
+
+	int decimalExponent;
+	int k = Grisu2(value, buf, &decimalExponent);
+	// Position of the decimal point relative to the digits
+	int n = k + decimalExponent;
+
+	if (k <= n && n <= 21)
+	{
+		// digits000
+		memset(buf + k, '0', n - k);
+		return buf + n;
+	}
+
+	if (0 < n && n <= 21)
+	{
+		// dig.its
+		memmove(buf + n + 1, buf + n, k - n);
+		buf[n] = '.';
+		return buf + k + 1;
+	}
+
+	if (-6 < n && n <= 0)
+	{
+		// 0.000digits
+		memmove(buf + 2 - n, buf, k);
+		buf[0] = '0';
+		buf[1] = '.';
+		memset(buf + 2, '0', -n);
+		return buf + 2 - n + k;
+	}
+
+	// d.igitse+XX
+	if (k > 1)
+	{
+		memmove(buf + 2, buf + 1, k - 1);
+		buf[1] = '.';
+		buf += k + 1;
+	}
+	else
+	{
+		buf += 1;
+	}
+
+	int exponent = n - 1;
+	*(buf++) = 'e';
+	*(buf++) = exponent < 0 ? '-' : '+';
+	exponent = exponent < 0 ? -exponent : exponent;
+	if (exponent >= 100)
+	{
+		*(buf++) = static_cast<char>('0' + exponent / 100);
+		exponent %= 100;
+		*(buf++) = static_cast<char>('0' + exponent / 10);
+	}
+	else if (exponent >= 10)
+	{
+		*(buf++) = static_cast<char>('0' + exponent / 10);
+	}
+	*(buf++) = static_cast<char>('0' + exponent % 10);
+	return buf;
+}
+
+// Writes `value` with `precision` significant digits into buf, like %g but
+// with a '.' decimal point whatever the locale is. Returns the end of the
+// output, which needs up to 24 bytes.
+inline
+char* FormatDoubleWithPrecision(double value, int precision, char *buf, size_t size)
+{
+	// 17 digits are enough for any double to read back the same, more only
+	// spell out its binary expansion
+	precision = std::min(precision, 17);
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+	// Correctly rounded from the exact value, and locale independent
+	auto res = std::to_chars(buf, buf + size, value, std::chars_format::general, precision);
+	if (QUANTUMJSON_LIKELY(res.ec == std::errc()))
+	{
+		return res.ptr;
+	}
+#endif
+
+	char *end = buf + snprintf(buf, size, "%.*g", precision, value);
+	for (char *p = buf; p != end; ++p)
+	{
+		// Decimal point of the C locale in use
+		if ((*p < '0' || *p > '9') && *p != '-' && *p != '+' && *p != 'e')
+		{
+			*p = '.';
+		}
+	}
+	return end;
+}
+
+// Serializer output that writes straight into a std::string. The string is
+// grown in large chunks and only trimmed to the written length by `Finish`,
+// so field names and numbers are copied with memcpy instead of being pushed
+// back one character at a time.
+struct StringOutputBuffer
+{
+	static constexpr size_t ChunkSize = 4096;
+
+	explicit StringOutputBuffer(std::string *str)
+	  : str(str)
+	  , used(str->size())
+	{
+	}
+
+	// Makes sure at least `n` more bytes can be written
+	void Ensure(size_t n)
+	{
+		if (QUANTUMJSON_UNLIKELY(str->size() - used < n))
+		{
+			Grow(n);
+		}
+	}
+
+	void Put(char c)
+	{
+		Ensure(1);
+		(*str)[used++] = c;
+	}
+
+	void Write(const char *data, size_t len)
+	{
+		Ensure(len);
+		memcpy(&(*str)[used], data, len);
+		used += len;
+	}
+
+	// Drops the unused tail of the last chunk
+	void Finish()
+	{
+		str->resize(used);
+	}
+
+	std::string *str;
+	size_t used;
+
+private:
+	QUANTUMJSON_NOINLINE
+	void Grow(size_t n)
+	{
+		str->resize(std::max(used + n + ChunkSize, str->size() * 2));
+	}
+};
+
+template <typename OutputIteratorType>
+struct Serializer
+{
+	Serializer(OutputIteratorType out)
+	  : out(out)
+	{
+	}
+
+	void Put(char c)
+	{
+		if constexpr (std::is_same<OutputIteratorType, StringOutputBuffer>::value)
+		{
+			out.Put(c);
+		}
+		else
+		{
+			*(out++) = c;
+		}
+	}
+
+	void Write(const char *data, size_t len)
+	{
+		if constexpr (std::is_same<OutputIteratorType, StringOutputBuffer>::value)
+		{
+			out.Write(data, len);
+		}
+		else
+		{
+			for (size_t i = 0; i < len; ++i)
+			{
+				*(out++) = data[i];
+			}
+		}
+	}
+
+	// Writes a string literal, length is known at compile time so the copy
+	// is reduced to a few stores. Used by generated code for field names.
+	template <size_t N>
+	void WriteLiteral(const char (&literal)[N])
+	{
+		Write(literal, N - 1);
+	}
+
+	void SerializeValue(bool b)
+	{
+		if (b)
+		{
+			WriteLiteral("true");
+		}
+		else
+		{
+			WriteLiteral("false");
+		}
+	}
+
+	// Integers are serialized from all integral types via this overload set,
+	// so aliases like int64_t and uint32_t resolve to one of them.
+	void SerializeValue(int a)                { SerializeSigned(a); }
+	void SerializeValue(unsigned a)           { SerializeUnsigned(a); }
+	void SerializeValue(long a)               { SerializeSigned(a); }
+	void SerializeValue(unsigned long a)      { SerializeUnsigned(a); }
+	void SerializeValue(long long a)          { SerializeSigned(a); }
+	void SerializeValue(unsigned long long a) { SerializeUnsigned(a); }
+
+	void SerializeSigned(int64_t a)
+	{
+		// Enought to hold -9223372036854775807 (int64 min)
+		char buf[21];
+		int len = sprintf(buf, "%" PRId64, a);
+
+		Write(buf, len);
+	}
+
+	void SerializeUnsigned(uint64_t a)
+	{
+		// Enought to hold 18446744073709551615 (uint64 max)
+		char buf[21];
+		int len = sprintf(buf, "%" PRIu64, a);
+
+		Write(buf, len);
+	}
+
+	void SerializeValue(double num)
+	{
+		if (std::isnan(num) || std::isinf(num))
+		{
+			WriteLiteral("null");
+			return;
+		}
+
+		char buf[32];
+		const char *bufEnd;
+		if (QUANTUMJSON_LIKELY(doublePrecision == 0))
+		{
+			bufEnd = FormatShortestDouble(num, buf);
+		}
+		else
+		{
+			bufEnd = FormatDoubleWithPrecision(num, doublePrecision, buf, sizeof(buf));
+		}
+
+		Write(buf, bufEnd - buf);
+	}
+
+	template <typename Allocator>
+	void SerializeValue(const BasicString<Allocator> &s)
+	{
+		SerializeValue(std::string_view(s));
+	}
+
+	// Input should be a valit UTF-8 string
+	void SerializeValue(std::string_view s)
+	{
+		Put('"');
+
+		const char *p = s.data();
+		const char *end = p + s.size();
+		while (p != end)
+		{
+			// Copy the run that needs no escaping at once
+			size_t runLength = escapeNonAscii ? PlainStringRunLength(p, end)
+			                                  : EscapeFreeRunLength(p, end);
+			Write(p, runLength);
+			p += runLength;
+
+			if (p != end)
+			{
+				p = SerializeEscaped(p, end);
+			}
+		}
+
+		Put('"');
+	}
+
+	// Writes the escaped form of the character at `p`, returns the position
+	// after it.
+	const char* SerializeEscaped(const char *p, const char *end)
+	{
+		switch (*p)
+		{
+		case '"':
+			WriteLiteral("\\\"");
+			return p + 1;
+		case '\\':
+			WriteLiteral("\\\\");
+			return p + 1;
+		case '\b':
+			WriteLiteral("\\b");
+			return p + 1;
+		case '\f':
+			WriteLiteral("\\f");
+			return p + 1;
+		case '\n':
+			WriteLiteral("\\n");
+			return p + 1;
+		case '\r':
+			WriteLiteral("\\r");
+			return p + 1;
+		case '\t':
+			WriteLiteral("\\t");
+			return p + 1;
+		}
+
+		if (static_cast<unsigned char>(*p) < 0x20)
+		{
+			SerializeUnicodeEscape(static_cast<unsigned char>(*p));
+			return p + 1;
+		}
+
+		// Only non-ASCII characters are left, when `escapeNonAscii` is set
+		uint32_t codePoint;
+		size_t len = DecodeUtf8(p, end, &codePoint);
+		if (len == 0)
+		{
+			// Malformed input, write replacement character for the byte
+			SerializeUnicodeEscape(0xfffd);
+			return p + 1;
+		}
+
+		if (codePoint >= 0x10000)
+		{
+			codePoint -= 0x10000;
+			SerializeUnicodeEscape(0xd800 | (codePoint >> 10));
+			SerializeUnicodeEscape(0xdc00 | (codePoint & 0x3ff));
+		}
+		else
+		{
+			SerializeUnicodeEscape(codePoint);
+		}
+		return p + len;
+	}
+
+	// Writes \uXXXX for a code point in the basic multilingual plane
+	void SerializeUnicodeEscape(uint32_t codePoint)
+	{
+		static const char hexDigits[] = "0123456789abcdef";
+		char buf[6] = { '\\', 'u',
+		                hexDigits[(codePoint >> 12) & 0xf],
+		                hexDigits[(codePoint >> 8) & 0xf],
+		                hexDigits[(codePoint >> 4) & 0xf],
+		                hexDigits[codePoint & 0xf] };
+		Write(buf, sizeof(buf));
+	}
+
+	template <typename ObjectType>
+	void SerializeValue(const ObjectType &obj)
+	{
+		obj.SerializeTo(*this);
+	}
+
+	template <typename ArrayElemType, typename Allocator>
+	void SerializeValue(const std::vector<ArrayElemType, Allocator> &obj)
+	{
+		Put('[');
+
+		for (size_t i = 0; i < obj.size(); ++i)
+		{
+			if (i > 0)
+			{
+				Put(',');
+			}
+
+			this->SerializeValue(obj[i]);
+		}
+
+		Put(']');
+	}
+
+	template <typename KeyAllocator, typename MapElemType, typename Compare, typename Allocator>
+	void SerializeValue(const std::map<BasicString<KeyAllocator>, MapElemType, Compare, Allocator> &obj)
+	{
+		Put('{');
+
+		bool firstEntry = true;
+		for (const auto &it : obj)
+		{
+			if (!firstEntry)
+			{
+				Put(',');
+			}
+			firstEntry = false;
+
+			this->SerializeValue(it.first);
+			Put(':');
+			this->SerializeValue(it.second);
+		}
+
+		Put('}');
+	}
+
+	OutputIteratorType out;
+
+	// See `QuantumJson::SerializeOptions`
+	int doublePrecision = 0;
+	bool escapeNonAscii = false;
+};
+
+
+// Json lines input is split into batches of about this many bytes, each
+// parsed by a single thread
+static constexpr size_t LineBatchSize = 256 * 1024;
+
+// Returns the end of the line at `begin`, excluding the newline. Json
+// can't have raw newlines in strings, so the first one ends the value.
+inline
+const char* LineEnd(const char *begin, const char *end)
+{
+	const void *newline = memchr(begin, '\n', end - begin);
+	return newline != nullptr ? static_cast<const char*>(newline) : end;
+}
+
+inline
+const char* NextLine(const char *lineEnd, const char *end)
+{
+	return lineEnd == end ? end : lineEnd + 1;
+}
+
+inline
+bool IsBlankLine(const char *begin, const char *end)
+{
+	return WhitespaceRunLength(begin, end) == static_cast<size_t>(end - begin);
+}
+
+// Parses a line holding a single value, with optional whitespace around it
+// such as the '\r' of "\r\n" line ends
+template <typename JsonType>
+ErrorCode ParseLine(const char *begin, const char *end, int maxDepth, JsonType &value)
+{
+	Parser<const char*> parser(begin, end);
+	parser.maxDepth = maxDepth;
+	parser.SkipWhitespace();
+	parser.ParseValueInto(value);
+	if (parser.errorCode != ErrorCode::NoError)
+	{
+		return parser.errorCode;
+	}
+
+	parser.SkipWhitespace();
+	return parser.it == end ? ErrorCode::NoError : ErrorCode::UnexpectedChar;
+}
+
+// Lines parsed by one thread, kept until they are passed to the callbacks
+template <typename JsonType>
+struct LineBatch
+{
+	void Parse(int maxDepth)
+	{
+		values.clear();
+		valueLines.clear();
+		errors.clear();
+
+		size_t line = firstLine;
+		for (const char *lineBegin = begin; lineBegin < end; ++line)
+		{
+			const char *lineEnd = LineEnd(lineBegin, end);
+			if (!IsBlankLine(lineBegin, lineEnd))
+			{
+				values.emplace_back();
+				ErrorCode errorCode = ParseLine(lineBegin, lineEnd, maxDepth, values.back());
+				if (errorCode == ErrorCode::NoError)
+				{
+					valueLines.push_back(line);
+				}
+				else
+				{
+					values.pop_back();
+					errors.emplace_back(line, errorCode);
+				}
+			}
+			lineBegin = NextLine(lineEnd, end);
+		}
+	}
+
+	// Calls `onValue(line, value)` and `onError(line, error)` in line order
+	template <typename ValueCallback, typename ErrorCallback>
+	void Deliver(ValueCallback &onValue, ErrorCallback &onError)
+	{
+		size_t e = 0;
+		for (size_t v = 0; v < values.size(); ++v)
+		{
+			for (; e < errors.size() && errors[e].first < valueLines[v]; ++e)
+			{
+				onError(errors[e].first, JsonError(errors[e].second));
+			}
+			onValue(valueLines[v], values[v]);
+		}
+		for (; e < errors.size(); ++e)
+		{
+			onError(errors[e].first, JsonError(errors[e].second));
+		}
+	}
+
+	const char *begin = nullptr;
+	const char *end = nullptr;
+	// Number of the first line, counting from 1
+	size_t firstLine = 0;
+
+	std::vector<JsonType> values;
+	std::vector<size_t> valueLines;
+	std::vector<std::pair<size_t, ErrorCode>> errors;
+};
+
+}  // namespace QuantumJsonImpl__
+
+#undef QUANTUMJSON_CHECK_ERROR_AND_PROPAGATE
+#undef QUANTUMJSON_CHECK_EOF_AND_PROPAGATE
+
+// Public API is defined here
+namespace QuantumJson
+{
+	// Parse policy that scans the input once to compute string and vector
+	// sizes, reserves them, then parses into the presized containers so
+	// nothing grows while parsing. Only applies to random access inputs,
+	// others are parsed in a single pass.
+	//
+	// Listing l = QuantumJson::Parse<QuantumJson::Preallocate>(json);
+	struct Preallocate {};
+
+	// Parse policy for json known to be valid, e.g. produced by our own
+	// services. Strings are copied up to the next quote or escape without
+	// rejecting control characters or validating UTF-8, and literals and
+	// skipped scalars are not checked character by character. Invalid input
+	// is not reported and parses into unspecified values, though it is never
+	// read past its end.
+	//
+	// Listing l = QuantumJson::Parse<QuantumJson::Trusted>(json);
+	struct Trusted {};
+
+	// Json in a buffer that has at least `Padding` readable bytes after
+	// `size`, e.g. a receive buffer allocated with some slack. Contents of
+	// the padding do not matter. Parsing it skips most end of input checks
+	// and loads input in blocks without handling the tail separately. The
+	// buffer is not copied, it must outlive the parse.
+	//
+	// std::vector<char> buf(len + QuantumJson::PaddedInput::Padding);
+	// ... read len bytes into buf ...
+	// Listing l = QuantumJson::Parse(QuantumJson::PaddedInput(buf.data(), len));
+	struct PaddedInput
+	{
+		static constexpr size_t Padding = QuantumJsonImpl__::InputPadding;
+
+		PaddedInput(const char *data, size_t size)
+		  : data(data), size(size)
+		{
+		}
+
+		QuantumJsonImpl__::PaddedIterator begin() const
+		{
+			return QuantumJsonImpl__::PaddedIterator(data);
+		}
+
+		QuantumJsonImpl__::PaddedIterator end() const
+		{
+			return QuantumJsonImpl__::PaddedIterator(data + size);
+		}
+
+		const char *data;
+		size_t size;
+	};
+
+	// A file mapped into memory, so it can be parsed without copying it. A
+	// readable page follows the contents, making them a valid
+	// `PaddedInput`. Files that can't be mapped, e.g. pipes, are read into
+	// a buffer instead. Throws `std::system_error` if the file can't be
+	// read. The file must not be truncated while mapped.
+	//
+	// QuantumJson::MappedFile file("dump.json");
+	// Listing l = QuantumJson::Parse(file.Input());
+	class MappedFile
+	{
+	public:
+		explicit MappedFile(const std::string &path)
+		{
+			const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd < 0)
+			{
+				throw std::system_error(errno, std::generic_category(), path);
+			}
+
+			try
+			{
+				struct stat st;
+				if (fstat(fd, &st) != 0)
+				{
+					throw std::system_error(errno, std::generic_category(), path);
+				}
+
+				if (S_ISREG(st.st_mode) && st.st_size > 0)
+				{
+					Map(fd, static_cast<size_t>(st.st_size), path);
+				}
+				else
+				{
+					Read(fd, path);
+				}
+			}
+			catch (...)
+			{
+				close(fd);
+				throw;
+			}
+			close(fd);
+		}
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		~MappedFile()
+		{
+			if (mapping != nullptr)
+			{
+				munmap(mapping, mappingSize);
+			}
+		}
+
+		const char* Data() const
+		{
+			return data;
+		}
+
+		size_t Size() const
+		{
+			return size;
+		}
+
+		PaddedInput Input() const
+		{
+			return PaddedInput(data, size);
+		}
+
+	private:
+		void Map(int fd, size_t fileSize, const std::string &path)
+		{
+			// Reserve an extra page, so reading padding past the end of the
+			// file doesn't fault even when it ends at a page boundary
+			const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+			const size_t reservedSize = (fileSize + pageSize - 1) / pageSize * pageSize + pageSize;
+			void *base = mmap(nullptr, reservedSize, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (base == MAP_FAILED)
+			{
+				throw std::system_error(errno, std::generic_category(), path);
+			}
+			if (mmap(base, fileSize, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED)
+			{
+				const int error = errno;
+				munmap(base, reservedSize);
+				throw std::system_error(error, std::generic_category(), path);
+			}
+
+			// Only hints, failures are ignored
+			madvise(base, fileSize, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+			if (fileSize >= 2 * 1024 * 1024)
+			{
+				madvise(base, fileSize, MADV_HUGEPAGE);
+			}
+#endif
+
+			mapping = base;
+			mappingSize = reservedSize;
+			data = static_cast<const char*>(base);
+			size = fileSize;
+		}
+
+		void Read(int fd, const std::string &path)
+		{
+			size_t readSize = 0;
+			buffer.resize(64 * 1024);
+			while (1)
+			{
+				if (buffer.size() - readSize <= PaddedInput::Padding)
+				{
+					buffer.resize(buffer.size() * 2);
+				}
+
+				const ssize_t n = read(fd, buffer.data() + readSize, buffer.size() - readSize - PaddedInput::Padding);
+				if (n == 0)
+				{
+					break;
+				}
+				if (n < 0)
+				{
+					if (errno == EINTR)
+					{
+						continue;
+					}
+					throw std::system_error(errno, std::generic_category(), path);
+				}
+				readSize += static_cast<size_t>(n);
+			}
+
+			data = buffer.data();
+			size = readSize;
+		}
+
+		void *mapping = nullptr;
+		size_t mappingSize = 0;
+		std::vector<char> buffer;
+
+		const char *data = nullptr;
+		size_t size = 0;
+	};
+
+	// Json read from a file descriptor, such as stdin or a pipe, in chunks
+	// that are parsed as they're read. Runs of string characters and
+	// whitespace are still scanned in blocks within each chunk. With
+	// `ReadAhead`, a thread reads the next chunk while one is parsed.
+	// Read errors are thrown as `std::system_error`. Can be parsed once.
+	// The descriptor is not closed, and must stay open until this is
+	// destroyed.
+	//
+	// QuantumJson::FdInput input(STDIN_FILENO);
+	// Listing l = QuantumJson::Parse(input.ReadAhead());
+	class FdInput
+	{
+	public:
+		static constexpr size_t DefaultChunkSize = 64 * 1024;
+
+		explicit FdInput(int fd, size_t chunkSize = DefaultChunkSize)
+		  : fd(fd), chunkSize(chunkSize)
+		{
+		}
+
+		FdInput(const FdInput&) = delete;
+		FdInput& operator=(const FdInput&) = delete;
+
+		~FdInput()
+		{
+			if (queue)
+			{
+				// Wakes the reader if it's waiting for more input of an
+				// unfinished stream
+				queue->Stop();
+				fdReader->Stop();
+				reader.join();
+			}
+		}
+
+		// Reads ahead on a thread of its own, so reading overlaps with
+		// parsing. Up to two chunks are buffered.
+		FdInput& ReadAhead()
+		{
+			if (!queue)
+			{
+				fdReader.reset(new QuantumJsonImpl__::StoppableFdReader(fd));
+				queue.reset(new QuantumJsonImpl__::ChunkQueue());
+				queue->maxBuffered = chunkSize;
+				reader = std::thread([queue = queue.get(), fdReader = fdReader.get(), chunkSize = chunkSize]()
+				{
+					try
+					{
+						while (1)
+						{
+							std::string chunk = queue->TakeSpare();
+							chunk.resize(chunkSize);
+							chunk.resize(fdReader->Read(&chunk[0], chunkSize));
+							if (chunk.empty())
+							{
+								queue->Close();
+								return;
+							}
+							if (!queue->Push(std::move(chunk)))
+							{
+								return;
+							}
+						}
+					}
+					catch (...)
+					{
+						queue->Fail(std::current_exception());
+					}
+				});
+			}
+			return *this;
+		}
+
+		// Starts reading, the first chunk is read by the time it returns
+		QuantumJsonImpl__::ChunkIterator begin()
+		{
+			if (queue)
+			{
+				return QuantumJsonImpl__::ChunkIterator(queue.get());
+			}
+			source.reset(new QuantumJsonImpl__::FdChunkSource(fd, chunkSize));
+			return QuantumJsonImpl__::ChunkIterator(source.get());
+		}
+
+		QuantumJsonImpl__::ChunkIterator end() const
+		{
+			return QuantumJsonImpl__::ChunkIterator();
+		}
+
+	private:
+		int fd;
+		size_t chunkSize;
+		std::unique_ptr<QuantumJsonImpl__::FdChunkSource> source;
+
+		std::unique_ptr<QuantumJsonImpl__::StoppableFdReader> fdReader;
+		std::unique_ptr<QuantumJsonImpl__::ChunkQueue> queue;
+		std::thread reader;
+	};
+
+#if defined(QUANTUMJSON_WITH_ZLIB) || defined(QUANTUMJSON_WITH_ZSTD)
+	// Compressed json, decompressed on a thread of its own and parsed in
+	// chunks as they're decompressed, so the whole decompressed document is
+	// never held in memory and decompression overlaps with parsing. Chunks
+	// are handed over through a queue of up to two, whose memory is reused.
+	// Gzip needs QUANTUMJSON_WITH_ZLIB defined, zstd QUANTUMJSON_WITH_ZSTD.
+	// Invalid or truncated compressed data is thrown as
+	// `std::runtime_error`, read errors as `std::system_error`. Can be
+	// parsed once.
+	//
+	// QuantumJson::DecompressingInput input(fd, QuantumJson::DecompressingInput::Gzip);
+	// Listing l = QuantumJson::Parse(input);
+	class DecompressingInput
+	{
+	public:
+		enum Format
+		{
+			Gzip,
+			Zstd,
+		};
+
+		static constexpr size_t DefaultChunkSize = 64 * 1024;
+
+		// Reads the compressed data from `fd`, which is not closed and must
+		// stay open until this is destroyed
+		DecompressingInput(int fd, Format format, size_t chunkSize = DefaultChunkSize)
+		  : queue(new QuantumJsonImpl__::ChunkQueue()),
+		    fdReader(new QuantumJsonImpl__::StoppableFdReader(fd))
+		{
+			auto buffer = std::make_shared<std::vector<char>>(chunkSize);
+			Start(format, chunkSize, [fdReader = fdReader.get(), buffer](const char **block)
+			{
+				*block = buffer->data();
+				return fdReader->Read(buffer->data(), buffer->size());
+			});
+		}
+
+		// Decompresses `size` bytes at `data`, which must outlive the parse
+		DecompressingInput(const char *data, size_t size, Format format, size_t chunkSize = DefaultChunkSize)
+		  : queue(new QuantumJsonImpl__::ChunkQueue())
+		{
+			Start(format, chunkSize, [data, size, done = false](const char **block) mutable
+			{
+				*block = data;
+				const size_t n = done ? 0 : size;
+				done = true;
+				return n;
+			});
+		}
+
+		DecompressingInput(const DecompressingInput&) = delete;
+		DecompressingInput& operator=(const DecompressingInput&) = delete;
+
+		~DecompressingInput()
+		{
+			queue->Stop();
+			if (fdReader)
+			{
+				fdReader->Stop();
+			}
+			reader.join();
+		}
+
+		QuantumJsonImpl__::ChunkIterator begin()
+		{
+			return QuantumJsonImpl__::ChunkIterator(queue.get());
+		}
+
+		QuantumJsonImpl__::ChunkIterator end() const
+		{
+			return QuantumJsonImpl__::ChunkIterator();
+		}
+
+	private:
+		template <typename ReadFunction>
+		void Start(Format format, size_t chunkSize, ReadFunction read)
+		{
+			queue->maxBuffered = chunkSize * 2;
+			switch (format)
+			{
+#ifdef QUANTUMJSON_WITH_ZLIB
+			case Gzip:
+				reader = std::thread([queue = queue.get(), read, chunkSize]()
+				{
+					QuantumJsonImpl__::DecompressInto<QuantumJsonImpl__::GzipDecoder>(*queue, read, chunkSize);
+				});
+				return;
+#endif
+#ifdef QUANTUMJSON_WITH_ZSTD
+			case Zstd:
+				reader = std::thread([queue = queue.get(), read, chunkSize]()
+				{
+					QuantumJsonImpl__::DecompressInto<QuantumJsonImpl__::ZstdDecoder>(*queue, read, chunkSize);
+				});
+				return;
+#endif
+			default:
+				throw std::invalid_argument(format == Gzip ? "gzip input needs QUANTUMJSON_WITH_ZLIB"
+				                                           : "zstd input needs QUANTUMJSON_WITH_ZSTD");
+			}
+		}
+
+		std::unique_ptr<QuantumJsonImpl__::ChunkQueue> queue;
+		std::unique_ptr<QuantumJsonImpl__::StoppableFdReader> fdReader;
+		std::thread reader;
+	};
+#endif
+
+	// Helper struct to get retrun type polymorphism
+	// TODO FIXME Proxy not working with operator=
+	// Object o = QuantumJson::Parse(..); // works
+	// Object o; o = QuantumJson::Parse(..); // does not work
+	template<typename InputIteratorType, typename Policy = void>
+	struct ParserProxy
+	{
+		// TODO hide constructors so this couln't be created by the user
+		ParserProxy(InputIteratorType begin, InputIteratorType end,
+		            QuantumJsonImpl__::StringStorage *stringStorage = nullptr,
+		            std::pmr::memory_resource *memoryResource = nullptr)
+		  : begin(begin), end(end), stringStorage(stringStorage), memoryResource(memoryResource)
+		{
+		}
+
+		// Parses the json as type T
+		//
+		// Following does the expected thing
+		// vector<int> v = QuantumJson::Parse("[10, 20]");
+		// Following throws parse exception
+		// string s = QuantumJson::Parse("[10, 20]");
+		template <typename JsonType>
+		operator JsonType ()
+		{
+			// Types generated with `jc --pmr` allocate from the given
+			// memory resource
+			if constexpr (std::uses_allocator<JsonType, std::pmr::polymorphic_allocator<char>>::value)
+			{
+				if (memoryResource != nullptr)
+				{
+					return ParseAs(JsonType(std::pmr::polymorphic_allocator<char>(memoryResource)));
+				}
+			}
+
+			return ParseAs(JsonType());
+		}
+
+		// Overrides `QUANTUMJSON_MAX_DEPTH` for this parse
+		//
+		// Tree t = QuantumJson::Parse(json).MaxDepth(64);
+		ParserProxy& MaxDepth(int depth)
+		{
+			maxDepth = depth;
+			return *this;
+		}
+
+		// Parses large lists with up to `count` threads, or one per core when
+		// `count` is 0. Applies to a list being parsed, and to vector fields
+		// marked `[[ parallel ]]` in the schema.
+		//
+		// std::vector<Accident> a = QuantumJson::Parse(json).Threads(0);
+		ParserProxy& Threads(int count)
+		{
+			threadCount = count > 0 ? count : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+			return *this;
+		}
+
+	private:
+		template <typename JsonType>
+		JsonType ParseAs(JsonType val)
+		{
+			QuantumJsonImpl__::Parser<InputIteratorType, std::is_same<Policy, Trusted>::value> parser(begin, end);
+			parser.stringStorage = stringStorage;
+			parser.maxDepth = maxDepth;
+			parser.threadCount = threadCount;
+
+			if constexpr (std::is_same<Policy, Preallocate>::value &&
+			              QuantumJsonImpl__::IsRandomAccessIterator<InputIteratorType>::value)
+			{
+				QuantumJsonImpl__::PreAllocator<InputIteratorType> preAllocator(begin, end);
+				preAllocator.maxDepth = maxDepth;
+				preAllocator.ReserveSpaceIn(val);
+
+				// Vectors are already resized, parse into their elements
+				parser.reuseCapacity = true;
+			}
+
+			parser.ParseValueIntoParallel(val);
+
+			if (parser.errorCode != QuantumJsonImpl__::ErrorCode::NoError)
+			{
+				throw QuantumJsonImpl__::JsonError(parser.errorCode);
+			}
+
+			return val;
+		}
+
+		InputIteratorType begin, end;
+		QuantumJsonImpl__::StringStorage *stringStorage;
+		std::pmr::memory_resource *memoryResource;
+		int maxDepth = QUANTUMJSON_MAX_DEPTH;
+		int threadCount = 1;
+	};
+
+	using StringStorage = QuantumJsonImpl__::StringStorage;
+
+	template <typename InputIteratorType>
+	ParserProxy<InputIteratorType> Parse(InputIteratorType begin, InputIteratorType end)
+	{
+		return ParserProxy<InputIteratorType>(begin, end);
+	}
+
+	inline
+	ParserProxy<std::string::const_iterator> Parse(const std::string &s)
+	{
+		return ParserProxy<std::string::const_iterator>(s.begin(), s.end());
+	}
+
+	inline
+	ParserProxy<const char*> Parse(const char *cstr)
+	{
+		return ParserProxy<const char*>(cstr, cstr + strlen(cstr));
+	}
+
+	inline
+	ParserProxy<QuantumJsonImpl__::PaddedIterator> Parse(const PaddedInput &input)
+	{
+		return ParserProxy<QuantumJsonImpl__::PaddedIterator>(input.begin(), input.end());
+	}
+
+	inline
+	ParserProxy<QuantumJsonImpl__::ChunkIterator> Parse(FdInput &input)
+	{
+		return ParserProxy<QuantumJsonImpl__::ChunkIterator>(input.begin(), input.end());
+	}
+
+#if defined(QUANTUMJSON_WITH_ZLIB) || defined(QUANTUMJSON_WITH_ZSTD)
+	inline
+	ParserProxy<QuantumJsonImpl__::ChunkIterator> Parse(DecompressingInput &input)
+	{
+		return ParserProxy<QuantumJsonImpl__::ChunkIterator>(input.begin(), input.end());
+	}
+#endif
+
+	// Overloads taking a parse policy, e.g. `Parse<Preallocate>(json)`
+	template <typename Policy, typename InputIteratorType>
+	ParserProxy<InputIteratorType, Policy> Parse(InputIteratorType begin, InputIteratorType end)
+	{
+		return ParserProxy<InputIteratorType, Policy>(begin, end);
+	}
+
+	template <typename Policy>
+	ParserProxy<std::string::const_iterator, Policy> Parse(const std::string &s)
+	{
+		return ParserProxy<std::string::const_iterator, Policy>(s.begin(), s.end());
+	}
+
+	template <typename Policy>
+	ParserProxy<const char*, Policy> Parse(const char *cstr)
+	{
+		return ParserProxy<const char*, Policy>(cstr, cstr + strlen(cstr));
+	}
+
+	template <typename Policy>
+	ParserProxy<QuantumJsonImpl__::PaddedIterator, Policy> Parse(const PaddedInput &input)
+	{
+		return ParserProxy<QuantumJsonImpl__::PaddedIterator, Policy>(input.begin(), input.end());
+	}
+
+	template <typename Policy>
+	ParserProxy<QuantumJsonImpl__::ChunkIterator, Policy> Parse(FdInput &input)
+	{
+		return ParserProxy<QuantumJsonImpl__::ChunkIterator, Policy>(input.begin(), input.end());
+	}
+
+	// Overloads for parsing types with `std::string_view` fields. Views point
+	// either into the input or into `storage`, so both must outlive the
+	// parsed object.
+	//
+	// QuantumJson::StringStorage storage;
+	// Request req = QuantumJson::Parse(body, storage);
+	template <typename InputIteratorType>
+	ParserProxy<InputIteratorType> Parse(InputIteratorType begin, InputIteratorType end,
+	                                     StringStorage &storage)
+	{
+		return ParserProxy<InputIteratorType>(begin, end, &storage);
+	}
+
+	inline
+	ParserProxy<std::string::const_iterator> Parse(const std::string &s, StringStorage &storage)
+	{
+		return ParserProxy<std::string::const_iterator>(s.begin(), s.end(), &storage);
+	}
+
+	// Views would point into the destroyed temporary
+	ParserProxy<std::string::const_iterator> Parse(std::string &&s, StringStorage &storage) = delete;
+
+	// Parses the file at `path` as `JsonType`, reading it from a
+	// `MappedFile`. Types with `string_view` fields can't be parsed this
+	// way, their views would point into the unmapped file; use a
+	// `MappedFile` that outlives them instead.
+	//
+	// Listing l = QuantumJson::ParseFile<Listing>("dump.json");
+	template <typename JsonType, typename Policy = void>
+	JsonType ParseFile(const std::string &path)
+	{
+		MappedFile file(path);
+		PaddedInput input = file.Input();
+		return ParserProxy<QuantumJsonImpl__::PaddedIterator, Policy>(input.begin(), input.end());
+	}
+
+	// Parses json into an existing object, reusing the memory it holds.
+	// Strings keep their capacity, existing vector elements and map values
+	// are parsed into in place and only elements past the old size are
+	// constructed, so re-parsing similar documents allocates little. As with
+	// `MergeFromJson`, object fields missing in the json keep their values.
+	//
+	// Listing l;
+	// while (Poll(&json)) QuantumJson::ParseInto(l, json);
+	template <typename JsonType, typename InputIteratorType>
+	void ParseInto(JsonType &obj, InputIteratorType begin, InputIteratorType end)
+	{
+		QuantumJsonImpl__::Parser<InputIteratorType> parser(begin, end);
+		parser.reuseCapacity = true;
+		parser.ParseValueInto(obj);
+
+		if (parser.errorCode != QuantumJsonImpl__::ErrorCode::NoError)
+		{
+			throw QuantumJsonImpl__::JsonError(parser.errorCode);
+		}
+	}
+
+	template <typename JsonType>
+	void ParseInto(JsonType &obj, const std::string &s)
+	{
+		ParseInto(obj, s.begin(), s.end());
+	}
+
+	template <typename JsonType>
+	void ParseInto(JsonType &obj, const char *cstr)
+	{
+		ParseInto(obj, cstr, cstr + strlen(cstr));
+	}
+
+	template <typename JsonType>
+	void ParseInto(JsonType &obj, const PaddedInput &input)
+	{
+		ParseInto(obj, input.begin(), input.end());
+	}
+
+	// Overloads for parsing types generated with `jc --pmr`. All strings,
+	// vectors and maps of the result allocate from `arena`, which must
+	// outlive it. With a `std::pmr::monotonic_buffer_resource` the whole
+	// document is freed at once when the resource is released.
+	//
+	// std::pmr::monotonic_buffer_resource arena;
+	// Listing l = QuantumJson::Parse(json, arena);
+	template <typename InputIteratorType>
+	ParserProxy<InputIteratorType> Parse(InputIteratorType begin, InputIteratorType end,
+	                                     std::pmr::memory_resource &arena)
+	{
+		return ParserProxy<InputIteratorType>(begin, end, nullptr, &arena);
+	}
+
+	inline
+	ParserProxy<std::string::const_iterator> Parse(const std::string &s, std::pmr::memory_resource &arena)
+	{
+		return ParserProxy<std::string::const_iterator>(s.begin(), s.end(), nullptr, &arena);
+	}
+
+	inline
+	ParserProxy<const char*> Parse(const char *cstr, std::pmr::memory_resource &arena)
+	{
+		return ParserProxy<const char*>(cstr, cstr + strlen(cstr), nullptr, &arena);
+	}
+
+	inline
+	ParserProxy<const char*> Parse(const char *cstr, StringStorage &storage)
+	{
+		return ParserProxy<const char*>(cstr, cstr + strlen(cstr), &storage);
+	}
+
+	inline
+	ParserProxy<QuantumJsonImpl__::PaddedIterator> Parse(const PaddedInput &input, StringStorage &storage)
+	{
+		return ParserProxy<QuantumJsonImpl__::PaddedIterator>(input.begin(), input.end(), &storage);
+	}
+
+	using StructuralIndex = QuantumJsonImpl__::StructuralIndex;
+
+	template <typename ElemType>
+	using ArrayView = QuantumJsonImpl__::ArrayView<ElemType>;
+
+	// On-demand parsing. The json is indexed without decoding anything, and
+	// the returned view of it as `JsonType` decodes fields only when their
+	// accessors are called. Generated structs are viewed as their `View`,
+	// vectors as `ArrayView`s. Values are validated, and errors thrown, as
+	// they are read, so parts of the json that are never read may be
+	// invalid. The input and the index must outlive the views. Different
+	// views of an index may be read from several threads, but a view
+	// locates its fields on first access so it is read by one at a time.
+	//
+	// QuantumJson::StructuralIndex index;
+	// Listing::View l = QuantumJson::ParseView<Listing>(json, index);
+	// std::string url = l.data().children()[0].data().url();
+	template <typename JsonType>
+	typename QuantumJsonImpl__::ViewOf<JsonType>::Type ParseView(const char *begin, const char *end,
+	                                                             StructuralIndex &index)
+	{
+		static_assert(QuantumJsonImpl__::ViewOf<JsonType>::isView,
+		              "Only generated structs and vectors can be viewed");
+
+		QuantumJsonImpl__::ErrorCode errorCode = index.Build(begin, end);
+		if (errorCode != QuantumJsonImpl__::ErrorCode::NoError)
+		{
+			throw QuantumJsonImpl__::JsonError(errorCode);
+		}
+
+		const size_t offset = QuantumJsonImpl__::WhitespaceRunLength(begin, end);
+		if (offset == static_cast<size_t>(end - begin))
+		{
+			throw QuantumJsonImpl__::JsonError(QuantumJsonImpl__::ErrorCode::UnexpectedEOF);
+		}
+		return QuantumJsonImpl__::ReadValue<JsonType>(&index, 0, offset, false);
+	}
+
+	template <typename JsonType>
+	typename QuantumJsonImpl__::ViewOf<JsonType>::Type ParseView(const std::string &s, StructuralIndex &index)
+	{
+		return ParseView<JsonType>(s.data(), s.data() + s.size(), index);
+	}
+
+	template <typename JsonType>
+	typename QuantumJsonImpl__::ViewOf<JsonType>::Type ParseView(const char *cstr, StructuralIndex &index)
+	{
+		return ParseView<JsonType>(cstr, cstr + strlen(cstr), index);
+	}
+
+	// Views would point into the destroyed temporary
+	template <typename JsonType>
+	void ParseView(std::string &&s, StructuralIndex &index) = delete;
+
+	using JsonError = QuantumJsonImpl__::JsonError;
+
+	// Parses json lines ( NDJSON ) input, with a value of type `JsonType`
+	// on each line. See `ParseLines`.
+	template <typename JsonType>
+	struct LinesProxy
+	{
+		LinesProxy(const char *begin, const char *end)
+		  : begin(begin), end(end)
+		{
+		}
+
+		// Parses with up to `count` threads, or one per core when `count`
+		// is 0. Lines are split into batches that are parsed concurrently
+		// while earlier ones are passed to the callbacks.
+		LinesProxy& Threads(int count)
+		{
+			threadCount = count > 0 ? count : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+			return *this;
+		}
+
+		// Passes lines to the callbacks as soon as their batch is parsed,
+		// from the parsing threads. Callbacks are then called concurrently
+		// and must be thread safe. Lines of a batch are still in order.
+		LinesProxy& Unordered()
+		{
+			ordered = false;
+			return *this;
+		}
+
+		// Overrides `QUANTUMJSON_MAX_DEPTH` for each line
+		LinesProxy& MaxDepth(int depth)
+		{
+			maxDepth = depth;
+			return *this;
+		}
+
+		// Parses each line, calling `onValue(size_t line, JsonType &value)`
+		// for valid ones and `onError(size_t line, const JsonError &error)`
+		// for the others. Lines are numbered from 1, blank lines are
+		// skipped. Values can be moved out of. Returns the number of
+		// invalid lines.
+		template <typename ValueCallback, typename ErrorCallback>
+		size_t ForEach(ValueCallback onValue, ErrorCallback onError)
+		{
+			if (threadCount == 1)
+			{
+				return ForEachSequential(onValue, onError);
+			}
+
+			std::mutex mutex;
+			std::condition_variable changed;
+			std::exception_ptr error;
+			bool stopped = false;
+			std::atomic<size_t> failedLines(0);
+
+			const char *next = begin;
+			size_t nextLine = 1;
+
+			// Cuts the next batch, with `mutex` held
+			auto takeBatch = [&](QuantumJsonImpl__::LineBatch<JsonType> &batch)
+			{
+				batch.begin = next;
+				batch.firstLine = nextLine;
+				while (next < end && static_cast<size_t>(next - batch.begin) < QuantumJsonImpl__::LineBatchSize)
+				{
+					next = QuantumJsonImpl__::NextLine(QuantumJsonImpl__::LineEnd(next, end), end);
+					++nextLine;
+				}
+				batch.end = next;
+			};
+
+			auto deliver = [&](QuantumJsonImpl__::LineBatch<JsonType> &batch)
+			{
+				failedLines += batch.errors.size();
+				batch.Deliver(onValue, onError);
+			};
+
+			// In order, batches wait in a ring of slots until the calling
+			// thread passes them to the callbacks. It parses batches too
+			// while the next one to pass is not ready.
+			const size_t slotCount = static_cast<size_t>(threadCount) * 2;
+			std::vector<QuantumJsonImpl__::LineBatch<JsonType>> slots(ordered ? slotCount : 0);
+			std::vector<char> slotParsed(slots.size(), 0);
+			size_t taken = 0;
+			size_t delivered = 0;
+
+			auto work = [&](bool isCaller)
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				if (!ordered)
+				{
+					QuantumJsonImpl__::LineBatch<JsonType> batch;
+					while (!stopped && next < end)
+					{
+						takeBatch(batch);
+						lock.unlock();
+						batch.Parse(maxDepth);
+						deliver(batch);
+						lock.lock();
+					}
+					return;
+				}
+
+				while (!stopped)
+				{
+					if (isCaller && delivered < taken && slotParsed[delivered % slotCount])
+					{
+						QuantumJsonImpl__::LineBatch<JsonType> &batch = slots[delivered % slotCount];
+						lock.unlock();
+						deliver(batch);
+						lock.lock();
+						slotParsed[delivered % slotCount] = 0;
+						++delivered;
+						changed.notify_all();
+					}
+					else if (next < end && taken - delivered < slotCount)
+					{
+						QuantumJsonImpl__::LineBatch<JsonType> &batch = slots[taken % slotCount];
+						const size_t slot = taken++ % slotCount;
+						takeBatch(batch);
+						lock.unlock();
+						batch.Parse(maxDepth);
+						lock.lock();
+						slotParsed[slot] = 1;
+						changed.notify_all();
+					}
+					else if (next == end && (!isCaller || delivered == taken))
+					{
+						return;
+					}
+					else
+					{
+						changed.wait(lock);
+					}
+				}
+			};
+
+			// Stops all threads on the first exception, e.g. thrown by a
+			// callback, to rethrow it from the calling thread
+			auto guardedWork = [&](bool isCaller)
+			{
+				try
+				{
+					work(isCaller);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					if (!error)
+					{
+						error = std::current_exception();
+					}
+					stopped = true;
+					changed.notify_all();
+				}
+			};
+
+			std::vector<std::thread> workers;
+			for (int t = 1; t < threadCount; ++t)
+			{
+				try
+				{
+					workers.emplace_back(guardedWork, false);
+				}
+				catch (const std::system_error &)
+				{
+					// Out of threads, batches are parsed by the threads
+					// already running
+					break;
+				}
+			}
+			guardedWork(true);
+			for (std::thread &worker : workers)
+			{
+				worker.join();
+			}
+
+			if (error)
+			{
+				std::rethrow_exception(error);
+			}
+			return failedLines;
+		}
+
+	private:
+		template <typename ValueCallback, typename ErrorCallback>
+		size_t ForEachSequential(ValueCallback &onValue, ErrorCallback &onError)
+		{
+			size_t failedLines = 0;
+			size_t line = 1;
+			for (const char *lineBegin = begin; lineBegin < end; ++line)
+			{
+				const char *lineEnd = QuantumJsonImpl__::LineEnd(lineBegin, end);
+				if (!QuantumJsonImpl__::IsBlankLine(lineBegin, lineEnd))
+				{
+					JsonType value{};
+					QuantumJsonImpl__::ErrorCode errorCode = QuantumJsonImpl__::ParseLine(lineBegin, lineEnd, maxDepth, value);
+					if (errorCode == QuantumJsonImpl__::ErrorCode::NoError)
+					{
+						onValue(line, value);
+					}
+					else
+					{
+						++failedLines;
+						onError(line, JsonError(errorCode));
+					}
+				}
+				lineBegin = QuantumJsonImpl__::NextLine(lineEnd, end);
+			}
+			return failedLines;
+		}
+
+		const char *begin, *end;
+		int threadCount = 1;
+		bool ordered = true;
+		int maxDepth = QUANTUMJSON_MAX_DEPTH;
+	};
+
+	// Parses json lines, also known as NDJSON, where each line holds a
+	// value. Invalid lines are reported to a callback instead of throwing,
+	// and don't stop parsing the others. The input must outlive the parse.
+	//
+	// size_t failed = QuantumJson::ParseLines<Event>(log).Threads(0).ForEach(
+	//     [&](size_t line, Event &e) { events.push_back(std::move(e)); },
+	//     [&](size_t line, const QuantumJson::JsonError &e) { Warn(line, e.what()); });
+	template <typename JsonType>
+	LinesProxy<JsonType> ParseLines(const char *begin, const char *end)
+	{
+		return LinesProxy<JsonType>(begin, end);
+	}
+
+	template <typename JsonType>
+	LinesProxy<JsonType> ParseLines(const std::string &s)
+	{
+		return LinesProxy<JsonType>(s.data(), s.data() + s.size());
+	}
+
+	template <typename JsonType>
+	LinesProxy<JsonType> ParseLines(const char *cstr)
+	{
+		return LinesProxy<JsonType>(cstr, cstr + strlen(cstr));
+	}
+
+	// Parses a document pushed in chunks, e.g. a body received over chunked
+	// HTTP, while the rest of it is still arriving. Parsing runs on a
+	// thread of its own, which waits for the next chunk at the end of each
+	// one and resumes where it stopped, so nothing is scanned twice and
+	// chunks are released as soon as they're parsed. For small documents,
+	// buffering them and calling `Parse` is cheaper.
+	//
+	// QuantumJson::PushParser<Listing> parser;
+	// while (Receive(&chunk)) parser.Feed(chunk);
+	// Listing l = parser.Finish();
+	template <typename JsonType>
+	class PushParser
+	{
+	public:
+		// With a `maxBuffered` other than 0, `Feed` waits while more than
+		// that many bytes are waiting to be parsed
+		explicit PushParser(size_t maxBuffered = 0, int maxDepth = QUANTUMJSON_MAX_DEPTH)
+		{
+			source.maxBuffered = maxBuffered;
+			thread = std::thread([this, maxDepth]()
+			{
+				try
+				{
+					QuantumJsonImpl__::ChunkIterator begin(&source);
+					QuantumJsonImpl__::Parser<QuantumJsonImpl__::ChunkIterator> parser(begin, QuantumJsonImpl__::ChunkIterator());
+					parser.maxDepth = maxDepth;
+					parser.ParseValueInto(value);
+					errorCode = parser.errorCode;
+				}
+				catch (...)
+				{
+					error = std::current_exception();
+				}
+
+				// Anything after the value is ignored, as with `Parse`
+				source.Stop();
+			});
+		}
+
+		PushParser(const PushParser&) = delete;
+		PushParser& operator=(const PushParser&) = delete;
+
+		// Abandons the parse if `Finish` was not called
+		~PushParser()
+		{
+			if (thread.joinable())
+			{
+				source.Stop();
+				thread.join();
+			}
+		}
+
+		// Copies the chunk to be parsed. Returns false if parsing already
+		// stopped, at an error or after the value, so the rest of the
+		// input isn't needed.
+		bool Feed(const char *data, size_t size)
+		{
+			return source.Push(data, size);
+		}
+
+		bool Feed(std::string_view chunk)
+		{
+			return source.Push(chunk.data(), chunk.size());
+		}
+
+		// Ends the input and returns the parsed value. Throws `JsonError`
+		// if it is invalid or incomplete. Can only be called once.
+		JsonType Finish()
+		{
+			source.Close();
+			thread.join();
+
+			if (error)
+			{
+				std::rethrow_exception(error);
+			}
+			if (errorCode != QuantumJsonImpl__::ErrorCode::NoError)
+			{
+				throw JsonError(errorCode);
+			}
+			return std::move(value);
+		}
+
+	private:
+		QuantumJsonImpl__::ChunkQueue source;
+		JsonType value{};
+		QuantumJsonImpl__::ErrorCode errorCode = QuantumJsonImpl__::ErrorCode::NoError;
+		std::exception_ptr error;
+		std::thread thread;
+	};
+
+	// Options of `Serialize` and `SerializeInto`
+	//
+	// QuantumJson::SerializeOptions options;
+	// options.escapeNonAscii = true;
+	// std::string json = QuantumJson::Serialize(obj, options);
+	struct SerializeOptions
+	{
+		// Number of significant digits to write doubles with, up to 17.
+		// When 0, the shortest representation that parses back to the same
+		// value is used.
+		int doublePrecision = 0;
+
+		// When set, non-ASCII characters in strings are written as \uXXXX
+		// escapes (surrogate pairs above U+FFFF), so the output is pure
+		// ASCII.
+		bool escapeNonAscii = false;
+	};
+
+	// Serializes `val` as json, appending to `out`
+	//
+	// std::string json;
+	// QuantumJson::SerializeInto(json, obj);
+	template <typename JsonType>
+	void SerializeInto(std::string &out, const JsonType &val,
+	                   const SerializeOptions &options = SerializeOptions())
+	{
+		QuantumJsonImpl__::StringOutputBuffer buffer(&out);
+		QuantumJsonImpl__::Serializer<QuantumJsonImpl__::StringOutputBuffer> s(buffer);
+		s.doublePrecision = options.doublePrecision;
+		s.escapeNonAscii = options.escapeNonAscii;
+		s.SerializeValue(val);
+		s.out.Finish();
+	}
+
+	template <typename JsonType>
+	std::string Serialize(const JsonType &val, const SerializeOptions &options = SerializeOptions())
+	{
+		std::string out;
+		SerializeInto(out, val, options);
+		return out;
+	}
+}
+
+#endif  // QUANTUMJSON_LIB_IMPL_
+struct Item
+{
+	Item() = default;
+	Item(const Item &) = default;
+	Item(Item &&) = default;
+	
+	Item& operator=(const Item &) = default;
+	
+	// Field tag numbers
+	enum class __QuantumJsonFieldTag
+	{
+		__QUANTUMJSON_FIELD_TAG_name = 1,
+	};
+	// Lazily decoded view, see `QuantumJson::ParseView`
+	struct View;
+	std::string name;
+	// Parsing functions
+	void MergeFromJson(const std::string &json)
+	{
+		MergeFromJson(json.begin(), json.end());
+	}
+	template <typename InputIteratorType>
+	void MergeFromJson(InputIteratorType it, InputIteratorType end);
+	// Serialization functions
+	template <typename OutputIteratorType>
+	void SerializeTo(OutputIteratorType out) const
+	{
+		QuantumJsonImpl__::Serializer<OutputIteratorType> s(out);
+		this->SerializeTo(s);
+	}
+	template <typename OutputIteratorType>
+	void SerializeTo(QuantumJsonImpl__::Serializer<OutputIteratorType> &s) const;
+	private:
+	// Private methods that are called by parser
+	// Function that parses one field only
+	// If the object is as follows:
+	// {"a": "sadsadsa", "b": 123}
+	//  <------------->  <------>
+	// marked regions would map to ParseNextField calls.
+	template <typename InputIteratorType, bool Trusted>
+	void ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser);
+	// Allocator that works on random access input, not to rely on string/vector
+	// growth performance
+	template <typename InputIteratorType>
+	static
+	// TODO rename this function to something more descriptive
+	void ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename InputIteratorType>
+	void ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename T, bool> friend struct QuantumJsonImpl__::Parser;
+	template <typename T> friend struct QuantumJsonImpl__::PreAllocator;
+};
+struct Items
+{
+	Items() = default;
+	Items(const Items &) = default;
+	Items(Items &&) = default;
+	
+	Items& operator=(const Items &) = default;
+	
+	// Field tag numbers
+	enum class __QuantumJsonFieldTag
+	{
+		__QUANTUMJSON_FIELD_TAG_i1 = 1,
+		__QUANTUMJSON_FIELD_TAG_i2 = 2,
+	};
+	// Lazily decoded view, see `QuantumJson::ParseView`
+	struct View;
+	Item i1;
+	Item i2;
+	// Parsing functions
+	void MergeFromJson(const std::string &json)
+	{
+		MergeFromJson(json.begin(), json.end());
+	}
+	template <typename InputIteratorType>
+	void MergeFromJson(InputIteratorType it, InputIteratorType end);
+	// Serialization functions
+	template <typename OutputIteratorType>
+	void SerializeTo(OutputIteratorType out) const
+	{
+		QuantumJsonImpl__::Serializer<OutputIteratorType> s(out);
+		this->SerializeTo(s);
+	}
+	template <typename OutputIteratorType>
+	void SerializeTo(QuantumJsonImpl__::Serializer<OutputIteratorType> &s) const;
+	private:
+	// Private methods that are called by parser
+	// Function that parses one field only
+	// If the object is as follows:
+	// {"a": "sadsadsa", "b": 123}
+	//  <------------->  <------>
+	// marked regions would map to ParseNextField calls.
+	template <typename InputIteratorType, bool Trusted>
+	void ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser);
+	// Allocator that works on random access input, not to rely on string/vector
+	// growth performance
+	template <typename InputIteratorType>
+	static
+	// TODO rename this function to something more descriptive
+	void ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename InputIteratorType>
+	void ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename T, bool> friend struct QuantumJsonImpl__::Parser;
+	template <typename T> friend struct QuantumJsonImpl__::PreAllocator;
+};
+struct ItemList
+{
+	ItemList() = default;
+	ItemList(const ItemList &) = default;
+	ItemList(ItemList &&) = default;
+	
+	ItemList& operator=(const ItemList &) = default;
+	
+	// Field tag numbers
+	enum class __QuantumJsonFieldTag
+	{
+		__QUANTUMJSON_FIELD_TAG_items = 1,
+	};
+	// Lazily decoded view, see `QuantumJson::ParseView`
+	struct View;
+	std::vector< Item > items;
+	// Parsing functions
+	void MergeFromJson(const std::string &json)
+	{
+		MergeFromJson(json.begin(), json.end());
+	}
+	template <typename InputIteratorType>
+	void MergeFromJson(InputIteratorType it, InputIteratorType end);
+	// Serialization functions
+	template <typename OutputIteratorType>
+	void SerializeTo(OutputIteratorType out) const
+	{
+		QuantumJsonImpl__::Serializer<OutputIteratorType> s(out);
+		this->SerializeTo(s);
+	}
+	template <typename OutputIteratorType>
+	void SerializeTo(QuantumJsonImpl__::Serializer<OutputIteratorType> &s) const;
+	private:
+	// Private methods that are called by parser
+	// Function that parses one field only
+	// If the object is as follows:
+	// {"a": "sadsadsa", "b": 123}
+	//  <------------->  <------>
+	// marked regions would map to ParseNextField calls.
+	template <typename InputIteratorType, bool Trusted>
+	void ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser);
+	// Allocator that works on random access input, not to rely on string/vector
+	// growth performance
+	template <typename InputIteratorType>
+	static
+	// TODO rename this function to something more descriptive
+	void ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename InputIteratorType>
+	void ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename T, bool> friend struct QuantumJsonImpl__::Parser;
+	template <typename T> friend struct QuantumJsonImpl__::PreAllocator;
+};
+struct Listing
+{
+	Listing() = default;
+	Listing(const Listing &) = default;
+	Listing(Listing &&) = default;
+	
+	Listing& operator=(const Listing &) = default;
+	
+	// Field tag numbers
+	enum class __QuantumJsonFieldTag
+	{
+		__QUANTUMJSON_FIELD_TAG_kind = 1,
+		__QUANTUMJSON_FIELD_TAG_item = 2,
+		__QUANTUMJSON_FIELD_TAG_before = 3,
+		__QUANTUMJSON_FIELD_TAG_after = 4,
+		__QUANTUMJSON_FIELD_TAG_arrayField = 5,
+	};
+	// Lazily decoded view, see `QuantumJson::ParseView`
+	struct View;
+	std::string kind;
+	Item item;
+	std::string before;
+	std::string after;
+	std::vector< std::string > arrayField;
+	// Parsing functions
+	void MergeFromJson(const std::string &json)
+	{
+		MergeFromJson(json.begin(), json.end());
+	}
+	template <typename InputIteratorType>
+	void MergeFromJson(InputIteratorType it, InputIteratorType end);
+	// Serialization functions
+	template <typename OutputIteratorType>
+	void SerializeTo(OutputIteratorType out) const
+	{
+		QuantumJsonImpl__::Serializer<OutputIteratorType> s(out);
+		this->SerializeTo(s);
+	}
+	template <typename OutputIteratorType>
+	void SerializeTo(QuantumJsonImpl__::Serializer<OutputIteratorType> &s) const;
+	private:
+	// Private methods that are called by parser
+	// Function that parses one field only
+	// If the object is as follows:
+	// {"a": "sadsadsa", "b": 123}
+	//  <------------->  <------>
+	// marked regions would map to ParseNextField calls.
+	template <typename InputIteratorType, bool Trusted>
+	void ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser);
+	// Allocator that works on random access input, not to rely on string/vector
+	// growth performance
+	template <typename InputIteratorType>
+	static
+	// TODO rename this function to something more descriptive
+	void ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename InputIteratorType>
+	void ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename T, bool> friend struct QuantumJsonImpl__::Parser;
+	template <typename T> friend struct QuantumJsonImpl__::PreAllocator;
+};
+struct FieldNameFSMTester
+{
+	FieldNameFSMTester() = default;
+	FieldNameFSMTester(const FieldNameFSMTester &) = default;
+	FieldNameFSMTester(FieldNameFSMTester &&) = default;
+	
+	FieldNameFSMTester& operator=(const FieldNameFSMTester &) = default;
+	
+	// Field tag numbers
+	enum class __QuantumJsonFieldTag
+	{
+		__QUANTUMJSON_FIELD_TAG_abcdef = 1,
+		__QUANTUMJSON_FIELD_TAG_aaaaaa = 2,
+		__QUANTUMJSON_FIELD_TAG_bbcdef = 3,
+		__QUANTUMJSON_FIELD_TAG_abcdqq = 4,
+	};
+	// Lazily decoded view, see `QuantumJson::ParseView`
+	struct View;
+	std::string abcdef;
+	std::string aaaaaa;
+	std::string bbcdef;
+	std::string abcdqq;
+	// Parsing functions
+	void MergeFromJson(const std::string &json)
+	{
+		MergeFromJson(json.begin(), json.end());
+	}
+	template <typename InputIteratorType>
+	void MergeFromJson(InputIteratorType it, InputIteratorType end);
+	// Serialization functions
+	template <typename OutputIteratorType>
+	void SerializeTo(OutputIteratorType out) const
+	{
+		QuantumJsonImpl__::Serializer<OutputIteratorType> s(out);
+		this->SerializeTo(s);
+	}
+	template <typename OutputIteratorType>
+	void SerializeTo(QuantumJsonImpl__::Serializer<OutputIteratorType> &s) const;
+	private:
+	// Private methods that are called by parser
+	// Function that parses one field only
+	// If the object is as follows:
+	// {"a": "sadsadsa", "b": 123}
+	//  <------------->  <------>
+	// marked regions would map to ParseNextField calls.
+	template <typename InputIteratorType, bool Trusted>
+	void ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser);
+	// Allocator that works on random access input, not to rely on string/vector
+	// growth performance
+	template <typename InputIteratorType>
+	static
+	// TODO rename this function to something more descriptive
+	void ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename InputIteratorType>
+	void ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename T, bool> friend struct QuantumJsonImpl__::Parser;
+	template <typename T> friend struct QuantumJsonImpl__::PreAllocator;
+};
+struct AttributeTester
+{
+	AttributeTester() = default;
+	AttributeTester(const AttributeTester &) = default;
+	AttributeTester(AttributeTester &&) = default;
+	
+	AttributeTester& operator=(const AttributeTester &) = default;
+	
+	// Field tag numbers
+	enum class __QuantumJsonFieldTag
+	{
+		__QUANTUMJSON_FIELD_TAG_attr1 = 1,
+		__QUANTUMJSON_FIELD_TAG_attr2 = 2,
+	};
+	// Lazily decoded view, see `QuantumJson::ParseView`
+	struct View;
+	std::string attr1;
+	std::string attr2;
+	// Parsing functions
+	void MergeFromJson(const std::string &json)
+	{
+		MergeFromJson(json.begin(), json.end());
+	}
+	template <typename InputIteratorType>
+	void MergeFromJson(InputIteratorType it, InputIteratorType end);
+	// Serialization functions
+	template <typename OutputIteratorType>
+	void SerializeTo(OutputIteratorType out) const
+	{
+		QuantumJsonImpl__::Serializer<OutputIteratorType> s(out);
+		this->SerializeTo(s);
+	}
+	template <typename OutputIteratorType>
+	void SerializeTo(QuantumJsonImpl__::Serializer<OutputIteratorType> &s) const;
+	private:
+	// Private methods that are called by parser
+	// Function that parses one field only
+	// If the object is as follows:
+	// {"a": "sadsadsa", "b": 123}
+	//  <------------->  <------>
+	// marked regions would map to ParseNextField calls.
+	template <typename InputIteratorType, bool Trusted>
+	void ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser);
+	// Allocator that works on random access input, not to rely on string/vector
+	// growth performance
+	template <typename InputIteratorType>
+	static
+	// TODO rename this function to something more descriptive
+	void ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename InputIteratorType>
+	void ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename T, bool> friend struct QuantumJsonImpl__::Parser;
+	template <typename T> friend struct QuantumJsonImpl__::PreAllocator;
+};
+struct SkipNullTester
+{
+	SkipNullTester() = default;
+	SkipNullTester(const SkipNullTester &) = default;
+	SkipNullTester(SkipNullTester &&) = default;
+	
+	SkipNullTester& operator=(const SkipNullTester &) = default;
+	
+	// Field tag numbers
+	enum class __QuantumJsonFieldTag
+	{
+		__QUANTUMJSON_FIELD_TAG_attr_accepting_null = 1,
+		__QUANTUMJSON_FIELD_TAG_attr_regular = 2,
+	};
+	// Lazily decoded view, see `QuantumJson::ParseView`
+	struct View;
+	std::string attr_accepting_null;
+	std::string attr_regular;
+	// Parsing functions
+	void MergeFromJson(const std::string &json)
+	{
+		MergeFromJson(json.begin(), json.end());
+	}
+	template <typename InputIteratorType>
+	void MergeFromJson(InputIteratorType it, InputIteratorType end);
+	// Serialization functions
+	template <typename OutputIteratorType>
+	void SerializeTo(OutputIteratorType out) const
+	{
+		QuantumJsonImpl__::Serializer<OutputIteratorType> s(out);
+		this->SerializeTo(s);
+	}
+	template <typename OutputIteratorType>
+	void SerializeTo(QuantumJsonImpl__::Serializer<OutputIteratorType> &s) const;
+	private:
+	// Private methods that are called by parser
+	// Function that parses one field only
+	// If the object is as follows:
+	// {"a": "sadsadsa", "b": 123}
+	//  <------------->  <------>
+	// marked regions would map to ParseNextField calls.
+	template <typename InputIteratorType, bool Trusted>
+	void ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser);
+	// Allocator that works on random access input, not to rely on string/vector
+	// growth performance
+	template <typename InputIteratorType>
+	static
+	// TODO rename this function to something more descriptive
+	void ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename InputIteratorType>
+	void ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename T, bool> friend struct QuantumJsonImpl__::Parser;
+	template <typename T> friend struct QuantumJsonImpl__::PreAllocator;
+};
+struct AAAAAA
+{
+	AAAAAA() = default;
+	AAAAAA(const AAAAAA &) = default;
+	AAAAAA(AAAAAA &&) = default;
+	
+	AAAAAA& operator=(const AAAAAA &) = default;
+	
+	// Field tag numbers
+	enum class __QuantumJsonFieldTag
+	{
+		__QUANTUMJSON_FIELD_TAG_field = 1,
+	};
+	// Lazily decoded view, see `QuantumJson::ParseView`
+	struct View;
+	std::vector< std::string > field;
+	// Parsing functions
+	void MergeFromJson(const std::string &json)
+	{
+		MergeFromJson(json.begin(), json.end());
+	}
+	template <typename InputIteratorType>
+	void MergeFromJson(InputIteratorType it, InputIteratorType end);
+	// Serialization functions
+	template <typename OutputIteratorType>
+	void SerializeTo(OutputIteratorType out) const
+	{
+		QuantumJsonImpl__::Serializer<OutputIteratorType> s(out);
+		this->SerializeTo(s);
+	}
+	template <typename OutputIteratorType>
+	void SerializeTo(QuantumJsonImpl__::Serializer<OutputIteratorType> &s) const;
+	private:
+	// Private methods that are called by parser
+	// Function that parses one field only
+	// If the object is as follows:
+	// {"a": "sadsadsa", "b": 123}
+	//  <------------->  <------>
+	// marked regions would map to ParseNextField calls.
+	template <typename InputIteratorType, bool Trusted>
+	void ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser);
+	// Allocator that works on random access input, not to rely on string/vector
+	// growth performance
+	template <typename InputIteratorType>
+	static
+	// TODO rename this function to something more descriptive
+	void ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename InputIteratorType>
+	void ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename T, bool> friend struct QuantumJsonImpl__::Parser;
+	template <typename T> friend struct QuantumJsonImpl__::PreAllocator;
+};
+struct FieldTypes
+{
+	FieldTypes() = default;
+	FieldTypes(const FieldTypes &) = default;
+	FieldTypes(FieldTypes &&) = default;
+	
+	FieldTypes& operator=(const FieldTypes &) = default;
+	
+	// Field tag numbers
+	enum class __QuantumJsonFieldTag
+	{
+		// Skipped non-reservable field intField
+		// Skipped non-reservable field doubleField
+		__QUANTUMJSON_FIELD_TAG_stringField = 1,
+		__QUANTUMJSON_FIELD_TAG_structField = 2,
+	};
+	// Lazily decoded view, see `QuantumJson::ParseView`
+	struct View;
+	int intField;
+	double doubleField;
+	std::string stringField;
+	AAAAAA structField;
+	// Parsing functions
+	void MergeFromJson(const std::string &json)
+	{
+		MergeFromJson(json.begin(), json.end());
+	}
+	template <typename InputIteratorType>
+	void MergeFromJson(InputIteratorType it, InputIteratorType end);
+	// Serialization functions
+	template <typename OutputIteratorType>
+	void SerializeTo(OutputIteratorType out) const
+	{
+		QuantumJsonImpl__::Serializer<OutputIteratorType> s(out);
+		this->SerializeTo(s);
+	}
+	template <typename OutputIteratorType>
+	void SerializeTo(QuantumJsonImpl__::Serializer<OutputIteratorType> &s) const;
+	private:
+	// Private methods that are called by parser
+	// Function that parses one field only
+	// If the object is as follows:
+	// {"a": "sadsadsa", "b": 123}
+	//  <------------->  <------>
+	// marked regions would map to ParseNextField calls.
+	template <typename InputIteratorType, bool Trusted>
+	void ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser);
+	// Allocator that works on random access input, not to rely on string/vector
+	// growth performance
+	template <typename InputIteratorType>
+	static
+	// TODO rename this function to something more descriptive
+	void ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename InputIteratorType>
+	void ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename T, bool> friend struct QuantumJsonImpl__::Parser;
+	template <typename T> friend struct QuantumJsonImpl__::PreAllocator;
+};
+struct IntegerTypes
+{
+	IntegerTypes() = default;
+	IntegerTypes(const IntegerTypes &) = default;
+	IntegerTypes(IntegerTypes &&) = default;
+	
+	IntegerTypes& operator=(const IntegerTypes &) = default;
+	
+	// Field tag numbers
+	enum class __QuantumJsonFieldTag
+	{
+		// Skipped non-reservable field i32
+		// Skipped non-reservable field u32
+		// Skipped non-reservable field i64
+		// Skipped non-reservable field u64
+	};
+	// Lazily decoded view, see `QuantumJson::ParseView`
+	struct View;
+	int32_t i32;
+	uint32_t u32;
+	int64_t i64;
+	uint64_t u64;
+	// Parsing functions
+	void MergeFromJson(const std::string &json)
+	{
+		MergeFromJson(json.begin(), json.end());
+	}
+	template <typename InputIteratorType>
+	void MergeFromJson(InputIteratorType it, InputIteratorType end);
+	// Serialization functions
+	template <typename OutputIteratorType>
+	void SerializeTo(OutputIteratorType out) const
+	{
+		QuantumJsonImpl__::Serializer<OutputIteratorType> s(out);
+		this->SerializeTo(s);
+	}
+	template <typename OutputIteratorType>
+	void SerializeTo(QuantumJsonImpl__::Serializer<OutputIteratorType> &s) const;
+	private:
+	// Private methods that are called by parser
+	// Function that parses one field only
+	// If the object is as follows:
+	// {"a": "sadsadsa", "b": 123}
+	//  <------------->  <------>
+	// marked regions would map to ParseNextField calls.
+	template <typename InputIteratorType, bool Trusted>
+	void ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser);
+	// Allocator that works on random access input, not to rely on string/vector
+	// growth performance
+	template <typename InputIteratorType>
+	static
+	// TODO rename this function to something more descriptive
+	void ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename InputIteratorType>
+	void ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename T, bool> friend struct QuantumJsonImpl__::Parser;
+	template <typename T> friend struct QuantumJsonImpl__::PreAllocator;
+};
+struct ReusedDocument
+{
+	ReusedDocument() = default;
+	ReusedDocument(const ReusedDocument &) = default;
+	ReusedDocument(ReusedDocument &&) = default;
+	
+	ReusedDocument& operator=(const ReusedDocument &) = default;
+	
+	// Field tag numbers
+	enum class __QuantumJsonFieldTag
+	{
+		__QUANTUMJSON_FIELD_TAG_title = 1,
+		__QUANTUMJSON_FIELD_TAG_items = 2,
+		// Skipped non-reservable field groups
+	};
+	// Lazily decoded view, see `QuantumJson::ParseView`
+	struct View;
+	std::string title;
+	std::vector< Item > items;
+	std::map< std::string , std::vector< int > > groups;
+	// Parsing functions
+	void MergeFromJson(const std::string &json)
+	{
+		MergeFromJson(json.begin(), json.end());
+	}
+	template <typename InputIteratorType>
+	void MergeFromJson(InputIteratorType it, InputIteratorType end);
+	// Serialization functions
+	template <typename OutputIteratorType>
+	void SerializeTo(OutputIteratorType out) const
+	{
+		QuantumJsonImpl__::Serializer<OutputIteratorType> s(out);
+		this->SerializeTo(s);
+	}
+	template <typename OutputIteratorType>
+	void SerializeTo(QuantumJsonImpl__::Serializer<OutputIteratorType> &s) const;
+	private:
+	// Private methods that are called by parser
+	// Function that parses one field only
+	// If the object is as follows:
+	// {"a": "sadsadsa", "b": 123}
+	//  <------------->  <------>
+	// marked regions would map to ParseNextField calls.
+	template <typename InputIteratorType, bool Trusted>
+	void ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser);
+	// Allocator that works on random access input, not to rely on string/vector
+	// growth performance
+	template <typename InputIteratorType>
+	static
+	// TODO rename this function to something more descriptive
+	void ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename InputIteratorType>
+	void ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename T, bool> friend struct QuantumJsonImpl__::Parser;
+	template <typename T> friend struct QuantumJsonImpl__::PreAllocator;
+};
+struct StringViews
+{
+	StringViews() = default;
+	StringViews(const StringViews &) = default;
+	StringViews(StringViews &&) = default;
+	
+	StringViews& operator=(const StringViews &) = default;
+	
+	// Field tag numbers
+	enum class __QuantumJsonFieldTag
+	{
+		// Skipped non-reservable field name
+		__QUANTUMJSON_FIELD_TAG_tags = 1,
+	};
+	// Lazily decoded view, see `QuantumJson::ParseView`
+	struct View;
+	std::string_view name;
+	std::vector< std::string_view > tags;
+	// Parsing functions
+	void MergeFromJson(const std::string &json)
+	{
+		MergeFromJson(json.begin(), json.end());
+	}
+	template <typename InputIteratorType>
+	void MergeFromJson(InputIteratorType it, InputIteratorType end);
+	// Serialization functions
+	template <typename OutputIteratorType>
+	void SerializeTo(OutputIteratorType out) const
+	{
+		QuantumJsonImpl__::Serializer<OutputIteratorType> s(out);
+		this->SerializeTo(s);
+	}
+	template <typename OutputIteratorType>
+	void SerializeTo(QuantumJsonImpl__::Serializer<OutputIteratorType> &s) const;
+	private:
+	// Private methods that are called by parser
+	// Function that parses one field only
+	// If the object is as follows:
+	// {"a": "sadsadsa", "b": 123}
+	//  <------------->  <------>
+	// marked regions would map to ParseNextField calls.
+	template <typename InputIteratorType, bool Trusted>
+	void ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser);
+	// Allocator that works on random access input, not to rely on string/vector
+	// growth performance
+	template <typename InputIteratorType>
+	static
+	// TODO rename this function to something more descriptive
+	void ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename InputIteratorType>
+	void ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename T, bool> friend struct QuantumJsonImpl__::Parser;
+	template <typename T> friend struct QuantumJsonImpl__::PreAllocator;
+};
+struct ParallelList
+{
+	ParallelList() = default;
+	ParallelList(const ParallelList &) = default;
+	ParallelList(ParallelList &&) = default;
+	
+	ParallelList& operator=(const ParallelList &) = default;
+	
+	// Field tag numbers
+	enum class __QuantumJsonFieldTag
+	{
+		__QUANTUMJSON_FIELD_TAG_title = 1,
+		__QUANTUMJSON_FIELD_TAG_items = 2,
+		__QUANTUMJSON_FIELD_TAG_groups = 3,
+	};
+	// Lazily decoded view, see `QuantumJson::ParseView`
+	struct View;
+	std::string title;
+	std::vector< Item > items;
+	std::vector< std::vector< int > > groups;
+	// Parsing functions
+	void MergeFromJson(const std::string &json)
+	{
+		MergeFromJson(json.begin(), json.end());
+	}
+	template <typename InputIteratorType>
+	void MergeFromJson(InputIteratorType it, InputIteratorType end);
+	// Serialization functions
+	template <typename OutputIteratorType>
+	void SerializeTo(OutputIteratorType out) const
+	{
+		QuantumJsonImpl__::Serializer<OutputIteratorType> s(out);
+		this->SerializeTo(s);
+	}
+	template <typename OutputIteratorType>
+	void SerializeTo(QuantumJsonImpl__::Serializer<OutputIteratorType> &s) const;
+	private:
+	// Private methods that are called by parser
+	// Function that parses one field only
+	// If the object is as follows:
+	// {"a": "sadsadsa", "b": 123}
+	//  <------------->  <------>
+	// marked regions would map to ParseNextField calls.
+	template <typename InputIteratorType, bool Trusted>
+	void ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser);
+	// Allocator that works on random access input, not to rely on string/vector
+	// growth performance
+	template <typename InputIteratorType>
+	static
+	// TODO rename this function to something more descriptive
+	void ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename InputIteratorType>
+	void ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);
+	template <typename T, bool> friend struct QuantumJsonImpl__::Parser;
+	template <typename T> friend struct QuantumJsonImpl__::PreAllocator;
+};
+struct Item::View : QuantumJsonImpl__::ObjectView<1>
+{
+	using QuantumJsonImpl__::ObjectView<1>::ObjectView;
+	
+	// Field accessors, decoding the value on each call
+	QuantumJsonImpl__::ViewOf<decltype(Item::name)>::Type name() const;
+	
+	private:
+	// Sets `parser.matchedField` to the index of the field named by the key
+	static void MatchField(QuantumJsonImpl__::FieldNameMatcher &parser);
+};
+struct Items::View : QuantumJsonImpl__::ObjectView<2>
+{
+	using QuantumJsonImpl__::ObjectView<2>::ObjectView;
+	
+	// Field accessors, decoding the value on each call
+	QuantumJsonImpl__::ViewOf<decltype(Items::i1)>::Type i1() const;
+	QuantumJsonImpl__::ViewOf<decltype(Items::i2)>::Type i2() const;
+	
+	private:
+	// Sets `parser.matchedField` to the index of the field named by the key
+	static void MatchField(QuantumJsonImpl__::FieldNameMatcher &parser);
+};
+struct ItemList::View : QuantumJsonImpl__::ObjectView<1>
+{
+	using QuantumJsonImpl__::ObjectView<1>::ObjectView;
+	
+	// Field accessors, decoding the value on each call
+	QuantumJsonImpl__::ViewOf<decltype(ItemList::items)>::Type items() const;
+	
+	private:
+	// Sets `parser.matchedField` to the index of the field named by the key
+	static void MatchField(QuantumJsonImpl__::FieldNameMatcher &parser);
+};
+struct Listing::View : QuantumJsonImpl__::ObjectView<5>
+{
+	using QuantumJsonImpl__::ObjectView<5>::ObjectView;
+	
+	// Field accessors, decoding the value on each call
+	QuantumJsonImpl__::ViewOf<decltype(Listing::kind)>::Type kind() const;
+	QuantumJsonImpl__::ViewOf<decltype(Listing::item)>::Type item() const;
+	QuantumJsonImpl__::ViewOf<decltype(Listing::before)>::Type before() const;
+	QuantumJsonImpl__::ViewOf<decltype(Listing::after)>::Type after() const;
+	QuantumJsonImpl__::ViewOf<decltype(Listing::arrayField)>::Type arrayField() const;
+	
+	private:
+	// Sets `parser.matchedField` to the index of the field named by the key
+	static void MatchField(QuantumJsonImpl__::FieldNameMatcher &parser);
+};
+struct FieldNameFSMTester::View : QuantumJsonImpl__::ObjectView<4>
+{
+	using QuantumJsonImpl__::ObjectView<4>::ObjectView;
+	
+	// Field accessors, decoding the value on each call
+	QuantumJsonImpl__::ViewOf<decltype(FieldNameFSMTester::abcdef)>::Type abcdef() const;
+	QuantumJsonImpl__::ViewOf<decltype(FieldNameFSMTester::aaaaaa)>::Type aaaaaa() const;
+	QuantumJsonImpl__::ViewOf<decltype(FieldNameFSMTester::bbcdef)>::Type bbcdef() const;
+	QuantumJsonImpl__::ViewOf<decltype(FieldNameFSMTester::abcdqq)>::Type abcdqq() const;
+	
+	private:
+	// Sets `parser.matchedField` to the index of the field named by the key
+	static void MatchField(QuantumJsonImpl__::FieldNameMatcher &parser);
+};
+struct AttributeTester::View : QuantumJsonImpl__::ObjectView<2>
+{
+	using QuantumJsonImpl__::ObjectView<2>::ObjectView;
+	
+	// Field accessors, decoding the value on each call
+	QuantumJsonImpl__::ViewOf<decltype(AttributeTester::attr1)>::Type attr1() const;
+	QuantumJsonImpl__::ViewOf<decltype(AttributeTester::attr2)>::Type attr2() const;
+	
+	private:
+	// Sets `parser.matchedField` to the index of the field named by the key
+	static void MatchField(QuantumJsonImpl__::FieldNameMatcher &parser);
+};
+struct SkipNullTester::View : QuantumJsonImpl__::ObjectView<2>
+{
+	using QuantumJsonImpl__::ObjectView<2>::ObjectView;
+	
+	// Field accessors, decoding the value on each call
+	QuantumJsonImpl__::ViewOf<decltype(SkipNullTester::attr_accepting_null)>::Type attr_accepting_null() const;
+	QuantumJsonImpl__::ViewOf<decltype(SkipNullTester::attr_regular)>::Type attr_regular() const;
+	
+	private:
+	// Sets `parser.matchedField` to the index of the field named by the key
+	static void MatchField(QuantumJsonImpl__::FieldNameMatcher &parser);
+};
+struct AAAAAA::View : QuantumJsonImpl__::ObjectView<1>
+{
+	using QuantumJsonImpl__::ObjectView<1>::ObjectView;
+	
+	// Field accessors, decoding the value on each call
+	QuantumJsonImpl__::ViewOf<decltype(AAAAAA::field)>::Type field() const;
+	
+	private:
+	// Sets `parser.matchedField` to the index of the field named by the key
+	static void MatchField(QuantumJsonImpl__::FieldNameMatcher &parser);
+};
+struct FieldTypes::View : QuantumJsonImpl__::ObjectView<4>
+{
+	using QuantumJsonImpl__::ObjectView<4>::ObjectView;
+	
+	// Field accessors, decoding the value on each call
+	QuantumJsonImpl__::ViewOf<decltype(FieldTypes::intField)>::Type intField() const;
+	QuantumJsonImpl__::ViewOf<decltype(FieldTypes::doubleField)>::Type doubleField() const;
+	QuantumJsonImpl__::ViewOf<decltype(FieldTypes::stringField)>::Type stringField() const;
+	QuantumJsonImpl__::ViewOf<decltype(FieldTypes::structField)>::Type structField() const;
+	
+	private:
+	// Sets `parser.matchedField` to the index of the field named by the key
+	static void MatchField(QuantumJsonImpl__::FieldNameMatcher &parser);
+};
+struct IntegerTypes::View : QuantumJsonImpl__::ObjectView<4>
+{
+	using QuantumJsonImpl__::ObjectView<4>::ObjectView;
+	
+	// Field accessors, decoding the value on each call
+	QuantumJsonImpl__::ViewOf<decltype(IntegerTypes::i32)>::Type i32() const;
+	QuantumJsonImpl__::ViewOf<decltype(IntegerTypes::u32)>::Type u32() const;
+	QuantumJsonImpl__::ViewOf<decltype(IntegerTypes::i64)>::Type i64() const;
+	QuantumJsonImpl__::ViewOf<decltype(IntegerTypes::u64)>::Type u64() const;
+	
+	private:
+	// Sets `parser.matchedField` to the index of the field named by the key
+	static void MatchField(QuantumJsonImpl__::FieldNameMatcher &parser);
+};
+struct ReusedDocument::View : QuantumJsonImpl__::ObjectView<3>
+{
+	using QuantumJsonImpl__::ObjectView<3>::ObjectView;
+	
+	// Field accessors, decoding the value on each call
+	QuantumJsonImpl__::ViewOf<decltype(ReusedDocument::title)>::Type title() const;
+	QuantumJsonImpl__::ViewOf<decltype(ReusedDocument::items)>::Type items() const;
+	QuantumJsonImpl__::ViewOf<decltype(ReusedDocument::groups)>::Type groups() const;
+	
+	private:
+	// Sets `parser.matchedField` to the index of the field named by the key
+	static void MatchField(QuantumJsonImpl__::FieldNameMatcher &parser);
+};
+struct StringViews::View : QuantumJsonImpl__::ObjectView<2>
+{
+	using QuantumJsonImpl__::ObjectView<2>::ObjectView;
+	
+	// Field accessors, decoding the value on each call
+	QuantumJsonImpl__::ViewOf<decltype(StringViews::name)>::Type name() const;
+	QuantumJsonImpl__::ViewOf<decltype(StringViews::tags)>::Type tags() const;
+	
+	private:
+	// Sets `parser.matchedField` to the index of the field named by the key
+	static void MatchField(QuantumJsonImpl__::FieldNameMatcher &parser);
+};
+struct ParallelList::View : QuantumJsonImpl__::ObjectView<3>
+{
+	using QuantumJsonImpl__::ObjectView<3>::ObjectView;
+	
+	// Field accessors, decoding the value on each call
+	QuantumJsonImpl__::ViewOf<decltype(ParallelList::title)>::Type title() const;
+	QuantumJsonImpl__::ViewOf<decltype(ParallelList::items)>::Type items() const;
+	QuantumJsonImpl__::ViewOf<decltype(ParallelList::groups)>::Type groups() const;
+	
+	private:
+	// Sets `parser.matchedField` to the index of the field named by the key
+	static void MatchField(QuantumJsonImpl__::FieldNameMatcher &parser);
+};
+template <typename InputIteratorType, bool Trusted>
+inline
+void Item::ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'n': goto state_102;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [n]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_103:
+	// Currently matched prefix [na]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'm': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [nam]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [name]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_106;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Matched field [name]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->name);
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void Item::ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'n': goto state_102;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [n]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_103:
+	// Currently matched prefix [na]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'm': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [nam]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [name]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_106;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Matched field [name]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_name));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(Item::name)*>(nullptr));
+		return;
+	}
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void Item::ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator)
+{
+	size_t objectFieldsEnd = allocator.GetObjectSize();
+	allocator.PopObject();
+	while (allocator.GetCurIdx() != objectFieldsEnd)
+	{
+		int fieldTag = allocator.GetFieldTag();
+		switch(static_cast<__QuantumJsonFieldTag>(fieldTag))
+		{
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_name:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->name);
+				break;
+			}
+			default:
+			; // Should not happen
+		}
+	}
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(Item::name)>::Type Item::View::name() const
+{
+	return FieldValue<decltype(Item::name)>(0, &MatchField, false);
+}
+inline
+void Item::View::MatchField(QuantumJsonImpl__::FieldNameMatcher &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'n': goto state_102;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [n]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_103:
+	// Currently matched prefix [na]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'm': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [nam]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [name]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_106;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Matched field [name]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 0;
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void Item::MergeFromJson(InputIteratorType it,
+                         InputIteratorType end)
+{
+	QuantumJsonImpl__::Parser<InputIteratorType> parser(it, end);
+	parser.ParseObject(*this);
+	
+	// Throw when parsing fails
+	if (parser.errorCode != QuantumJsonImpl__::ErrorCode::NoError)
+	{
+		throw QuantumJsonImpl__::JsonError(parser.errorCode);
+	}
+}
+template <typename OutputIteratorType>
+void Item::SerializeTo(
+    QuantumJsonImpl__::Serializer<OutputIteratorType> &s
+    ) const
+{
+	
+	// Render field name
+	s.WriteLiteral("{\"name\":");
+	s.SerializeValue(this->name);
+	s.Put('}');
+}
+template <typename InputIteratorType, bool Trusted>
+inline
+void Items::ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_102;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [i]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '1': goto state_103;
+		case '2': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_103:
+	// Currently matched prefix [i1]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_105;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Matched field [i1]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->i1);
+	return;
+	state_104:
+	// Currently matched prefix [i2]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_106;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Matched field [i2]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->i2);
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void Items::ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_102;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [i]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '1': goto state_103;
+		case '2': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_103:
+	// Currently matched prefix [i1]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_105;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Matched field [i1]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_i1));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(Items::i1)*>(nullptr));
+		return;
+	}
+	return;
+	state_104:
+	// Currently matched prefix [i2]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_106;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Matched field [i2]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_i2));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(Items::i2)*>(nullptr));
+		return;
+	}
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void Items::ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator)
+{
+	size_t objectFieldsEnd = allocator.GetObjectSize();
+	allocator.PopObject();
+	while (allocator.GetCurIdx() != objectFieldsEnd)
+	{
+		int fieldTag = allocator.GetFieldTag();
+		switch(static_cast<__QuantumJsonFieldTag>(fieldTag))
+		{
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_i1:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->i1);
+				break;
+			}
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_i2:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->i2);
+				break;
+			}
+			default:
+			; // Should not happen
+		}
+	}
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(Items::i1)>::Type Items::View::i1() const
+{
+	return FieldValue<decltype(Items::i1)>(0, &MatchField, false);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(Items::i2)>::Type Items::View::i2() const
+{
+	return FieldValue<decltype(Items::i2)>(1, &MatchField, false);
+}
+inline
+void Items::View::MatchField(QuantumJsonImpl__::FieldNameMatcher &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_102;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [i]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '1': goto state_103;
+		case '2': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_103:
+	// Currently matched prefix [i1]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_105;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Matched field [i1]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 0;
+	return;
+	state_104:
+	// Currently matched prefix [i2]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_106;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Matched field [i2]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 1;
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void Items::MergeFromJson(InputIteratorType it,
+                          InputIteratorType end)
+{
+	QuantumJsonImpl__::Parser<InputIteratorType> parser(it, end);
+	parser.ParseObject(*this);
+	
+	// Throw when parsing fails
+	if (parser.errorCode != QuantumJsonImpl__::ErrorCode::NoError)
+	{
+		throw QuantumJsonImpl__::JsonError(parser.errorCode);
+	}
+}
+template <typename OutputIteratorType>
+void Items::SerializeTo(
+    QuantumJsonImpl__::Serializer<OutputIteratorType> &s
+    ) const
+{
+	
+	// Render field i1
+	s.WriteLiteral("{\"i1\":");
+	s.SerializeValue(this->i1);
+	
+	// Render field i2
+	s.WriteLiteral(",\"i2\":");
+	s.SerializeValue(this->i2);
+	s.Put('}');
+}
+template <typename InputIteratorType, bool Trusted>
+inline
+void ItemList::ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_102;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [i]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_103:
+	// Currently matched prefix [it]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [ite]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'm': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [item]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 's': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [items]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_107;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Matched field [items]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->items);
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void ItemList::ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_102;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [i]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_103:
+	// Currently matched prefix [it]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [ite]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'm': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [item]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 's': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [items]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_107;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Matched field [items]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_items));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(ItemList::items)*>(nullptr));
+		return;
+	}
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void ItemList::ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator)
+{
+	size_t objectFieldsEnd = allocator.GetObjectSize();
+	allocator.PopObject();
+	while (allocator.GetCurIdx() != objectFieldsEnd)
+	{
+		int fieldTag = allocator.GetFieldTag();
+		switch(static_cast<__QuantumJsonFieldTag>(fieldTag))
+		{
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_items:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->items);
+				break;
+			}
+			default:
+			; // Should not happen
+		}
+	}
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(ItemList::items)>::Type ItemList::View::items() const
+{
+	return FieldValue<decltype(ItemList::items)>(0, &MatchField, false);
+}
+inline
+void ItemList::View::MatchField(QuantumJsonImpl__::FieldNameMatcher &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_102;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [i]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_103:
+	// Currently matched prefix [it]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [ite]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'm': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [item]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 's': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [items]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_107;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Matched field [items]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 0;
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void ItemList::MergeFromJson(InputIteratorType it,
+                             InputIteratorType end)
+{
+	QuantumJsonImpl__::Parser<InputIteratorType> parser(it, end);
+	parser.ParseObject(*this);
+	
+	// Throw when parsing fails
+	if (parser.errorCode != QuantumJsonImpl__::ErrorCode::NoError)
+	{
+		throw QuantumJsonImpl__::JsonError(parser.errorCode);
+	}
+}
+template <typename OutputIteratorType>
+void ItemList::SerializeTo(
+    QuantumJsonImpl__::Serializer<OutputIteratorType> &s
+    ) const
+{
+	
+	// Render field items
+	s.WriteLiteral("{\"items\":");
+	s.SerializeValue(this->items);
+	s.Put('}');
+}
+template <typename InputIteratorType, bool Trusted>
+inline
+void Listing::ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_102;
+		case 'b': goto state_103;
+		case 'i': goto state_104;
+		case 'k': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [a]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'f': goto state_106;
+		case 'r': goto state_107;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [af]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [aft]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_109;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Currently matched prefix [afte]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_110;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Currently matched prefix [after]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_111;
+		default: goto state_unknown_field_matching;
+	}
+	state_111:
+	// Matched field [after]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->after);
+	return;
+	state_107:
+	// Currently matched prefix [ar]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_112;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_112:
+	// Currently matched prefix [arr]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_113;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_113:
+	// Currently matched prefix [arra]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'y': goto state_114;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_114:
+	// Currently matched prefix [array]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '-': goto state_115;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_115:
+	// Currently matched prefix [array-]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'f': goto state_116;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_116:
+	// Currently matched prefix [array-f]
+	if (parser.FieldNameAtEnd(7))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_117;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_117:
+	// Currently matched prefix [array-fi]
+	if (parser.FieldNameAtEnd(8))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_118;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_118:
+	// Currently matched prefix [array-fie]
+	if (parser.FieldNameAtEnd(9))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_119;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_119:
+	// Currently matched prefix [array-fiel]
+	if (parser.FieldNameAtEnd(10))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_120;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_120:
+	// Currently matched prefix [array-field]
+	if (parser.FieldNameAtEnd(11))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_121;
+		default: goto state_unknown_field_matching;
+	}
+	state_121:
+	// Matched field [array-field]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->arrayField);
+	return;
+	state_103:
+	// Currently matched prefix [b]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_122;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_122:
+	// Currently matched prefix [be]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'f': goto state_123;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_123:
+	// Currently matched prefix [bef]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'o': goto state_124;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_124:
+	// Currently matched prefix [befo]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_125;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_125:
+	// Currently matched prefix [befor]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_126;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_126:
+	// Currently matched prefix [before]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_127;
+		default: goto state_unknown_field_matching;
+	}
+	state_127:
+	// Matched field [before]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->before);
+	return;
+	state_104:
+	// Currently matched prefix [i]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_128;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_128:
+	// Currently matched prefix [it]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_129;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_129:
+	// Currently matched prefix [ite]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'm': goto state_130;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_130:
+	// Currently matched prefix [item]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_131;
+		default: goto state_unknown_field_matching;
+	}
+	state_131:
+	// Matched field [item]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->item);
+	return;
+	state_105:
+	// Currently matched prefix [k]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_132;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_132:
+	// Currently matched prefix [ki]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'n': goto state_133;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_133:
+	// Currently matched prefix [kin]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_134;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_134:
+	// Currently matched prefix [kind]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_135;
+		default: goto state_unknown_field_matching;
+	}
+	state_135:
+	// Matched field [kind]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->kind);
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void Listing::ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_102;
+		case 'b': goto state_103;
+		case 'i': goto state_104;
+		case 'k': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [a]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'f': goto state_106;
+		case 'r': goto state_107;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [af]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [aft]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_109;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Currently matched prefix [afte]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_110;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Currently matched prefix [after]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_111;
+		default: goto state_unknown_field_matching;
+	}
+	state_111:
+	// Matched field [after]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_after));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(Listing::after)*>(nullptr));
+		return;
+	}
+	return;
+	state_107:
+	// Currently matched prefix [ar]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_112;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_112:
+	// Currently matched prefix [arr]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_113;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_113:
+	// Currently matched prefix [arra]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'y': goto state_114;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_114:
+	// Currently matched prefix [array]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '-': goto state_115;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_115:
+	// Currently matched prefix [array-]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'f': goto state_116;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_116:
+	// Currently matched prefix [array-f]
+	if (parser.FieldNameAtEnd(7))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_117;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_117:
+	// Currently matched prefix [array-fi]
+	if (parser.FieldNameAtEnd(8))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_118;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_118:
+	// Currently matched prefix [array-fie]
+	if (parser.FieldNameAtEnd(9))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_119;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_119:
+	// Currently matched prefix [array-fiel]
+	if (parser.FieldNameAtEnd(10))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_120;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_120:
+	// Currently matched prefix [array-field]
+	if (parser.FieldNameAtEnd(11))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_121;
+		default: goto state_unknown_field_matching;
+	}
+	state_121:
+	// Matched field [array-field]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_arrayField));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(Listing::arrayField)*>(nullptr));
+		return;
+	}
+	return;
+	state_103:
+	// Currently matched prefix [b]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_122;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_122:
+	// Currently matched prefix [be]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'f': goto state_123;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_123:
+	// Currently matched prefix [bef]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'o': goto state_124;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_124:
+	// Currently matched prefix [befo]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_125;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_125:
+	// Currently matched prefix [befor]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_126;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_126:
+	// Currently matched prefix [before]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_127;
+		default: goto state_unknown_field_matching;
+	}
+	state_127:
+	// Matched field [before]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_before));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(Listing::before)*>(nullptr));
+		return;
+	}
+	return;
+	state_104:
+	// Currently matched prefix [i]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_128;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_128:
+	// Currently matched prefix [it]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_129;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_129:
+	// Currently matched prefix [ite]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'm': goto state_130;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_130:
+	// Currently matched prefix [item]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_131;
+		default: goto state_unknown_field_matching;
+	}
+	state_131:
+	// Matched field [item]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_item));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(Listing::item)*>(nullptr));
+		return;
+	}
+	return;
+	state_105:
+	// Currently matched prefix [k]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_132;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_132:
+	// Currently matched prefix [ki]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'n': goto state_133;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_133:
+	// Currently matched prefix [kin]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_134;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_134:
+	// Currently matched prefix [kind]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_135;
+		default: goto state_unknown_field_matching;
+	}
+	state_135:
+	// Matched field [kind]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_kind));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(Listing::kind)*>(nullptr));
+		return;
+	}
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void Listing::ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator)
+{
+	size_t objectFieldsEnd = allocator.GetObjectSize();
+	allocator.PopObject();
+	while (allocator.GetCurIdx() != objectFieldsEnd)
+	{
+		int fieldTag = allocator.GetFieldTag();
+		switch(static_cast<__QuantumJsonFieldTag>(fieldTag))
+		{
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_kind:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->kind);
+				break;
+			}
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_item:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->item);
+				break;
+			}
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_before:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->before);
+				break;
+			}
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_after:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->after);
+				break;
+			}
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_arrayField:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->arrayField);
+				break;
+			}
+			default:
+			; // Should not happen
+		}
+	}
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(Listing::kind)>::Type Listing::View::kind() const
+{
+	return FieldValue<decltype(Listing::kind)>(0, &MatchField, false);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(Listing::item)>::Type Listing::View::item() const
+{
+	return FieldValue<decltype(Listing::item)>(1, &MatchField, false);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(Listing::before)>::Type Listing::View::before() const
+{
+	return FieldValue<decltype(Listing::before)>(2, &MatchField, false);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(Listing::after)>::Type Listing::View::after() const
+{
+	return FieldValue<decltype(Listing::after)>(3, &MatchField, false);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(Listing::arrayField)>::Type Listing::View::arrayField() const
+{
+	return FieldValue<decltype(Listing::arrayField)>(4, &MatchField, false);
+}
+inline
+void Listing::View::MatchField(QuantumJsonImpl__::FieldNameMatcher &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_102;
+		case 'b': goto state_103;
+		case 'i': goto state_104;
+		case 'k': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [a]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'f': goto state_106;
+		case 'r': goto state_107;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [af]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [aft]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_109;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Currently matched prefix [afte]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_110;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Currently matched prefix [after]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_111;
+		default: goto state_unknown_field_matching;
+	}
+	state_111:
+	// Matched field [after]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 3;
+	return;
+	state_107:
+	// Currently matched prefix [ar]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_112;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_112:
+	// Currently matched prefix [arr]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_113;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_113:
+	// Currently matched prefix [arra]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'y': goto state_114;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_114:
+	// Currently matched prefix [array]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '-': goto state_115;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_115:
+	// Currently matched prefix [array-]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'f': goto state_116;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_116:
+	// Currently matched prefix [array-f]
+	if (parser.FieldNameAtEnd(7))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_117;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_117:
+	// Currently matched prefix [array-fi]
+	if (parser.FieldNameAtEnd(8))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_118;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_118:
+	// Currently matched prefix [array-fie]
+	if (parser.FieldNameAtEnd(9))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_119;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_119:
+	// Currently matched prefix [array-fiel]
+	if (parser.FieldNameAtEnd(10))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_120;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_120:
+	// Currently matched prefix [array-field]
+	if (parser.FieldNameAtEnd(11))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_121;
+		default: goto state_unknown_field_matching;
+	}
+	state_121:
+	// Matched field [array-field]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 4;
+	return;
+	state_103:
+	// Currently matched prefix [b]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_122;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_122:
+	// Currently matched prefix [be]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'f': goto state_123;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_123:
+	// Currently matched prefix [bef]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'o': goto state_124;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_124:
+	// Currently matched prefix [befo]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_125;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_125:
+	// Currently matched prefix [befor]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_126;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_126:
+	// Currently matched prefix [before]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_127;
+		default: goto state_unknown_field_matching;
+	}
+	state_127:
+	// Matched field [before]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 2;
+	return;
+	state_104:
+	// Currently matched prefix [i]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_128;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_128:
+	// Currently matched prefix [it]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_129;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_129:
+	// Currently matched prefix [ite]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'm': goto state_130;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_130:
+	// Currently matched prefix [item]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_131;
+		default: goto state_unknown_field_matching;
+	}
+	state_131:
+	// Matched field [item]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 1;
+	return;
+	state_105:
+	// Currently matched prefix [k]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_132;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_132:
+	// Currently matched prefix [ki]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'n': goto state_133;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_133:
+	// Currently matched prefix [kin]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_134;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_134:
+	// Currently matched prefix [kind]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_135;
+		default: goto state_unknown_field_matching;
+	}
+	state_135:
+	// Matched field [kind]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 0;
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void Listing::MergeFromJson(InputIteratorType it,
+                            InputIteratorType end)
+{
+	QuantumJsonImpl__::Parser<InputIteratorType> parser(it, end);
+	parser.ParseObject(*this);
+	
+	// Throw when parsing fails
+	if (parser.errorCode != QuantumJsonImpl__::ErrorCode::NoError)
+	{
+		throw QuantumJsonImpl__::JsonError(parser.errorCode);
+	}
+}
+template <typename OutputIteratorType>
+void Listing::SerializeTo(
+    QuantumJsonImpl__::Serializer<OutputIteratorType> &s
+    ) const
+{
+	
+	// Render field kind
+	s.WriteLiteral("{\"kind\":");
+	s.SerializeValue(this->kind);
+	
+	// Render field item
+	s.WriteLiteral(",\"item\":");
+	s.SerializeValue(this->item);
+	
+	// Render field before
+	s.WriteLiteral(",\"before\":");
+	s.SerializeValue(this->before);
+	
+	// Render field after
+	s.WriteLiteral(",\"after\":");
+	s.SerializeValue(this->after);
+	
+	// Render field arrayField
+	s.WriteLiteral(",\"array-field\":");
+	s.SerializeValue(this->arrayField);
+	s.Put('}');
+}
+template <typename InputIteratorType, bool Trusted>
+inline
+void FieldNameFSMTester::ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_102;
+		case 'b': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [a]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_104;
+		case 'b': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [aa]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [aaa]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_107;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Currently matched prefix [aaaa]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [aaaaa]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_109;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Currently matched prefix [aaaaaa]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_110;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Matched field [aaaaaa]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->aaaaaa);
+	return;
+	state_105:
+	// Currently matched prefix [ab]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'c': goto state_111;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_111:
+	// Currently matched prefix [abc]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_112;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_112:
+	// Currently matched prefix [abcd]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_113;
+		case 'q': goto state_114;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_113:
+	// Currently matched prefix [abcde]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'f': goto state_115;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_115:
+	// Currently matched prefix [abcdef]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_116;
+		default: goto state_unknown_field_matching;
+	}
+	state_116:
+	// Matched field [abcdef]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->abcdef);
+	return;
+	state_114:
+	// Currently matched prefix [abcdq]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'q': goto state_117;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_117:
+	// Currently matched prefix [abcdqq]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_118;
+		default: goto state_unknown_field_matching;
+	}
+	state_118:
+	// Matched field [abcdqq]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->abcdqq);
+	return;
+	state_103:
+	// Currently matched prefix [b]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'b': goto state_119;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_119:
+	// Currently matched prefix [bb]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'c': goto state_120;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_120:
+	// Currently matched prefix [bbc]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_121;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_121:
+	// Currently matched prefix [bbcd]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_122;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_122:
+	// Currently matched prefix [bbcde]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'f': goto state_123;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_123:
+	// Currently matched prefix [bbcdef]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_124;
+		default: goto state_unknown_field_matching;
+	}
+	state_124:
+	// Matched field [bbcdef]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->bbcdef);
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void FieldNameFSMTester::ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_102;
+		case 'b': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [a]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_104;
+		case 'b': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [aa]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [aaa]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_107;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Currently matched prefix [aaaa]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [aaaaa]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_109;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Currently matched prefix [aaaaaa]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_110;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Matched field [aaaaaa]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_aaaaaa));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(FieldNameFSMTester::aaaaaa)*>(nullptr));
+		return;
+	}
+	return;
+	state_105:
+	// Currently matched prefix [ab]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'c': goto state_111;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_111:
+	// Currently matched prefix [abc]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_112;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_112:
+	// Currently matched prefix [abcd]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_113;
+		case 'q': goto state_114;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_113:
+	// Currently matched prefix [abcde]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'f': goto state_115;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_115:
+	// Currently matched prefix [abcdef]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_116;
+		default: goto state_unknown_field_matching;
+	}
+	state_116:
+	// Matched field [abcdef]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_abcdef));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(FieldNameFSMTester::abcdef)*>(nullptr));
+		return;
+	}
+	return;
+	state_114:
+	// Currently matched prefix [abcdq]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'q': goto state_117;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_117:
+	// Currently matched prefix [abcdqq]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_118;
+		default: goto state_unknown_field_matching;
+	}
+	state_118:
+	// Matched field [abcdqq]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_abcdqq));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(FieldNameFSMTester::abcdqq)*>(nullptr));
+		return;
+	}
+	return;
+	state_103:
+	// Currently matched prefix [b]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'b': goto state_119;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_119:
+	// Currently matched prefix [bb]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'c': goto state_120;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_120:
+	// Currently matched prefix [bbc]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_121;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_121:
+	// Currently matched prefix [bbcd]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_122;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_122:
+	// Currently matched prefix [bbcde]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'f': goto state_123;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_123:
+	// Currently matched prefix [bbcdef]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_124;
+		default: goto state_unknown_field_matching;
+	}
+	state_124:
+	// Matched field [bbcdef]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_bbcdef));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(FieldNameFSMTester::bbcdef)*>(nullptr));
+		return;
+	}
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void FieldNameFSMTester::ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator)
+{
+	size_t objectFieldsEnd = allocator.GetObjectSize();
+	allocator.PopObject();
+	while (allocator.GetCurIdx() != objectFieldsEnd)
+	{
+		int fieldTag = allocator.GetFieldTag();
+		switch(static_cast<__QuantumJsonFieldTag>(fieldTag))
+		{
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_abcdef:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->abcdef);
+				break;
+			}
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_aaaaaa:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->aaaaaa);
+				break;
+			}
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_bbcdef:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->bbcdef);
+				break;
+			}
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_abcdqq:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->abcdqq);
+				break;
+			}
+			default:
+			; // Should not happen
+		}
+	}
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(FieldNameFSMTester::abcdef)>::Type FieldNameFSMTester::View::abcdef() const
+{
+	return FieldValue<decltype(FieldNameFSMTester::abcdef)>(0, &MatchField, false);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(FieldNameFSMTester::aaaaaa)>::Type FieldNameFSMTester::View::aaaaaa() const
+{
+	return FieldValue<decltype(FieldNameFSMTester::aaaaaa)>(1, &MatchField, false);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(FieldNameFSMTester::bbcdef)>::Type FieldNameFSMTester::View::bbcdef() const
+{
+	return FieldValue<decltype(FieldNameFSMTester::bbcdef)>(2, &MatchField, false);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(FieldNameFSMTester::abcdqq)>::Type FieldNameFSMTester::View::abcdqq() const
+{
+	return FieldValue<decltype(FieldNameFSMTester::abcdqq)>(3, &MatchField, false);
+}
+inline
+void FieldNameFSMTester::View::MatchField(QuantumJsonImpl__::FieldNameMatcher &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_102;
+		case 'b': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [a]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_104;
+		case 'b': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [aa]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [aaa]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_107;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Currently matched prefix [aaaa]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [aaaaa]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_109;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Currently matched prefix [aaaaaa]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_110;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Matched field [aaaaaa]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 1;
+	return;
+	state_105:
+	// Currently matched prefix [ab]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'c': goto state_111;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_111:
+	// Currently matched prefix [abc]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_112;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_112:
+	// Currently matched prefix [abcd]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_113;
+		case 'q': goto state_114;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_113:
+	// Currently matched prefix [abcde]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'f': goto state_115;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_115:
+	// Currently matched prefix [abcdef]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_116;
+		default: goto state_unknown_field_matching;
+	}
+	state_116:
+	// Matched field [abcdef]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 0;
+	return;
+	state_114:
+	// Currently matched prefix [abcdq]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'q': goto state_117;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_117:
+	// Currently matched prefix [abcdqq]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_118;
+		default: goto state_unknown_field_matching;
+	}
+	state_118:
+	// Matched field [abcdqq]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 3;
+	return;
+	state_103:
+	// Currently matched prefix [b]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'b': goto state_119;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_119:
+	// Currently matched prefix [bb]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'c': goto state_120;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_120:
+	// Currently matched prefix [bbc]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_121;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_121:
+	// Currently matched prefix [bbcd]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_122;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_122:
+	// Currently matched prefix [bbcde]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'f': goto state_123;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_123:
+	// Currently matched prefix [bbcdef]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_124;
+		default: goto state_unknown_field_matching;
+	}
+	state_124:
+	// Matched field [bbcdef]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 2;
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void FieldNameFSMTester::MergeFromJson(InputIteratorType it,
+                                       InputIteratorType end)
+{
+	QuantumJsonImpl__::Parser<InputIteratorType> parser(it, end);
+	parser.ParseObject(*this);
+	
+	// Throw when parsing fails
+	if (parser.errorCode != QuantumJsonImpl__::ErrorCode::NoError)
+	{
+		throw QuantumJsonImpl__::JsonError(parser.errorCode);
+	}
+}
+template <typename OutputIteratorType>
+void FieldNameFSMTester::SerializeTo(
+    QuantumJsonImpl__::Serializer<OutputIteratorType> &s
+    ) const
+{
+	
+	// Render field abcdef
+	s.WriteLiteral("{\"abcdef\":");
+	s.SerializeValue(this->abcdef);
+	
+	// Render field aaaaaa
+	s.WriteLiteral(",\"aaaaaa\":");
+	s.SerializeValue(this->aaaaaa);
+	
+	// Render field bbcdef
+	s.WriteLiteral(",\"bbcdef\":");
+	s.SerializeValue(this->bbcdef);
+	
+	// Render field abcdqq
+	s.WriteLiteral(",\"abcdqq\":");
+	s.SerializeValue(this->abcdqq);
+	s.Put('}');
+}
+template <typename InputIteratorType, bool Trusted>
+inline
+void AttributeTester::ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_102;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [a]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_103:
+	// Currently matched prefix [at]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [att]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [attr]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '-': goto state_106;
+		case '1': goto state_107;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [attr-]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '2': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [attr-2]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_109;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Matched field [attr-2]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->attr2);
+	return;
+	state_107:
+	// Currently matched prefix [attr1]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_110;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Matched field [attr1]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->attr1);
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void AttributeTester::ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_102;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [a]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_103:
+	// Currently matched prefix [at]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [att]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [attr]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '-': goto state_106;
+		case '1': goto state_107;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [attr-]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '2': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [attr-2]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_109;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Matched field [attr-2]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_attr2));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(AttributeTester::attr2)*>(nullptr));
+		return;
+	}
+	return;
+	state_107:
+	// Currently matched prefix [attr1]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_110;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Matched field [attr1]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_attr1));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(AttributeTester::attr1)*>(nullptr));
+		return;
+	}
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void AttributeTester::ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator)
+{
+	size_t objectFieldsEnd = allocator.GetObjectSize();
+	allocator.PopObject();
+	while (allocator.GetCurIdx() != objectFieldsEnd)
+	{
+		int fieldTag = allocator.GetFieldTag();
+		switch(static_cast<__QuantumJsonFieldTag>(fieldTag))
+		{
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_attr1:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->attr1);
+				break;
+			}
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_attr2:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->attr2);
+				break;
+			}
+			default:
+			; // Should not happen
+		}
+	}
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(AttributeTester::attr1)>::Type AttributeTester::View::attr1() const
+{
+	return FieldValue<decltype(AttributeTester::attr1)>(0, &MatchField, false);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(AttributeTester::attr2)>::Type AttributeTester::View::attr2() const
+{
+	return FieldValue<decltype(AttributeTester::attr2)>(1, &MatchField, false);
+}
+inline
+void AttributeTester::View::MatchField(QuantumJsonImpl__::FieldNameMatcher &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_102;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [a]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_103:
+	// Currently matched prefix [at]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [att]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [attr]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '-': goto state_106;
+		case '1': goto state_107;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [attr-]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '2': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [attr-2]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_109;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Matched field [attr-2]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 1;
+	return;
+	state_107:
+	// Currently matched prefix [attr1]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_110;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Matched field [attr1]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 0;
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void AttributeTester::MergeFromJson(InputIteratorType it,
+                                    InputIteratorType end)
+{
+	QuantumJsonImpl__::Parser<InputIteratorType> parser(it, end);
+	parser.ParseObject(*this);
+	
+	// Throw when parsing fails
+	if (parser.errorCode != QuantumJsonImpl__::ErrorCode::NoError)
+	{
+		throw QuantumJsonImpl__::JsonError(parser.errorCode);
+	}
+}
+template <typename OutputIteratorType>
+void AttributeTester::SerializeTo(
+    QuantumJsonImpl__::Serializer<OutputIteratorType> &s
+    ) const
+{
+	
+	// Render field attr1
+	s.WriteLiteral("{\"attr1\":");
+	s.SerializeValue(this->attr1);
+	
+	// Render field attr2
+	s.WriteLiteral(",\"attr-2\":");
+	s.SerializeValue(this->attr2);
+	s.Put('}');
+}
+template <typename InputIteratorType, bool Trusted>
+inline
+void SkipNullTester::ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_102;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [a]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_103:
+	// Currently matched prefix [at]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [att]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [attr]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '_': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [attr_]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_107;
+		case 'r': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Currently matched prefix [attr_a]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'c': goto state_109;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Currently matched prefix [attr_ac]
+	if (parser.FieldNameAtEnd(7))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'c': goto state_110;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Currently matched prefix [attr_acc]
+	if (parser.FieldNameAtEnd(8))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_111;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_111:
+	// Currently matched prefix [attr_acce]
+	if (parser.FieldNameAtEnd(9))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'p': goto state_112;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_112:
+	// Currently matched prefix [attr_accep]
+	if (parser.FieldNameAtEnd(10))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_113;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_113:
+	// Currently matched prefix [attr_accept]
+	if (parser.FieldNameAtEnd(11))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_114;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_114:
+	// Currently matched prefix [attr_accepti]
+	if (parser.FieldNameAtEnd(12))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'n': goto state_115;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_115:
+	// Currently matched prefix [attr_acceptin]
+	if (parser.FieldNameAtEnd(13))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'g': goto state_116;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_116:
+	// Currently matched prefix [attr_accepting]
+	if (parser.FieldNameAtEnd(14))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '_': goto state_117;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_117:
+	// Currently matched prefix [attr_accepting_]
+	if (parser.FieldNameAtEnd(15))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'n': goto state_118;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_118:
+	// Currently matched prefix [attr_accepting_n]
+	if (parser.FieldNameAtEnd(16))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'u': goto state_119;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_119:
+	// Currently matched prefix [attr_accepting_nu]
+	if (parser.FieldNameAtEnd(17))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_120;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_120:
+	// Currently matched prefix [attr_accepting_nul]
+	if (parser.FieldNameAtEnd(18))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_121;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_121:
+	// Currently matched prefix [attr_accepting_null]
+	if (parser.FieldNameAtEnd(19))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_122;
+		default: goto state_unknown_field_matching;
+	}
+	state_122:
+	// Matched field [attr_accepting_null]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Skip null values for this field.
+	{
+		bool skipped = false;
+		parser.MaybeSkipNull(&skipped);
+		if (skipped)
+		{
+			return;
+		}
+	}
+	parser.ParseValueInto(this->attr_accepting_null);
+	return;
+	state_108:
+	// Currently matched prefix [attr_r]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_123;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_123:
+	// Currently matched prefix [attr_re]
+	if (parser.FieldNameAtEnd(7))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'g': goto state_124;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_124:
+	// Currently matched prefix [attr_reg]
+	if (parser.FieldNameAtEnd(8))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'u': goto state_125;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_125:
+	// Currently matched prefix [attr_regu]
+	if (parser.FieldNameAtEnd(9))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_126;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_126:
+	// Currently matched prefix [attr_regul]
+	if (parser.FieldNameAtEnd(10))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_127;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_127:
+	// Currently matched prefix [attr_regula]
+	if (parser.FieldNameAtEnd(11))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_128;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_128:
+	// Currently matched prefix [attr_regular]
+	if (parser.FieldNameAtEnd(12))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_129;
+		default: goto state_unknown_field_matching;
+	}
+	state_129:
+	// Matched field [attr_regular]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->attr_regular);
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void SkipNullTester::ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_102;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [a]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_103:
+	// Currently matched prefix [at]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [att]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [attr]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '_': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [attr_]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_107;
+		case 'r': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Currently matched prefix [attr_a]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'c': goto state_109;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Currently matched prefix [attr_ac]
+	if (parser.FieldNameAtEnd(7))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'c': goto state_110;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Currently matched prefix [attr_acc]
+	if (parser.FieldNameAtEnd(8))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_111;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_111:
+	// Currently matched prefix [attr_acce]
+	if (parser.FieldNameAtEnd(9))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'p': goto state_112;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_112:
+	// Currently matched prefix [attr_accep]
+	if (parser.FieldNameAtEnd(10))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_113;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_113:
+	// Currently matched prefix [attr_accept]
+	if (parser.FieldNameAtEnd(11))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_114;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_114:
+	// Currently matched prefix [attr_accepti]
+	if (parser.FieldNameAtEnd(12))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'n': goto state_115;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_115:
+	// Currently matched prefix [attr_acceptin]
+	if (parser.FieldNameAtEnd(13))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'g': goto state_116;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_116:
+	// Currently matched prefix [attr_accepting]
+	if (parser.FieldNameAtEnd(14))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '_': goto state_117;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_117:
+	// Currently matched prefix [attr_accepting_]
+	if (parser.FieldNameAtEnd(15))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'n': goto state_118;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_118:
+	// Currently matched prefix [attr_accepting_n]
+	if (parser.FieldNameAtEnd(16))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'u': goto state_119;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_119:
+	// Currently matched prefix [attr_accepting_nu]
+	if (parser.FieldNameAtEnd(17))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_120;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_120:
+	// Currently matched prefix [attr_accepting_nul]
+	if (parser.FieldNameAtEnd(18))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_121;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_121:
+	// Currently matched prefix [attr_accepting_null]
+	if (parser.FieldNameAtEnd(19))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_122;
+		default: goto state_unknown_field_matching;
+	}
+	state_122:
+	// Matched field [attr_accepting_null]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_attr_accepting_null));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(SkipNullTester::attr_accepting_null)*>(nullptr));
+		return;
+	}
+	return;
+	state_108:
+	// Currently matched prefix [attr_r]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_123;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_123:
+	// Currently matched prefix [attr_re]
+	if (parser.FieldNameAtEnd(7))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'g': goto state_124;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_124:
+	// Currently matched prefix [attr_reg]
+	if (parser.FieldNameAtEnd(8))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'u': goto state_125;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_125:
+	// Currently matched prefix [attr_regu]
+	if (parser.FieldNameAtEnd(9))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_126;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_126:
+	// Currently matched prefix [attr_regul]
+	if (parser.FieldNameAtEnd(10))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_127;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_127:
+	// Currently matched prefix [attr_regula]
+	if (parser.FieldNameAtEnd(11))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_128;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_128:
+	// Currently matched prefix [attr_regular]
+	if (parser.FieldNameAtEnd(12))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_129;
+		default: goto state_unknown_field_matching;
+	}
+	state_129:
+	// Matched field [attr_regular]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_attr_regular));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(SkipNullTester::attr_regular)*>(nullptr));
+		return;
+	}
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void SkipNullTester::ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator)
+{
+	size_t objectFieldsEnd = allocator.GetObjectSize();
+	allocator.PopObject();
+	while (allocator.GetCurIdx() != objectFieldsEnd)
+	{
+		int fieldTag = allocator.GetFieldTag();
+		switch(static_cast<__QuantumJsonFieldTag>(fieldTag))
+		{
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_attr_accepting_null:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->attr_accepting_null);
+				break;
+			}
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_attr_regular:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->attr_regular);
+				break;
+			}
+			default:
+			; // Should not happen
+		}
+	}
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(SkipNullTester::attr_accepting_null)>::Type SkipNullTester::View::attr_accepting_null() const
+{
+	return FieldValue<decltype(SkipNullTester::attr_accepting_null)>(0, &MatchField, true);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(SkipNullTester::attr_regular)>::Type SkipNullTester::View::attr_regular() const
+{
+	return FieldValue<decltype(SkipNullTester::attr_regular)>(1, &MatchField, false);
+}
+inline
+void SkipNullTester::View::MatchField(QuantumJsonImpl__::FieldNameMatcher &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_102;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [a]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_103:
+	// Currently matched prefix [at]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [att]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [attr]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '_': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [attr_]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_107;
+		case 'r': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Currently matched prefix [attr_a]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'c': goto state_109;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Currently matched prefix [attr_ac]
+	if (parser.FieldNameAtEnd(7))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'c': goto state_110;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Currently matched prefix [attr_acc]
+	if (parser.FieldNameAtEnd(8))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_111;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_111:
+	// Currently matched prefix [attr_acce]
+	if (parser.FieldNameAtEnd(9))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'p': goto state_112;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_112:
+	// Currently matched prefix [attr_accep]
+	if (parser.FieldNameAtEnd(10))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_113;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_113:
+	// Currently matched prefix [attr_accept]
+	if (parser.FieldNameAtEnd(11))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_114;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_114:
+	// Currently matched prefix [attr_accepti]
+	if (parser.FieldNameAtEnd(12))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'n': goto state_115;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_115:
+	// Currently matched prefix [attr_acceptin]
+	if (parser.FieldNameAtEnd(13))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'g': goto state_116;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_116:
+	// Currently matched prefix [attr_accepting]
+	if (parser.FieldNameAtEnd(14))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '_': goto state_117;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_117:
+	// Currently matched prefix [attr_accepting_]
+	if (parser.FieldNameAtEnd(15))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'n': goto state_118;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_118:
+	// Currently matched prefix [attr_accepting_n]
+	if (parser.FieldNameAtEnd(16))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'u': goto state_119;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_119:
+	// Currently matched prefix [attr_accepting_nu]
+	if (parser.FieldNameAtEnd(17))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_120;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_120:
+	// Currently matched prefix [attr_accepting_nul]
+	if (parser.FieldNameAtEnd(18))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_121;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_121:
+	// Currently matched prefix [attr_accepting_null]
+	if (parser.FieldNameAtEnd(19))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_122;
+		default: goto state_unknown_field_matching;
+	}
+	state_122:
+	// Matched field [attr_accepting_null]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 0;
+	return;
+	state_108:
+	// Currently matched prefix [attr_r]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_123;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_123:
+	// Currently matched prefix [attr_re]
+	if (parser.FieldNameAtEnd(7))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'g': goto state_124;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_124:
+	// Currently matched prefix [attr_reg]
+	if (parser.FieldNameAtEnd(8))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'u': goto state_125;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_125:
+	// Currently matched prefix [attr_regu]
+	if (parser.FieldNameAtEnd(9))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_126;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_126:
+	// Currently matched prefix [attr_regul]
+	if (parser.FieldNameAtEnd(10))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_127;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_127:
+	// Currently matched prefix [attr_regula]
+	if (parser.FieldNameAtEnd(11))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_128;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_128:
+	// Currently matched prefix [attr_regular]
+	if (parser.FieldNameAtEnd(12))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_129;
+		default: goto state_unknown_field_matching;
+	}
+	state_129:
+	// Matched field [attr_regular]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 1;
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void SkipNullTester::MergeFromJson(InputIteratorType it,
+                                   InputIteratorType end)
+{
+	QuantumJsonImpl__::Parser<InputIteratorType> parser(it, end);
+	parser.ParseObject(*this);
+	
+	// Throw when parsing fails
+	if (parser.errorCode != QuantumJsonImpl__::ErrorCode::NoError)
+	{
+		throw QuantumJsonImpl__::JsonError(parser.errorCode);
+	}
+}
+template <typename OutputIteratorType>
+void SkipNullTester::SerializeTo(
+    QuantumJsonImpl__::Serializer<OutputIteratorType> &s
+    ) const
+{
+	
+	// Render field attr_accepting_null
+	s.WriteLiteral("{\"attr_accepting_null\":");
+	s.SerializeValue(this->attr_accepting_null);
+	
+	// Render field attr_regular
+	s.WriteLiteral(",\"attr_regular\":");
+	s.SerializeValue(this->attr_regular);
+	s.Put('}');
+}
+template <typename InputIteratorType, bool Trusted>
+inline
+void AAAAAA::ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'f': goto state_102;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [f]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_103:
+	// Currently matched prefix [fi]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [fie]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [fiel]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [field]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_107;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Matched field [field]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->field);
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void AAAAAA::ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'f': goto state_102;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [f]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_103:
+	// Currently matched prefix [fi]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [fie]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [fiel]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [field]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_107;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Matched field [field]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_field));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(AAAAAA::field)*>(nullptr));
+		return;
+	}
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void AAAAAA::ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator)
+{
+	size_t objectFieldsEnd = allocator.GetObjectSize();
+	allocator.PopObject();
+	while (allocator.GetCurIdx() != objectFieldsEnd)
+	{
+		int fieldTag = allocator.GetFieldTag();
+		switch(static_cast<__QuantumJsonFieldTag>(fieldTag))
+		{
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_field:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->field);
+				break;
+			}
+			default:
+			; // Should not happen
+		}
+	}
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(AAAAAA::field)>::Type AAAAAA::View::field() const
+{
+	return FieldValue<decltype(AAAAAA::field)>(0, &MatchField, false);
+}
+inline
+void AAAAAA::View::MatchField(QuantumJsonImpl__::FieldNameMatcher &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'f': goto state_102;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [f]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_103:
+	// Currently matched prefix [fi]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [fie]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [fiel]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [field]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_107;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Matched field [field]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 0;
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void AAAAAA::MergeFromJson(InputIteratorType it,
+                           InputIteratorType end)
+{
+	QuantumJsonImpl__::Parser<InputIteratorType> parser(it, end);
+	parser.ParseObject(*this);
+	
+	// Throw when parsing fails
+	if (parser.errorCode != QuantumJsonImpl__::ErrorCode::NoError)
+	{
+		throw QuantumJsonImpl__::JsonError(parser.errorCode);
+	}
+}
+template <typename OutputIteratorType>
+void AAAAAA::SerializeTo(
+    QuantumJsonImpl__::Serializer<OutputIteratorType> &s
+    ) const
+{
+	
+	// Render field field
+	s.WriteLiteral("{\"field\":");
+	s.SerializeValue(this->field);
+	s.Put('}');
+}
+template <typename InputIteratorType, bool Trusted>
+inline
+void FieldTypes::ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_102;
+		case 'i': goto state_103;
+		case 's': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [d]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'o': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [do]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'u': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [dou]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'b': goto state_107;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Currently matched prefix [doub]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [doubl]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_109;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Currently matched prefix [double]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'F': goto state_110;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Currently matched prefix [doubleF]
+	if (parser.FieldNameAtEnd(7))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_111;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_111:
+	// Currently matched prefix [doubleFi]
+	if (parser.FieldNameAtEnd(8))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_112;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_112:
+	// Currently matched prefix [doubleFie]
+	if (parser.FieldNameAtEnd(9))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_113;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_113:
+	// Currently matched prefix [doubleFiel]
+	if (parser.FieldNameAtEnd(10))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_114;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_114:
+	// Currently matched prefix [doubleField]
+	if (parser.FieldNameAtEnd(11))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_115;
+		default: goto state_unknown_field_matching;
+	}
+	state_115:
+	// Matched field [doubleField]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->doubleField);
+	return;
+	state_103:
+	// Currently matched prefix [i]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'n': goto state_116;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_116:
+	// Currently matched prefix [in]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_117;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_117:
+	// Currently matched prefix [int]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'F': goto state_118;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_118:
+	// Currently matched prefix [intF]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_119;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_119:
+	// Currently matched prefix [intFi]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_120;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_120:
+	// Currently matched prefix [intFie]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_121;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_121:
+	// Currently matched prefix [intFiel]
+	if (parser.FieldNameAtEnd(7))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_122;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_122:
+	// Currently matched prefix [intField]
+	if (parser.FieldNameAtEnd(8))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_123;
+		default: goto state_unknown_field_matching;
+	}
+	state_123:
+	// Matched field [intField]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->intField);
+	return;
+	state_104:
+	// Currently matched prefix [s]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_124;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_124:
+	// Currently matched prefix [st]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_125;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_125:
+	// Currently matched prefix [str]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_126;
+		case 'u': goto state_127;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_126:
+	// Currently matched prefix [stri]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'n': goto state_128;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_128:
+	// Currently matched prefix [strin]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'g': goto state_129;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_129:
+	// Currently matched prefix [string]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'F': goto state_130;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_130:
+	// Currently matched prefix [stringF]
+	if (parser.FieldNameAtEnd(7))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_131;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_131:
+	// Currently matched prefix [stringFi]
+	if (parser.FieldNameAtEnd(8))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_132;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_132:
+	// Currently matched prefix [stringFie]
+	if (parser.FieldNameAtEnd(9))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_133;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_133:
+	// Currently matched prefix [stringFiel]
+	if (parser.FieldNameAtEnd(10))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_134;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_134:
+	// Currently matched prefix [stringField]
+	if (parser.FieldNameAtEnd(11))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_135;
+		default: goto state_unknown_field_matching;
+	}
+	state_135:
+	// Matched field [stringField]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->stringField);
+	return;
+	state_127:
+	// Currently matched prefix [stru]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'c': goto state_136;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_136:
+	// Currently matched prefix [struc]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_137;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_137:
+	// Currently matched prefix [struct]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'F': goto state_138;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_138:
+	// Currently matched prefix [structF]
+	if (parser.FieldNameAtEnd(7))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_139;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_139:
+	// Currently matched prefix [structFi]
+	if (parser.FieldNameAtEnd(8))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_140;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_140:
+	// Currently matched prefix [structFie]
+	if (parser.FieldNameAtEnd(9))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_141;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_141:
+	// Currently matched prefix [structFiel]
+	if (parser.FieldNameAtEnd(10))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_142;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_142:
+	// Currently matched prefix [structField]
+	if (parser.FieldNameAtEnd(11))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_143;
+		default: goto state_unknown_field_matching;
+	}
+	state_143:
+	// Matched field [structField]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->structField);
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void FieldTypes::ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 's': goto state_102;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [s]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_103:
+	// Currently matched prefix [st]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [str]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_105;
+		case 'u': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [stri]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'n': goto state_107;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Currently matched prefix [strin]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'g': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [string]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'F': goto state_109;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Currently matched prefix [stringF]
+	if (parser.FieldNameAtEnd(7))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_110;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Currently matched prefix [stringFi]
+	if (parser.FieldNameAtEnd(8))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_111;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_111:
+	// Currently matched prefix [stringFie]
+	if (parser.FieldNameAtEnd(9))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_112;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_112:
+	// Currently matched prefix [stringFiel]
+	if (parser.FieldNameAtEnd(10))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_113;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_113:
+	// Currently matched prefix [stringField]
+	if (parser.FieldNameAtEnd(11))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_114;
+		default: goto state_unknown_field_matching;
+	}
+	state_114:
+	// Matched field [stringField]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_stringField));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(FieldTypes::stringField)*>(nullptr));
+		return;
+	}
+	return;
+	state_106:
+	// Currently matched prefix [stru]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'c': goto state_115;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_115:
+	// Currently matched prefix [struc]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_116;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_116:
+	// Currently matched prefix [struct]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'F': goto state_117;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_117:
+	// Currently matched prefix [structF]
+	if (parser.FieldNameAtEnd(7))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_118;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_118:
+	// Currently matched prefix [structFi]
+	if (parser.FieldNameAtEnd(8))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_119;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_119:
+	// Currently matched prefix [structFie]
+	if (parser.FieldNameAtEnd(9))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_120;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_120:
+	// Currently matched prefix [structFiel]
+	if (parser.FieldNameAtEnd(10))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_121;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_121:
+	// Currently matched prefix [structField]
+	if (parser.FieldNameAtEnd(11))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_122;
+		default: goto state_unknown_field_matching;
+	}
+	state_122:
+	// Matched field [structField]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_structField));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(FieldTypes::structField)*>(nullptr));
+		return;
+	}
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void FieldTypes::ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator)
+{
+	size_t objectFieldsEnd = allocator.GetObjectSize();
+	allocator.PopObject();
+	while (allocator.GetCurIdx() != objectFieldsEnd)
+	{
+		int fieldTag = allocator.GetFieldTag();
+		switch(static_cast<__QuantumJsonFieldTag>(fieldTag))
+		{
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_stringField:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->stringField);
+				break;
+			}
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_structField:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->structField);
+				break;
+			}
+			default:
+			; // Should not happen
+		}
+	}
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(FieldTypes::intField)>::Type FieldTypes::View::intField() const
+{
+	return FieldValue<decltype(FieldTypes::intField)>(0, &MatchField, false);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(FieldTypes::doubleField)>::Type FieldTypes::View::doubleField() const
+{
+	return FieldValue<decltype(FieldTypes::doubleField)>(1, &MatchField, false);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(FieldTypes::stringField)>::Type FieldTypes::View::stringField() const
+{
+	return FieldValue<decltype(FieldTypes::stringField)>(2, &MatchField, false);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(FieldTypes::structField)>::Type FieldTypes::View::structField() const
+{
+	return FieldValue<decltype(FieldTypes::structField)>(3, &MatchField, false);
+}
+inline
+void FieldTypes::View::MatchField(QuantumJsonImpl__::FieldNameMatcher &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_102;
+		case 'i': goto state_103;
+		case 's': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [d]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'o': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [do]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'u': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [dou]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'b': goto state_107;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Currently matched prefix [doub]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [doubl]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_109;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Currently matched prefix [double]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'F': goto state_110;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Currently matched prefix [doubleF]
+	if (parser.FieldNameAtEnd(7))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_111;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_111:
+	// Currently matched prefix [doubleFi]
+	if (parser.FieldNameAtEnd(8))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_112;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_112:
+	// Currently matched prefix [doubleFie]
+	if (parser.FieldNameAtEnd(9))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_113;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_113:
+	// Currently matched prefix [doubleFiel]
+	if (parser.FieldNameAtEnd(10))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_114;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_114:
+	// Currently matched prefix [doubleField]
+	if (parser.FieldNameAtEnd(11))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_115;
+		default: goto state_unknown_field_matching;
+	}
+	state_115:
+	// Matched field [doubleField]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 1;
+	return;
+	state_103:
+	// Currently matched prefix [i]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'n': goto state_116;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_116:
+	// Currently matched prefix [in]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_117;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_117:
+	// Currently matched prefix [int]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'F': goto state_118;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_118:
+	// Currently matched prefix [intF]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_119;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_119:
+	// Currently matched prefix [intFi]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_120;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_120:
+	// Currently matched prefix [intFie]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_121;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_121:
+	// Currently matched prefix [intFiel]
+	if (parser.FieldNameAtEnd(7))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_122;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_122:
+	// Currently matched prefix [intField]
+	if (parser.FieldNameAtEnd(8))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_123;
+		default: goto state_unknown_field_matching;
+	}
+	state_123:
+	// Matched field [intField]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 0;
+	return;
+	state_104:
+	// Currently matched prefix [s]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_124;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_124:
+	// Currently matched prefix [st]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_125;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_125:
+	// Currently matched prefix [str]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_126;
+		case 'u': goto state_127;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_126:
+	// Currently matched prefix [stri]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'n': goto state_128;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_128:
+	// Currently matched prefix [strin]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'g': goto state_129;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_129:
+	// Currently matched prefix [string]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'F': goto state_130;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_130:
+	// Currently matched prefix [stringF]
+	if (parser.FieldNameAtEnd(7))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_131;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_131:
+	// Currently matched prefix [stringFi]
+	if (parser.FieldNameAtEnd(8))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_132;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_132:
+	// Currently matched prefix [stringFie]
+	if (parser.FieldNameAtEnd(9))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_133;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_133:
+	// Currently matched prefix [stringFiel]
+	if (parser.FieldNameAtEnd(10))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_134;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_134:
+	// Currently matched prefix [stringField]
+	if (parser.FieldNameAtEnd(11))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_135;
+		default: goto state_unknown_field_matching;
+	}
+	state_135:
+	// Matched field [stringField]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 2;
+	return;
+	state_127:
+	// Currently matched prefix [stru]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'c': goto state_136;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_136:
+	// Currently matched prefix [struc]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_137;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_137:
+	// Currently matched prefix [struct]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'F': goto state_138;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_138:
+	// Currently matched prefix [structF]
+	if (parser.FieldNameAtEnd(7))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_139;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_139:
+	// Currently matched prefix [structFi]
+	if (parser.FieldNameAtEnd(8))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_140;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_140:
+	// Currently matched prefix [structFie]
+	if (parser.FieldNameAtEnd(9))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_141;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_141:
+	// Currently matched prefix [structFiel]
+	if (parser.FieldNameAtEnd(10))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'd': goto state_142;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_142:
+	// Currently matched prefix [structField]
+	if (parser.FieldNameAtEnd(11))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_143;
+		default: goto state_unknown_field_matching;
+	}
+	state_143:
+	// Matched field [structField]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 3;
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void FieldTypes::MergeFromJson(InputIteratorType it,
+                               InputIteratorType end)
+{
+	QuantumJsonImpl__::Parser<InputIteratorType> parser(it, end);
+	parser.ParseObject(*this);
+	
+	// Throw when parsing fails
+	if (parser.errorCode != QuantumJsonImpl__::ErrorCode::NoError)
+	{
+		throw QuantumJsonImpl__::JsonError(parser.errorCode);
+	}
+}
+template <typename OutputIteratorType>
+void FieldTypes::SerializeTo(
+    QuantumJsonImpl__::Serializer<OutputIteratorType> &s
+    ) const
+{
+	
+	// Render field intField
+	s.WriteLiteral("{\"intField\":");
+	s.SerializeValue(this->intField);
+	
+	// Render field doubleField
+	s.WriteLiteral(",\"doubleField\":");
+	s.SerializeValue(this->doubleField);
+	
+	// Render field stringField
+	s.WriteLiteral(",\"stringField\":");
+	s.SerializeValue(this->stringField);
+	
+	// Render field structField
+	s.WriteLiteral(",\"structField\":");
+	s.SerializeValue(this->structField);
+	s.Put('}');
+}
+template <typename InputIteratorType, bool Trusted>
+inline
+void IntegerTypes::ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_102;
+		case 'u': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [i]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '3': goto state_104;
+		case '6': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [i3]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '2': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [i32]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_107;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Matched field [i32]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->i32);
+	return;
+	state_105:
+	// Currently matched prefix [i6]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '4': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [i64]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_109;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Matched field [i64]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->i64);
+	return;
+	state_103:
+	// Currently matched prefix [u]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '3': goto state_110;
+		case '6': goto state_111;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Currently matched prefix [u3]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '2': goto state_112;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_112:
+	// Currently matched prefix [u32]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_113;
+		default: goto state_unknown_field_matching;
+	}
+	state_113:
+	// Matched field [u32]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->u32);
+	return;
+	state_111:
+	// Currently matched prefix [u6]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '4': goto state_114;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_114:
+	// Currently matched prefix [u64]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_115;
+		default: goto state_unknown_field_matching;
+	}
+	state_115:
+	// Matched field [u64]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->u64);
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void IntegerTypes::ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &parser)
+{
+	parser.SkipChar('"');
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void IntegerTypes::ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator)
+{
+	size_t objectFieldsEnd = allocator.GetObjectSize();
+	allocator.PopObject();
+	while (allocator.GetCurIdx() != objectFieldsEnd)
+	{
+		int fieldTag = allocator.GetFieldTag();
+		switch(static_cast<__QuantumJsonFieldTag>(fieldTag))
+		{
+			default:
+			; // Should not happen
+		}
+	}
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(IntegerTypes::i32)>::Type IntegerTypes::View::i32() const
+{
+	return FieldValue<decltype(IntegerTypes::i32)>(0, &MatchField, false);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(IntegerTypes::u32)>::Type IntegerTypes::View::u32() const
+{
+	return FieldValue<decltype(IntegerTypes::u32)>(1, &MatchField, false);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(IntegerTypes::i64)>::Type IntegerTypes::View::i64() const
+{
+	return FieldValue<decltype(IntegerTypes::i64)>(2, &MatchField, false);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(IntegerTypes::u64)>::Type IntegerTypes::View::u64() const
+{
+	return FieldValue<decltype(IntegerTypes::u64)>(3, &MatchField, false);
+}
+inline
+void IntegerTypes::View::MatchField(QuantumJsonImpl__::FieldNameMatcher &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_102;
+		case 'u': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [i]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '3': goto state_104;
+		case '6': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [i3]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '2': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [i32]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_107;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Matched field [i32]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 0;
+	return;
+	state_105:
+	// Currently matched prefix [i6]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '4': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [i64]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_109;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Matched field [i64]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 2;
+	return;
+	state_103:
+	// Currently matched prefix [u]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '3': goto state_110;
+		case '6': goto state_111;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Currently matched prefix [u3]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '2': goto state_112;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_112:
+	// Currently matched prefix [u32]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_113;
+		default: goto state_unknown_field_matching;
+	}
+	state_113:
+	// Matched field [u32]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 1;
+	return;
+	state_111:
+	// Currently matched prefix [u6]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '4': goto state_114;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_114:
+	// Currently matched prefix [u64]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_115;
+		default: goto state_unknown_field_matching;
+	}
+	state_115:
+	// Matched field [u64]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 3;
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void IntegerTypes::MergeFromJson(InputIteratorType it,
+                                 InputIteratorType end)
+{
+	QuantumJsonImpl__::Parser<InputIteratorType> parser(it, end);
+	parser.ParseObject(*this);
+	
+	// Throw when parsing fails
+	if (parser.errorCode != QuantumJsonImpl__::ErrorCode::NoError)
+	{
+		throw QuantumJsonImpl__::JsonError(parser.errorCode);
+	}
+}
+template <typename OutputIteratorType>
+void IntegerTypes::SerializeTo(
+    QuantumJsonImpl__::Serializer<OutputIteratorType> &s
+    ) const
+{
+	
+	// Render field i32
+	s.WriteLiteral("{\"i32\":");
+	s.SerializeValue(this->i32);
+	
+	// Render field u32
+	s.WriteLiteral(",\"u32\":");
+	s.SerializeValue(this->u32);
+	
+	// Render field i64
+	s.WriteLiteral(",\"i64\":");
+	s.SerializeValue(this->i64);
+	
+	// Render field u64
+	s.WriteLiteral(",\"u64\":");
+	s.SerializeValue(this->u64);
+	s.Put('}');
+}
+template <typename InputIteratorType, bool Trusted>
+inline
+void ReusedDocument::ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'g': goto state_102;
+		case 'i': goto state_103;
+		case 't': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [g]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [gr]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'o': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [gro]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'u': goto state_107;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Currently matched prefix [grou]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'p': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [group]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 's': goto state_109;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Currently matched prefix [groups]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_110;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Matched field [groups]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->groups);
+	return;
+	state_103:
+	// Currently matched prefix [i]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_111;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_111:
+	// Currently matched prefix [it]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_112;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_112:
+	// Currently matched prefix [ite]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'm': goto state_113;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_113:
+	// Currently matched prefix [item]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 's': goto state_114;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_114:
+	// Currently matched prefix [items]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_115;
+		default: goto state_unknown_field_matching;
+	}
+	state_115:
+	// Matched field [items]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->items);
+	return;
+	state_104:
+	// Currently matched prefix [t]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_116;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_116:
+	// Currently matched prefix [ti]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_117;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_117:
+	// Currently matched prefix [tit]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_118;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_118:
+	// Currently matched prefix [titl]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_119;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_119:
+	// Currently matched prefix [title]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_120;
+		default: goto state_unknown_field_matching;
+	}
+	state_120:
+	// Matched field [title]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->title);
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void ReusedDocument::ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_102;
+		case 't': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [i]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [it]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [ite]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'm': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [item]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 's': goto state_107;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Currently matched prefix [items]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_108;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Matched field [items]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_items));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(ReusedDocument::items)*>(nullptr));
+		return;
+	}
+	return;
+	state_103:
+	// Currently matched prefix [t]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_109;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Currently matched prefix [ti]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_110;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Currently matched prefix [tit]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_111;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_111:
+	// Currently matched prefix [titl]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_112;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_112:
+	// Currently matched prefix [title]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_113;
+		default: goto state_unknown_field_matching;
+	}
+	state_113:
+	// Matched field [title]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_title));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(ReusedDocument::title)*>(nullptr));
+		return;
+	}
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void ReusedDocument::ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator)
+{
+	size_t objectFieldsEnd = allocator.GetObjectSize();
+	allocator.PopObject();
+	while (allocator.GetCurIdx() != objectFieldsEnd)
+	{
+		int fieldTag = allocator.GetFieldTag();
+		switch(static_cast<__QuantumJsonFieldTag>(fieldTag))
+		{
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_title:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->title);
+				break;
+			}
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_items:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->items);
+				break;
+			}
+			default:
+			; // Should not happen
+		}
+	}
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(ReusedDocument::title)>::Type ReusedDocument::View::title() const
+{
+	return FieldValue<decltype(ReusedDocument::title)>(0, &MatchField, false);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(ReusedDocument::items)>::Type ReusedDocument::View::items() const
+{
+	return FieldValue<decltype(ReusedDocument::items)>(1, &MatchField, false);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(ReusedDocument::groups)>::Type ReusedDocument::View::groups() const
+{
+	return FieldValue<decltype(ReusedDocument::groups)>(2, &MatchField, false);
+}
+inline
+void ReusedDocument::View::MatchField(QuantumJsonImpl__::FieldNameMatcher &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'g': goto state_102;
+		case 'i': goto state_103;
+		case 't': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [g]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [gr]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'o': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [gro]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'u': goto state_107;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Currently matched prefix [grou]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'p': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [group]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 's': goto state_109;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Currently matched prefix [groups]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_110;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Matched field [groups]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 2;
+	return;
+	state_103:
+	// Currently matched prefix [i]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_111;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_111:
+	// Currently matched prefix [it]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_112;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_112:
+	// Currently matched prefix [ite]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'm': goto state_113;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_113:
+	// Currently matched prefix [item]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 's': goto state_114;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_114:
+	// Currently matched prefix [items]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_115;
+		default: goto state_unknown_field_matching;
+	}
+	state_115:
+	// Matched field [items]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 1;
+	return;
+	state_104:
+	// Currently matched prefix [t]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_116;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_116:
+	// Currently matched prefix [ti]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_117;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_117:
+	// Currently matched prefix [tit]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_118;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_118:
+	// Currently matched prefix [titl]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_119;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_119:
+	// Currently matched prefix [title]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_120;
+		default: goto state_unknown_field_matching;
+	}
+	state_120:
+	// Matched field [title]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 0;
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void ReusedDocument::MergeFromJson(InputIteratorType it,
+                                   InputIteratorType end)
+{
+	QuantumJsonImpl__::Parser<InputIteratorType> parser(it, end);
+	parser.ParseObject(*this);
+	
+	// Throw when parsing fails
+	if (parser.errorCode != QuantumJsonImpl__::ErrorCode::NoError)
+	{
+		throw QuantumJsonImpl__::JsonError(parser.errorCode);
+	}
+}
+template <typename OutputIteratorType>
+void ReusedDocument::SerializeTo(
+    QuantumJsonImpl__::Serializer<OutputIteratorType> &s
+    ) const
+{
+	
+	// Render field title
+	s.WriteLiteral("{\"title\":");
+	s.SerializeValue(this->title);
+	
+	// Render field items
+	s.WriteLiteral(",\"items\":");
+	s.SerializeValue(this->items);
+	
+	// Render field groups
+	s.WriteLiteral(",\"groups\":");
+	s.SerializeValue(this->groups);
+	s.Put('}');
+}
+template <typename InputIteratorType, bool Trusted>
+inline
+void StringViews::ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'n': goto state_102;
+		case 't': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [n]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [na]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'm': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [nam]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [name]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_107;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Matched field [name]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->name);
+	return;
+	state_103:
+	// Currently matched prefix [t]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [ta]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'g': goto state_109;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Currently matched prefix [tag]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 's': goto state_110;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Currently matched prefix [tags]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_111;
+		default: goto state_unknown_field_matching;
+	}
+	state_111:
+	// Matched field [tags]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->tags);
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void StringViews::ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_102;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [t]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_103:
+	// Currently matched prefix [ta]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'g': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [tag]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 's': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [tags]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_106;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Matched field [tags]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_tags));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(StringViews::tags)*>(nullptr));
+		return;
+	}
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void StringViews::ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator)
+{
+	size_t objectFieldsEnd = allocator.GetObjectSize();
+	allocator.PopObject();
+	while (allocator.GetCurIdx() != objectFieldsEnd)
+	{
+		int fieldTag = allocator.GetFieldTag();
+		switch(static_cast<__QuantumJsonFieldTag>(fieldTag))
+		{
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_tags:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->tags);
+				break;
+			}
+			default:
+			; // Should not happen
+		}
+	}
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(StringViews::name)>::Type StringViews::View::name() const
+{
+	return FieldValue<decltype(StringViews::name)>(0, &MatchField, false);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(StringViews::tags)>::Type StringViews::View::tags() const
+{
+	return FieldValue<decltype(StringViews::tags)>(1, &MatchField, false);
+}
+inline
+void StringViews::View::MatchField(QuantumJsonImpl__::FieldNameMatcher &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'n': goto state_102;
+		case 't': goto state_103;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [n]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_104:
+	// Currently matched prefix [na]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'm': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [nam]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [name]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_107;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Matched field [name]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 0;
+	return;
+	state_103:
+	// Currently matched prefix [t]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'a': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [ta]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'g': goto state_109;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Currently matched prefix [tag]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 's': goto state_110;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Currently matched prefix [tags]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_111;
+		default: goto state_unknown_field_matching;
+	}
+	state_111:
+	// Matched field [tags]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 1;
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void StringViews::MergeFromJson(InputIteratorType it,
+                                InputIteratorType end)
+{
+	QuantumJsonImpl__::Parser<InputIteratorType> parser(it, end);
+	parser.ParseObject(*this);
+	
+	// Throw when parsing fails
+	if (parser.errorCode != QuantumJsonImpl__::ErrorCode::NoError)
+	{
+		throw QuantumJsonImpl__::JsonError(parser.errorCode);
+	}
+}
+template <typename OutputIteratorType>
+void StringViews::SerializeTo(
+    QuantumJsonImpl__::Serializer<OutputIteratorType> &s
+    ) const
+{
+	
+	// Render field name
+	s.WriteLiteral("{\"name\":");
+	s.SerializeValue(this->name);
+	
+	// Render field tags
+	s.WriteLiteral(",\"tags\":");
+	s.SerializeValue(this->tags);
+	s.Put('}');
+}
+template <typename InputIteratorType, bool Trusted>
+inline
+void ParallelList::ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'g': goto state_102;
+		case 'i': goto state_103;
+		case 't': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [g]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [gr]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'o': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [gro]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'u': goto state_107;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Currently matched prefix [grou]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'p': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [group]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 's': goto state_109;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Currently matched prefix [groups]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_110;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Matched field [groups]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueIntoParallel(this->groups);
+	return;
+	state_103:
+	// Currently matched prefix [i]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_111;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_111:
+	// Currently matched prefix [it]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_112;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_112:
+	// Currently matched prefix [ite]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'm': goto state_113;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_113:
+	// Currently matched prefix [item]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 's': goto state_114;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_114:
+	// Currently matched prefix [items]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_115;
+		default: goto state_unknown_field_matching;
+	}
+	state_115:
+	// Matched field [items]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueIntoParallel(this->items);
+	return;
+	state_104:
+	// Currently matched prefix [t]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_116;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_116:
+	// Currently matched prefix [ti]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_117;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_117:
+	// Currently matched prefix [tit]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_118;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_118:
+	// Currently matched prefix [titl]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_119;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_119:
+	// Currently matched prefix [title]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_120;
+		default: goto state_unknown_field_matching;
+	}
+	state_120:
+	// Matched field [title]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.ParseValueInto(this->title);
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void ParallelList::ReserveNextField(QuantumJsonImpl__::PreAllocator<InputIteratorType> &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'g': goto state_102;
+		case 'i': goto state_103;
+		case 't': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [g]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [gr]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'o': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [gro]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'u': goto state_107;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Currently matched prefix [grou]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'p': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [group]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 's': goto state_109;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Currently matched prefix [groups]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_110;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Matched field [groups]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_groups));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(ParallelList::groups)*>(nullptr));
+		return;
+	}
+	return;
+	state_103:
+	// Currently matched prefix [i]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_111;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_111:
+	// Currently matched prefix [it]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_112;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_112:
+	// Currently matched prefix [ite]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'm': goto state_113;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_113:
+	// Currently matched prefix [item]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 's': goto state_114;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_114:
+	// Currently matched prefix [items]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_115;
+		default: goto state_unknown_field_matching;
+	}
+	state_115:
+	// Matched field [items]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_items));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(ParallelList::items)*>(nullptr));
+		return;
+	}
+	return;
+	state_104:
+	// Currently matched prefix [t]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_116;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_116:
+	// Currently matched prefix [ti]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_117;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_117:
+	// Currently matched prefix [tit]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_118;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_118:
+	// Currently matched prefix [titl]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_119;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_119:
+	// Currently matched prefix [title]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_120;
+		default: goto state_unknown_field_matching;
+	}
+	state_120:
+	// Matched field [title]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	// Reserve space in field
+	{
+		size_t fieldSizeIdx = parser.VisitingField(
+		    static_cast<int>(__QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_title));
+		parser.CalculateSpaceToReserveIn(fieldSizeIdx,
+		    static_cast<decltype(ParallelList::title)*>(nullptr));
+		return;
+	}
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.SkipValue();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void ParallelList::ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator)
+{
+	size_t objectFieldsEnd = allocator.GetObjectSize();
+	allocator.PopObject();
+	while (allocator.GetCurIdx() != objectFieldsEnd)
+	{
+		int fieldTag = allocator.GetFieldTag();
+		switch(static_cast<__QuantumJsonFieldTag>(fieldTag))
+		{
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_title:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->title);
+				break;
+			}
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_items:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->items);
+				break;
+			}
+			case __QuantumJsonFieldTag::__QUANTUMJSON_FIELD_TAG_groups:
+			{
+				allocator.ReserveCalculatedSpaceIn(this->groups);
+				break;
+			}
+			default:
+			; // Should not happen
+		}
+	}
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(ParallelList::title)>::Type ParallelList::View::title() const
+{
+	return FieldValue<decltype(ParallelList::title)>(0, &MatchField, false);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(ParallelList::items)>::Type ParallelList::View::items() const
+{
+	return FieldValue<decltype(ParallelList::items)>(1, &MatchField, false);
+}
+inline
+QuantumJsonImpl__::ViewOf<decltype(ParallelList::groups)>::Type ParallelList::View::groups() const
+{
+	return FieldValue<decltype(ParallelList::groups)>(2, &MatchField, false);
+}
+inline
+void ParallelList::View::MatchField(QuantumJsonImpl__::FieldNameMatcher &parser)
+{
+	parser.SkipChar('"');
+	// Currently matched prefix []
+	if (parser.FieldNameAtEnd(0))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'g': goto state_102;
+		case 'i': goto state_103;
+		case 't': goto state_104;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_102:
+	// Currently matched prefix [g]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'r': goto state_105;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_105:
+	// Currently matched prefix [gr]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'o': goto state_106;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_106:
+	// Currently matched prefix [gro]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'u': goto state_107;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_107:
+	// Currently matched prefix [grou]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'p': goto state_108;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_108:
+	// Currently matched prefix [group]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 's': goto state_109;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_109:
+	// Currently matched prefix [groups]
+	if (parser.FieldNameAtEnd(6))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_110;
+		default: goto state_unknown_field_matching;
+	}
+	state_110:
+	// Matched field [groups]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 2;
+	return;
+	state_103:
+	// Currently matched prefix [i]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_111;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_111:
+	// Currently matched prefix [it]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_112;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_112:
+	// Currently matched prefix [ite]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'm': goto state_113;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_113:
+	// Currently matched prefix [item]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 's': goto state_114;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_114:
+	// Currently matched prefix [items]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_115;
+		default: goto state_unknown_field_matching;
+	}
+	state_115:
+	// Matched field [items]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 1;
+	return;
+	state_104:
+	// Currently matched prefix [t]
+	if (parser.FieldNameAtEnd(1))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'i': goto state_116;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_116:
+	// Currently matched prefix [ti]
+	if (parser.FieldNameAtEnd(2))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 't': goto state_117;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_117:
+	// Currently matched prefix [tit]
+	if (parser.FieldNameAtEnd(3))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'l': goto state_118;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_118:
+	// Currently matched prefix [titl]
+	if (parser.FieldNameAtEnd(4))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case 'e': goto state_119;
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_119:
+	// Currently matched prefix [title]
+	if (parser.FieldNameAtEnd(5))
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_120;
+		default: goto state_unknown_field_matching;
+	}
+	state_120:
+	// Matched field [title]
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	parser.matchedField = 0;
+	return;
+	state_unknown_field_matching:
+	if (parser.FieldNameAtEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	switch (*(parser.it++))
+	{
+		case '"': goto state_unknown_field_matched;
+		default: goto state_unknown_field_matching;
+	}
+	state_unknown_field_matched:
+	if (parser.FieldNameOverranEnd())
+	{
+		parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;
+		return;
+	}
+	parser.SkipWhitespace();
+	parser.SkipChar(':'); // Field Separator
+	parser.SkipWhitespace();
+	return;
+}
+template <typename InputIteratorType>
+inline
+void ParallelList::MergeFromJson(InputIteratorType it,
+                                 InputIteratorType end)
+{
+	QuantumJsonImpl__::Parser<InputIteratorType> parser(it, end);
+	parser.ParseObject(*this);
+	
+	// Throw when parsing fails
+	if (parser.errorCode != QuantumJsonImpl__::ErrorCode::NoError)
+	{
+		throw QuantumJsonImpl__::JsonError(parser.errorCode);
+	}
+}
+template <typename OutputIteratorType>
+void ParallelList::SerializeTo(
+    QuantumJsonImpl__::Serializer<OutputIteratorType> &s
+    ) const
+{
+	
+	// Render field title
+	s.WriteLiteral("{\"title\":");
+	s.SerializeValue(this->title);
+	
+	// Render field items
+	s.WriteLiteral(",\"items\":");
+	s.SerializeValue(this->items);
+	
+	// Render field groups
+	s.WriteLiteral(",\"groups\":");
+	s.SerializeValue(this->groups);
+	s.Put('}');
+}
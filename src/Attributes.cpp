@@ -36,12 +36,17 @@ const AttributeInfo VarAttributes::Deprecated = {
     "deprecated",
     0,
 };
+const AttributeInfo VarAttributes::Parallel = {
+    "parallel",
+    0,
+};
 
 const AttributeInfo* GetKnownAttribute(const std::string &attr_name)
 {
 	if (attr_name == "json_field_name") return &VarAttributes::JsonFieldName;
 	if (attr_name == "on_null")         return &VarAttributes::OnNull;
 	if (attr_name == "deprecated")      return &VarAttributes::Deprecated;
+	if (attr_name == "parallel")        return &VarAttributes::Parallel;
 
 	// For testing multi arg attributes only
 	if (attr_name == "three_arg_attr")
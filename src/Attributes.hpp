@@ -38,6 +38,7 @@ public:
 	static const AttributeInfo JsonFieldName;
 	static const AttributeInfo OnNull;
 	static const AttributeInfo Deprecated;
+	static const AttributeInfo Parallel;
 
 	// TODO implement on_missing(action) action: "none" (default) | "throw"
 };
@@ -39,6 +39,41 @@
 using namespace std;
 using boost::format;
 
+// Types that hold no memory, so need neither reserving nor an allocator
+static bool IsPrimitiveType(const string &typeName)
+{
+	return typeName == "int"
+	    || typeName == "int32_t"
+	    || typeName == "uint32_t"
+	    || typeName == "int64_t"
+	    || typeName == "uint64_t"
+	    || typeName == "double"
+	    || typeName == "std::string_view"
+	    || typeName == "bool";
+}
+
+// Replaces standard containers with their `std::pmr` equivalents
+static void MakePmrType(VariableTypeDef *type)
+{
+	if (type->typeName == "std::string")
+	{
+		type->typeName = "std::pmr::string";
+	}
+	else if (type->typeName == "std::vector")
+	{
+		type->typeName = "std::pmr::vector";
+	}
+	else if (type->typeName == "std::map")
+	{
+		type->typeName = "std::pmr::map";
+	}
+
+	for (VariableTypeDef &of : type->of)
+	{
+		MakePmrType(&of);
+	}
+}
+
 struct Variable
 {
 	string cppName;
@@ -47,11 +82,12 @@ struct Variable
 	VariableTypeDef type;
 
 	bool skipNull = false;
+	bool isParallel = false;
 	bool isReservable = false;
 
 	int reservableFieldTag = -1;
 
-	explicit Variable(const VariableDef &var)
+	Variable(const VariableDef &var, const GeneratorOptions &options)
 	  : cppName(var.name)
 	  , jsonName(var.name)
 	  , type(var.type)
@@ -67,9 +103,18 @@ struct Variable
 			this->skipNull = true;
 		}
 
-		isReservable = ( type.typeName != "int"
-		              && type.typeName != "double"
-		              && type.typeName != "bool" );
+		if (var.attributes.find(VarAttributes::Parallel.name) != var.attributes.end())
+		{
+			this->isParallel = true;
+		}
+
+		// Maps have no capacity to reserve
+		isReservable = !IsPrimitiveType(type.typeName) && type.typeName != "std::map";
+
+		if (options.usePmr)
+		{
+			MakePmrType(&type);
+		}
 	}
 
 	bool operator<(const Variable &o) const
@@ -84,14 +129,14 @@ struct Variable
 
 struct Struct
 {
-	Struct(const StructDef &structDef)
+	Struct(const StructDef &structDef, const GeneratorOptions &options)
 	   : name(structDef.name)
 	   , inNamespace(structDef.inNamespace)
 	{
 		int reservableFieldTag = 0;
 		for (const VariableDef &vDef : structDef.variables)
 		{
-			Variable v(vDef);
+			Variable v(vDef, options);
 			if (v.isReservable)
 			{
 				v.reservableFieldTag = (++reservableFieldTag);
@@ -109,13 +154,64 @@ struct Struct
 void GenerateParserForStruct(CodeFormatter &code, const Struct &s);
 void GenerateAllocatorForStruct(CodeFormatter &code, const Struct &s);
 void GenerateReserverForStruct(CodeFormatter &code, const Struct &s);
+void GenerateAllocatorConstructorsForStruct(CodeFormatter &code, const Struct &s);
+void GenerateViewDeclarationForStruct(CodeFormatter &code, const Struct &s);
+void GenerateViewForStruct(CodeFormatter &code, const Struct &s);
 
-void GenerateHeaderForFile(CodeFormatter &code, const ParsedFile &file)
+// Returns a C++ string literal for `separator` followed by the json encoded
+// field name and a colon, e.g. `",\"name\":"`.
+static string FieldNameLiteral(char separator, const string &jsonName)
+{
+	string json(1, separator);
+	json += '"';
+	for (char c : jsonName)
+	{
+		if (c == '"' || c == '\\')
+		{
+			json += '\\';
+			json += c;
+		}
+		else if (static_cast<unsigned char>(c) < 0x20)
+		{
+			json += (format("\\u%04x") % int(c)).str();
+		}
+		else
+		{
+			json += c;
+		}
+	}
+	json += "\":";
+
+	string literal = "\"";
+	for (char c : json)
+	{
+		if (c == '"' || c == '\\')
+		{
+			literal += '\\';
+			literal += c;
+		}
+		else if (static_cast<unsigned char>(c) < 0x20 || static_cast<unsigned char>(c) >= 0x7f)
+		{
+			// Octal escapes have at most 3 digits, so they can't swallow
+			// following characters like hex escapes do
+			literal += (format("\\%03o") % int(static_cast<unsigned char>(c))).str();
+		}
+		else
+		{
+			literal += c;
+		}
+	}
+	literal += '"';
+	return literal;
+}
+
+void GenerateHeaderForFile(CodeFormatter &code, const ParsedFile &file,
+                           const GeneratorOptions &options)
 {
 	vector<Struct> allStructs;
 	for (const StructDef &s : file.structs)
 	{
-		allStructs.emplace_back(s);
+		allStructs.emplace_back(s, options);
 	}
 
 	// TODO provide an option to generate #ifndef style guards
@@ -141,6 +237,11 @@ void GenerateHeaderForFile(CodeFormatter &code, const ParsedFile &file)
 		code.EmitLine("%s& operator=(const %s &) = default;", s.name.c_str(), s.name.c_str());
 		code.EmitLine("");
 
+		if (options.usePmr)
+		{
+			GenerateAllocatorConstructorsForStruct(code, s);
+		}
+
 		code.EmitLine("// Field tag numbers");
 		code.EmitLine("enum class __QuantumJsonFieldTag");
 		code.EmitLine("{");
@@ -158,6 +259,9 @@ void GenerateHeaderForFile(CodeFormatter &code, const ParsedFile &file)
 		}
 		code.EmitLine("};");
 
+		code.EmitLine("// Lazily decoded view, see `QuantumJson::ParseView`");
+		code.EmitLine("struct View;");
+
 		// Member fields
 		for (const Variable &var : s.allVars)
 		{
@@ -194,8 +298,8 @@ void GenerateHeaderForFile(CodeFormatter &code, const ParsedFile &file)
 		code.EmitLine("// {\"a\": \"sadsadsa\", \"b\": 123}");
 		code.EmitLine("//  <------------->  <------>");
 		code.EmitLine("// marked regions would map to ParseNextField calls.");
-		code.EmitLine("template <typename InputIteratorType>");
-		code.EmitLine("void ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType> &parser);");
+		code.EmitLine("template <typename InputIteratorType, bool Trusted>");
+		code.EmitLine("void ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser);");
 
 		code.EmitLine("// Allocator that works on random access input, not to rely on string/vector");
 		code.EmitLine("// growth performance");
@@ -208,7 +312,7 @@ void GenerateHeaderForFile(CodeFormatter &code, const ParsedFile &file)
 		code.EmitLine("void ReserveCalculatedSpace(QuantumJsonImpl__::PreAllocator<InputIteratorType> &allocator);");
 
 
-		code.EmitLine("template <typename T> friend struct QuantumJsonImpl__::Parser;");
+		code.EmitLine("template <typename T, bool> friend struct QuantumJsonImpl__::Parser;");
 		code.EmitLine("template <typename T> friend struct QuantumJsonImpl__::PreAllocator;");
 		code.EmitLine("};");
 
@@ -219,6 +323,25 @@ void GenerateHeaderForFile(CodeFormatter &code, const ParsedFile &file)
 		}
 	}
 
+	// Views are defined once all structs are, as their accessors name the
+	// types of fields
+	for (const Struct &s : allStructs)
+	{
+		// Begin namespaces
+		for (auto it = s.inNamespace.begin(); it != s.inNamespace.end(); ++it)
+		{
+			code.EmitLine("namespace %s {", it->c_str());
+		}
+
+		GenerateViewDeclarationForStruct(code, s);
+
+		// End namespaces
+		for (auto it = s.inNamespace.rbegin(); it != s.inNamespace.rend(); ++it)
+		{
+			code.EmitLine("} // namespace %s", it->c_str());
+		}
+	}
+
 	// Function definitions
 	for (const Struct &s : allStructs)
 	{
@@ -231,6 +354,7 @@ void GenerateHeaderForFile(CodeFormatter &code, const ParsedFile &file)
 		GenerateParserForStruct(code, s);
 		GenerateAllocatorForStruct(code, s);
 		GenerateReserverForStruct(code, s);
+		GenerateViewForStruct(code, s);
 
 		code.EmitLine("template <typename InputIteratorType>");
 		code.EmitLine("inline");
@@ -252,33 +376,27 @@ void GenerateHeaderForFile(CodeFormatter &code, const ParsedFile &file)
 		code.EmitLine("    QuantumJsonImpl__::Serializer<OutputIteratorType> &s");
 		code.EmitLine("    ) const");
 		code.EmitLine("{");
-			code.EmitLine("*(s.out++) = '{';");
-
-
-		bool putSeparator = false;
+		// Opening brace and separators are merged into the field name
+		// literals, so each field costs a single fixed size copy.
+		char separator = '{';
 		for (const Variable &v : s.allVars)
 		{
 			code.EmitLine("");
 			code.EmitLine("// Render field %s", v.cppName.c_str());
-
-			if (putSeparator)
-			{
-				code.EmitLine("*(s.out++) = ',';");
-			}
-			putSeparator = true;
-
-			code.EmitLine("*(s.out++) = '\"';");
-			for (char c : v.jsonName)
-			{
-				code.EmitLine("*(s.out++) = '%c';", c);
-			}
-			code.EmitLine("*(s.out++) = '\"';");
-			code.EmitLine("*(s.out++) = ':';");
-
+			code.EmitLine("s.WriteLiteral(%s);", FieldNameLiteral(separator, v.jsonName).c_str());
 			code.EmitLine("s.SerializeValue(this->%s);", v.cppName.c_str());
+
+			separator = ',';
 		}
 
-			code.EmitLine("*(s.out++) = '}';");
+		if (s.allVars.empty())
+		{
+			code.EmitLine("s.WriteLiteral(\"{}\");");
+		}
+		else
+		{
+			code.EmitLine("s.Put('}');");
+		}
 		code.EmitLine("}");
 
 		// End namespaces
@@ -307,14 +425,21 @@ void GenerateParserForStruct(CodeFormatter &code, const Struct &s)
 				action.EmitLine("}");
 			action.EmitLine("}");
 		}
-		action.EmitLine("parser.ParseValueInto(this->%s);", var.cppName.c_str());
+		if (var.isParallel)
+		{
+			action.EmitLine("parser.ParseValueIntoParallel(this->%s);", var.cppName.c_str());
+		}
+		else
+		{
+			action.EmitLine("parser.ParseValueInto(this->%s);", var.cppName.c_str());
+		}
 		fp.addField(var.jsonName, action.getFormattedCode());
 	}
 
 
-	code.EmitLine("template <typename InputIteratorType>");
+	code.EmitLine("template <typename InputIteratorType, bool Trusted>");
 	code.EmitLine("inline");
-	code.EmitLine("void %s::ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType> &parser)", s.name.c_str());
+	code.EmitLine("void %s::ParseNextField(QuantumJsonImpl__::Parser<InputIteratorType, Trusted> &parser)", s.name.c_str());
 	code.EmitLine("{");
 	fp.generateFieldParserCode(code);
 	code.EmitLine("}");
@@ -384,3 +509,94 @@ void GenerateReserverForStruct(CodeFormatter &code, const Struct &s)
 		code.EmitLine("}");
 	code.EmitLine("}");
 }
+
+void GenerateViewDeclarationForStruct(CodeFormatter &code, const Struct &s)
+{
+	const string base = (format("QuantumJsonImpl__::ObjectView<%d>") % s.allVars.size()).str();
+
+	code.EmitLine("struct %s::View : %s", s.name.c_str(), base.c_str());
+	code.EmitLine("{");
+		code.EmitLine("using %s::ObjectView;", base.c_str());
+		code.EmitLine("");
+		code.EmitLine("// Field accessors, decoding the value on each call");
+	for (const Variable &var : s.allVars)
+	{
+		code.EmitLine("QuantumJsonImpl__::ViewOf<decltype(%s::%s)>::Type %s() const;",
+		    s.name.c_str(), var.cppName.c_str(), var.cppName.c_str());
+	}
+		code.EmitLine("");
+	code.EmitLine("private:");
+		code.EmitLine("// Sets `parser.matchedField` to the index of the field named by the key");
+		code.EmitLine("static void MatchField(QuantumJsonImpl__::FieldNameMatcher &parser);");
+	code.EmitLine("};");
+}
+
+void GenerateViewForStruct(CodeFormatter &code, const Struct &s)
+{
+	FieldParser fp;
+	for (size_t i = 0; i < s.allVars.size(); ++i)
+	{
+		const Variable &var = s.allVars[i];
+
+		code.EmitLine("inline");
+		code.EmitLine("QuantumJsonImpl__::ViewOf<decltype(%s::%s)>::Type %s::View::%s() const",
+		    s.name.c_str(), var.cppName.c_str(), s.name.c_str(), var.cppName.c_str());
+		code.EmitLine("{");
+			code.EmitLine("return FieldValue<decltype(%s::%s)>(%d, &MatchField, %s);",
+			    s.name.c_str(), var.cppName.c_str(), int(i), var.skipNull ? "true" : "false");
+		code.EmitLine("}");
+
+		fp.addField(var.jsonName, (format("parser.matchedField = %d;\n") % i).str());
+	}
+	// Values of unknown fields are stepped over using the index
+	fp.setUnknownFieldAction("");
+
+	code.EmitLine("inline");
+	code.EmitLine("void %s::View::MatchField(QuantumJsonImpl__::FieldNameMatcher &parser)", s.name.c_str());
+	code.EmitLine("{");
+	fp.generateFieldParserCode(code);
+	code.EmitLine("}");
+}
+
+// Makes the struct allocator aware, so containers holding it pass their
+// memory resource down to its fields (see `std::uses_allocator`).
+void GenerateAllocatorConstructorsForStruct(CodeFormatter &code, const Struct &s)
+{
+	// Initializer lists for allocator aware fields, primitive fields are
+	// only copied
+	string withAlloc, copyWithAlloc, moveWithAlloc;
+	for (const Variable &var : s.allVars)
+	{
+		const char *sep = withAlloc.empty() ? "  : " : "  , ";
+		const char *copySep = copyWithAlloc.empty() ? "  : " : "  , ";
+		const char *name = var.cppName.c_str();
+
+		if (!IsPrimitiveType(var.type.typeName))
+		{
+			withAlloc += (format("%s%s(alloc)\n") % sep % name).str();
+			copyWithAlloc += (format("%s%s(o.%s, alloc)\n") % copySep % name % name).str();
+			moveWithAlloc += (format("%s%s(std::move(o.%s), alloc)\n") % copySep % name % name).str();
+		}
+		else
+		{
+			copyWithAlloc += (format("%s%s(o.%s)\n") % copySep % name % name).str();
+			moveWithAlloc += (format("%s%s(o.%s)\n") % copySep % name % name).str();
+		}
+	}
+
+	code.EmitLine("using allocator_type = std::pmr::polymorphic_allocator<char>;");
+	code.EmitLine("");
+	code.EmitLine("explicit %s(const allocator_type &alloc)", s.name.c_str());
+	code.EmitCode(withAlloc);
+	code.EmitLine("{");
+	code.EmitLine("}");
+	code.EmitLine("%s(const %s &o, const allocator_type &alloc)", s.name.c_str(), s.name.c_str());
+	code.EmitCode(copyWithAlloc);
+	code.EmitLine("{");
+	code.EmitLine("}");
+	code.EmitLine("%s(%s &&o, const allocator_type &alloc)", s.name.c_str(), s.name.c_str());
+	code.EmitCode(moveWithAlloc);
+	code.EmitLine("{");
+	code.EmitLine("}");
+	code.EmitLine("");
+}
@@ -25,4 +25,12 @@
 #include "Parser.hpp"
 #include "Util.hpp"
 
-void GenerateHeaderForFile(CodeFormatter &code, const ParsedFile &file);
+struct GeneratorOptions
+{
+	// Generate structs with `std::pmr` containers, which can be allocated
+	// from a per-document arena (`jc --pmr`)
+	bool usePmr = false;
+};
+
+void GenerateHeaderForFile(CodeFormatter &code, const ParsedFile &file,
+                           const GeneratorOptions &options = GeneratorOptions());
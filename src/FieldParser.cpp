@@ -44,6 +44,11 @@ void FieldParser::addField(const string fieldName,
 	fieldInfos.insert(fieldInfo);
 }
 
+void FieldParser::setUnknownFieldAction(const string &action)
+{
+	unknownFieldAction = action;
+}
+
 string FieldParser::generateFieldParserCode()
 {
 	CodeFormatter code;
@@ -106,6 +111,11 @@ void FieldParser::generateFieldParserCode(CodeFormatter &code)
 		if (st.matchComplete)
 		{
 			code.EmitLine("// Matched field [%s]", fields[st.firstFieldIdx].fieldName.c_str());
+			code.EmitLine("if (parser.FieldNameOverranEnd())");
+			code.EmitLine("{");
+				code.EmitLine("parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;");
+				code.EmitLine("return;");
+			code.EmitLine("}");
 
 			code.EmitLine("parser.SkipWhitespace();");
 			code.EmitLine("parser.SkipChar(':'); // Field Separator");
@@ -158,7 +168,7 @@ void FieldParser::generateFieldParserCode(CodeFormatter &code)
 
 		code.EmitLine("// Currently matched prefix [%s]",
 		             fields[st.firstFieldIdx].fieldName.substr(0, st.matchedCharCnt).c_str());
-		code.EmitLine("if (parser.it == parser.end)");
+		code.EmitLine("if (parser.FieldNameAtEnd(%d))", st.matchedCharCnt);
 		code.EmitLine("{");
 			code.EmitLine("parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;");
 			code.EmitLine("return;");
@@ -186,6 +196,11 @@ void FieldParser::generateFieldParserCode(CodeFormatter &code)
 	}
 
 	code.EmitLine("state_unknown_field_matching:");
+	code.EmitLine("if (parser.FieldNameAtEnd())");
+	code.EmitLine("{");
+		code.EmitLine("parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;");
+		code.EmitLine("return;");
+	code.EmitLine("}");
 	code.EmitLine("switch (*(parser.it++))");
 	code.EmitLine("{");
 	code.EmitLine("case '\"': goto state_unknown_field_matched;");
@@ -193,9 +208,14 @@ void FieldParser::generateFieldParserCode(CodeFormatter &code)
 	code.EmitLine("}");
 
 	code.EmitLine("state_unknown_field_matched:");
+	code.EmitLine("if (parser.FieldNameOverranEnd())");
+	code.EmitLine("{");
+		code.EmitLine("parser.errorCode = QuantumJsonImpl__::ErrorCode::UnexpectedEOF;");
+		code.EmitLine("return;");
+	code.EmitLine("}");
 	code.EmitLine("parser.SkipWhitespace();");
 	code.EmitLine("parser.SkipChar(':'); // Field Separator");
 	code.EmitLine("parser.SkipWhitespace();");
-	code.EmitLine("parser.SkipValue();");
+	code.EmitCode(unknownFieldAction);
 	code.EmitLine("return;");
 }
@@ -48,6 +48,9 @@ public:
 	// value.
 	void addField(const std::string fieldName,
 	              const std::string matchedAction);
+	// Code emitted where an unknown field is matched, instead of skipping
+	// its value.
+	void setUnknownFieldAction(const std::string &action);
 	std::string generateFieldParserCode();
 	void generateFieldParserCode(CodeFormatter &code);
 
@@ -74,4 +77,5 @@ private:
 	};
 
 	std::set<FieldInfo> fieldInfos;
+	std::string unknownFieldAction = "parser.SkipValue();\n";
 };
@@ -40,6 +40,7 @@ int main(int argc, char* argv[])
 	using namespace std::literals;
 
 	std::string input_file_name, output_file_name;
+	GeneratorOptions options;
 
 	for ( int i = 1; i < argc; )
 	{
@@ -55,6 +56,12 @@ int main(int argc, char* argv[])
 			i += 2;
 			continue;
 		}
+		if ( argv[ i ] == "--pmr"sv )
+		{
+			options.usePmr = true;
+			i += 1;
+			continue;
+		}
 		std::cerr << "Unknown flag: " << argv[ i ] << "\n";
 		return 1;
 	}
@@ -83,7 +90,7 @@ int main(int argc, char* argv[])
 	}
 
 	CodeFormatter code;
-	GenerateHeaderForFile(code, f);
+	GenerateHeaderForFile(code, f, options);
 	oHeader << code.getFormattedCode();
 
 	oHeader.flush();
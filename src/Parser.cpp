@@ -53,6 +53,31 @@ static void MakeStandardType(VariableTypeDef* type)
 		type->typeName = "std::string";
 		return;
 	}
+	if (type->typeName == "string_view" && type->of.size() == 0)
+	{
+		type->typeName = "std::string_view";
+		return;
+	}
+	if (type->typeName == "int32" && type->of.size() == 0)
+	{
+		type->typeName = "int32_t";
+		return;
+	}
+	if (type->typeName == "uint32" && type->of.size() == 0)
+	{
+		type->typeName = "uint32_t";
+		return;
+	}
+	if (type->typeName == "int64" && type->of.size() == 0)
+	{
+		type->typeName = "int64_t";
+		return;
+	}
+	if (type->typeName == "uint64" && type->of.size() == 0)
+	{
+		type->typeName = "uint64_t";
+		return;
+	}
 	if (type->typeName == "vector" && type->of.size() > 0)
 	{
 		type->typeName = "std::vector";
@@ -66,3 +66,15 @@ TEST_CASE("Test no fields")
 	REQUIRE(code.find("state_unknown_field_matching:") != string::npos);
 	REQUIRE(code.find("state_unknown_field_matched:") != string::npos);
 }
+
+TEST_CASE("Test unknown field action")
+{
+	FieldParser fp;
+	fp.addField("id", "parser.matchedField = 0;\n");
+	fp.setUnknownFieldAction("// Unknown field\n");
+
+	string code = fp.generateFieldParserCode();
+
+	REQUIRE(code.find("// Unknown field") != string::npos);
+	REQUIRE(code.find("parser.SkipValue();") == string::npos);
+}
@@ -59,3 +59,45 @@ TEST_CASE( "Multiple template arguments" )
 	REQUIRE(varE.type.of[0].typeName == "std::string");
 	REQUIRE(varE.type.of[1].typeName == "Elem");
 }
+
+TEST_CASE( "Fixed width integer types" )
+{
+	string input = R"(
+	    struct Test
+	    {
+	        int32 a;
+	        uint32 b;
+	        int64 c;
+	        vector<uint64> d;
+	    };
+	)";
+
+	ParsedFile f = Parse(Tokenize(input));
+
+	const auto &vars = f.structs[0].variables;
+
+	REQUIRE(vars[0].type.typeName == "int32_t");
+	REQUIRE(vars[1].type.typeName == "uint32_t");
+	REQUIRE(vars[2].type.typeName == "int64_t");
+	REQUIRE(vars[3].type.typeName == "std::vector");
+	REQUIRE(vars[3].type.of[0].typeName == "uint64_t");
+}
+
+TEST_CASE( "String view type" )
+{
+	string input = R"(
+	    struct Test
+	    {
+	        string_view a;
+	        vector<string_view> b;
+	    };
+	)";
+
+	ParsedFile f = Parse(Tokenize(input));
+
+	const auto &vars = f.structs[0].variables;
+
+	REQUIRE(vars[0].type.typeName == "std::string_view");
+	REQUIRE(vars[1].type.typeName == "std::vector");
+	REQUIRE(vars[1].type.of[0].typeName == "std::string_view");
+}
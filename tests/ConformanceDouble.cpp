@@ -21,6 +21,9 @@
 // SOFTWARE.
 
 #include <iostream>
+#include <iterator>
+#include <list>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -37,6 +40,8 @@ using namespace std;
 #define S__LINE__ S_(__LINE__)
 
 
+// Checked for contiguous, non-contiguous and single pass inputs, as they
+// take different code paths while parsing digits.
 #define TEST_DOUBLE(json, expect) \
 	TEST_CASE("Double conformance test " S__LINE__) \
 	{ \
@@ -46,6 +51,22 @@ using namespace std;
 		double actualResult = v[0]; \
 		double expectedResult = expect; \
 		REQUIRE( 0 == memcmp((void*)&actualResult, (void*)&expectedResult, sizeof(double)) ); \
+		\
+		string jsonStr = json; \
+		list<char> jsonList(jsonStr.begin(), jsonStr.end()); \
+		vector<double> v2 = QuantumJson::Parse(jsonList.begin(), jsonList.end()); \
+		REQUIRE( v2.size() == 1 ); \
+		\
+		actualResult = v2[0]; \
+		REQUIRE( 0 == memcmp((void*)&actualResult, (void*)&expectedResult, sizeof(double)) ); \
+		\
+		istringstream jsonStream(jsonStr); \
+		vector<double> v3 = QuantumJson::Parse(istreambuf_iterator<char>(jsonStream), \
+		                                       istreambuf_iterator<char>()); \
+		REQUIRE( v3.size() == 1 ); \
+		\
+		actualResult = v3[0]; \
+		REQUIRE( 0 == memcmp((void*)&actualResult, (void*)&expectedResult, sizeof(double)) ); \
 	}
 
 #include "ConformanceDoubleData.hpp"
@@ -125,3 +125,7 @@ TEST_DOUBLE(
     "2390026549819838548794829220689472168983109969836584681402285424333066033985088644580400103493397042"
     "7567186443383770486037861622771738545623065874679014086723327636718751234567890123456789012345678901"
     "e-308]",  2.2250738585072014e-308);
+
+// 2^53 + 1 is halfway between two doubles, the digit far after it decides
+TEST_DOUBLE("[9007199254740993]", 9007199254740992.0);
+TEST_DOUBLE("[9007199254740993.00000000000000000001]", 9007199254740994.0);
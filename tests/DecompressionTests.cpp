@@ -0,0 +1,172 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Mustafa Serdar Sanli
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Built with QUANTUMJSON_WITH_ZLIB
+
+#include <string>
+#include <thread>
+
+#include <zlib.h>
+
+#include "tests/Schema1.gen.hpp"
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+static string Gzip(const string &in)
+{
+	z_stream stream = {};
+	// gzip header
+	REQUIRE( deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK );
+
+	string out(deflateBound(&stream, in.size()), '\0');
+	stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+	stream.avail_in = in.size();
+	stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+	stream.avail_out = out.size();
+	REQUIRE( deflate(&stream, Z_FINISH) == Z_STREAM_END );
+	out.resize(stream.total_out);
+	deflateEnd(&stream);
+	return out;
+}
+
+static string ItemsJson(int count)
+{
+	string in = R"({"items": [)";
+	for (int i = 0; i < count; ++i)
+	{
+		in += (i ? ",\n  " : "") + string(R"({"name": "item \")") + to_string(i) + R"(", "skipped": [1, {"a": "b c d"}]})";
+	}
+	return in + "]}";
+}
+
+TEST_CASE("Gzip input")
+{
+	const string json = ItemsJson(5000);
+	const string gz = Gzip(json);
+
+	SECTION( "From memory" )
+	{
+		for (size_t chunkSize : {7, 4096, 65536})
+		{
+			QuantumJson::DecompressingInput input(gz.data(), gz.size(), QuantumJson::DecompressingInput::Gzip, chunkSize);
+			ItemList l = QuantumJson::Parse(input);
+			REQUIRE( l.items.size() == 5000 );
+			REQUIRE( l.items[4999].name == "item \"4999" );
+		}
+	}
+
+	SECTION( "From pipe" )
+	{
+		int fds[2];
+		REQUIRE( pipe(fds) == 0 );
+		std::thread writer([&]()
+		{
+			for (size_t i = 0; i < gz.size(); )
+			{
+				ssize_t n = write(fds[1], gz.data() + i, std::min<size_t>(1000, gz.size() - i));
+				if (n <= 0)
+				{
+					break;
+				}
+				i += n;
+			}
+			close(fds[1]);
+		});
+
+		ItemList l;
+		{
+			QuantumJson::DecompressingInput input(fds[0], QuantumJson::DecompressingInput::Gzip);
+			l = QuantumJson::Parse(input);
+		}
+		writer.join();
+		close(fds[0]);
+
+		REQUIRE( l.items.size() == 5000 );
+		REQUIRE( l.items[0].name == "item \"0" );
+	}
+
+	SECTION( "Concatenated members" )
+	{
+		const string parts = Gzip(json.substr(0, 1000)) + Gzip(json.substr(1000));
+		QuantumJson::DecompressingInput input(parts.data(), parts.size(), QuantumJson::DecompressingInput::Gzip);
+		ItemList l = QuantumJson::Parse(input);
+		REQUIRE( l.items.size() == 5000 );
+	}
+
+	SECTION( "Errors" )
+	{
+		QuantumJson::DecompressingInput truncated(gz.data(), gz.size() - 10, QuantumJson::DecompressingInput::Gzip);
+		REQUIRE_THROWS_WITH( ItemList(QuantumJson::Parse(truncated)), "Truncated gzip data" );
+
+		string corrupted = gz;
+		corrupted[0] ^= 0x55;
+		QuantumJson::DecompressingInput invalid(corrupted.data(), corrupted.size(), QuantumJson::DecompressingInput::Gzip);
+		REQUIRE_THROWS_WITH( ItemList(QuantumJson::Parse(invalid)), "Invalid gzip data: incorrect header check" );
+
+
+		REQUIRE_THROWS_AS( QuantumJson::DecompressingInput(gz.data(), gz.size(), QuantumJson::DecompressingInput::Zstd),
+		                   std::invalid_argument );
+	}
+
+	SECTION( "Truncated json" )
+	{
+		// Decompressed fine, but cut at every offset of the json
+		const string doc = R"({"x": [1, -2.5e3, {"a": "}]\"{"}, true, null],)"
+		                   R"( "items": [{"name": "a\"b\u00e9"}, {"name": "c"}]})";
+		for (size_t len = 0; len < doc.size(); ++len)
+		{
+			INFO( doc.substr(0, len) );
+			const string gzipped = Gzip(doc.substr(0, len));
+			QuantumJson::DecompressingInput input(gzipped.data(), gzipped.size(), QuantumJson::DecompressingInput::Gzip, 7);
+			REQUIRE_THROWS_WITH( ItemList(QuantumJson::Parse(input)), "Unexpected EOF" );
+		}
+	}
+
+	SECTION( "Stopped early" )
+	{
+		// Only the value is parsed, the input is dropped with the rest
+		// not decompressed
+		const string twice = Gzip(json + json + json);
+		QuantumJson::DecompressingInput input(twice.data(), twice.size(), QuantumJson::DecompressingInput::Gzip, 1024);
+		ItemList l = QuantumJson::Parse(input);
+		REQUIRE( l.items.size() == 5000 );
+
+		// The reader stops waiting for another member once the parse
+		// fails, leaving the rest of the stream unread
+		int fds[2];
+		REQUIRE( pipe(fds) == 0 );
+		const string invalid = Gzip("[1, x");
+		REQUIRE( write(fds[1], invalid.data(), invalid.size()) == ssize_t(invalid.size()) );
+		{
+			QuantumJson::DecompressingInput pipeInput(fds[0], QuantumJson::DecompressingInput::Gzip);
+			REQUIRE_THROWS_WITH( vector<int>(QuantumJson::Parse(pipeInput)), "Unexpected Token" );
+		}
+
+		REQUIRE( write(fds[1], "rest", 4) == 4 );
+		char buf[8];
+		REQUIRE( read(fds[0], buf, sizeof(buf)) == 4 );
+		close(fds[0]);
+		close(fds[1]);
+	}
+}
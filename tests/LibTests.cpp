@@ -21,6 +21,7 @@
 // SOFTWARE.
 
 #include <iostream>
+#include <sstream>
 
 #include "lib/Common.hpp"
 
@@ -49,6 +50,45 @@ TEST_CASE("Escape Characters")
 	REQUIRE(out == expectedOut);
 }
 
+TEST_CASE("Strings across block boundaries")
+{
+	// Escapes, control characters and the closing quote at every position
+	// around the 16 and 32 byte blocks strings are scanned in, including
+	// strings shorter than a block. Buffers have the exact size so reads
+	// past the end are caught by sanitizers.
+	const vector<pair<string, string>> escapes = {
+		{"\\n", "\n"}, {"\\\"", "\""}, {"\\\\", "\\"}, {"\\u00e9", u8"\u00e9"}, {u8"\u00e9", u8"\u00e9"},
+	};
+	for (size_t len = 0; len < 70; ++len)
+	{
+		const string plain(len, 'x');
+
+		string in = "\"" + plain + "\"";
+		vector<char> buf(in.begin(), in.end());
+		string out = QuantumJson::Parse(buf.begin(), buf.end());
+		REQUIRE(out == plain);
+
+		vector<char> unterminated(in.begin(), in.end() - 1);
+		REQUIRE_THROWS_WITH(
+		    [&](){ string out = QuantumJson::Parse(unterminated.begin(), unterminated.end()); }(),
+		    "Unexpected EOF");
+
+		for (const auto &escape : escapes)
+		{
+			in = "\"" + plain + escape.first + plain + "\"";
+			buf.assign(in.begin(), in.end());
+			string unescaped = QuantumJson::Parse(buf.begin(), buf.end());
+			REQUIRE(unescaped == plain + escape.second + plain);
+		}
+
+		in = "\"" + plain + "\x01" + plain + "\"";
+		buf.assign(in.begin(), in.end());
+		REQUIRE_THROWS_WITH(
+		    [&](){ string out = QuantumJson::Parse(buf.begin(), buf.end()); }(),
+		    "Control Character In String");
+	}
+}
+
 TEST_CASE("Invalid Escape")
 {
 	string in = R"("\q")";
@@ -106,6 +146,37 @@ TEST_CASE("Unicode Escape")
 		string out = QuantumJson::Parse(in);
 		REQUIRE(out == u8"𝐀");
 	}
+
+	SECTION("Long runs of escapes")
+	{
+		// Longer than the buffer runs are decoded into, mixing 1 to 4
+		// byte encodings and surrogate pairs
+		string in = "\"";
+		string expected;
+		for (int i = 0; i < 40; ++i)
+		{
+			in += R"(\u4e2d\u0041\u00e9\uD83D\uDE00)";
+			expected += u8"中Aé😀";
+			if (i % 7 == 0)
+			{
+				in += R"(x\n)";
+				expected += "x\n";
+			}
+		}
+		in += "\"";
+
+		string out = QuantumJson::Parse(in);
+		REQUIRE(out == expected);
+
+		QuantumJson::StringStorage storage;
+		std::string_view view = QuantumJson::Parse(in, storage);
+		REQUIRE(view == expected);
+
+		std::istringstream stream(in);
+		string streamOut = QuantumJson::Parse(std::istreambuf_iterator<char>(stream),
+		                                      std::istreambuf_iterator<char>());
+		REQUIRE(streamOut == expected);
+	}
 }
 
 TEST_CASE("Invalid Unicode Escape")
@@ -125,6 +196,16 @@ TEST_CASE("Invalid Unicode Escape")
 		    [&](){ string out = QuantumJson::Parse(in); }(),
 		    "Unexpected Char");
 	}
+
+	SECTION("Invalid digit in a run of escapes")
+	{
+		for (const char *in : { R"("\u4e2d\u4e2g")", R"("\u4e2d\uD83D\uDE0x")",
+		                        R"("\u4e2d\u-123")", R"("\u4e2d\u4e2)" })
+		{
+			REQUIRE_THROWS(
+			    [&](){ string out = QuantumJson::Parse(in); }());
+		}
+	}
 }
 
 TEST_CASE("Invalid surrogates")
@@ -157,6 +238,60 @@ TEST_CASE("Invalid surrogates")
 	}
 }
 
+TEST_CASE("Parse integers")
+{
+	SECTION("Valid integers")
+	{
+		int a = QuantumJson::Parse("0");
+		REQUIRE(a == 0);
+		int b = QuantumJson::Parse("-0");
+		REQUIRE(b == 0);
+		int c = QuantumJson::Parse("-2147483648");
+		REQUIRE(c == -2147483648LL);
+		int64_t d = QuantumJson::Parse("1234567890123456789");
+		REQUIRE(d == 1234567890123456789LL);
+		uint64_t e = QuantumJson::Parse("18446744073709551615");
+		REQUIRE(e == 18446744073709551615ULL);
+	}
+
+	SECTION("Leading plus sign")
+	{
+		REQUIRE_THROWS_WITH(
+		    [&](){ int out = QuantumJson::Parse("+1"); (void)out; }(),
+		    "Unexpected Token");
+	}
+
+	SECTION("Leading zeros")
+	{
+		REQUIRE_THROWS_WITH(
+		    [&](){ int out = QuantumJson::Parse("012"); (void)out; }(),
+		    "Unexpected Token");
+	}
+
+	SECTION("Missing digits")
+	{
+		REQUIRE_THROWS_WITH(
+		    [&](){ int out = QuantumJson::Parse("-"); (void)out; }(),
+		    "Unexpected EOF");
+	}
+
+	SECTION("Overflow")
+	{
+		REQUIRE_THROWS_WITH(
+		    [&](){ int out = QuantumJson::Parse("2147483648"); (void)out; }(),
+		    "Number Out Of Range");
+		REQUIRE_THROWS_WITH(
+		    [&](){ int64_t out = QuantumJson::Parse("-9223372036854775809"); (void)out; }(),
+		    "Number Out Of Range");
+		REQUIRE_THROWS_WITH(
+		    [&](){ uint64_t out = QuantumJson::Parse("18446744073709551616"); (void)out; }(),
+		    "Number Out Of Range");
+		REQUIRE_THROWS_WITH(
+		    [&](){ unsigned out = QuantumJson::Parse("-1"); (void)out; }(),
+		    "Number Out Of Range");
+	}
+}
+
 TEST_CASE("Parse List")
 {
 	string in = R"(["val1", "val2"])";
@@ -194,3 +329,223 @@ TEST_CASE("Parse list map")
 	REQUIRE(out.at("key2")[1] == "val7");
 	REQUIRE(out.at("key2")[2] == "val8");
 }
+
+TEST_CASE("Parse doubles")
+{
+	SECTION("Number at end of input")
+	{
+		double out = QuantumJson::Parse("-12.5e3");
+		REQUIRE(out == -12500.0);
+	}
+
+	SECTION("Many digits")
+	{
+		double out = QuantumJson::Parse("3.14159265358979323846264338327950288");
+		REQUIRE(out == 3.141592653589793);
+	}
+
+	SECTION("Missing fraction digits")
+	{
+		REQUIRE_THROWS_WITH(
+		    [&](){ double out = QuantumJson::Parse("1.e5"); (void)out; }(),
+		    "Unexpected Token");
+	}
+
+	SECTION("Missing exponent digits")
+	{
+		REQUIRE_THROWS_WITH(
+		    [&](){ double out = QuantumJson::Parse("1e"); (void)out; }(),
+		    "Unexpected EOF");
+	}
+}
+
+TEST_CASE("Pretty printed input")
+{
+	// Indentation runs longer than a 16 byte block, ending at various
+	// offsets in the block
+	for (int indent : {0, 1, 15, 16, 17, 40})
+	{
+		string pad = "\n" + string(indent, ' ') + "\t\r\n" + string(indent, ' ');
+		string in = "{" + pad + "\"key1\"" + pad + ":" + pad + "[" + pad + "1" + pad + ","
+		          + pad + "2" + pad + "]" + pad + "," + pad + "\"key2\"" + pad + ":"
+		          + pad + "[]" + pad + "}" + pad;
+
+		map<string, vector<int>> out = QuantumJson::Parse(in);
+		REQUIRE(out.size() == 2);
+		REQUIRE(out.at("key1") == vector<int>{1, 2});
+		REQUIRE(out.at("key2").empty());
+
+		// Input ending in whitespace, list is never closed
+		REQUIRE_THROWS_WITH(
+		    [&](){ vector<int> out = QuantumJson::Parse("[1," + pad); }(),
+		    "Unexpected EOF");
+	}
+}
+
+TEST_CASE("Long UTF-8 runs")
+{
+	// Multibyte sequences straddling 16 byte block boundaries
+	const string text = u8"ğüşiöçÖÇŞİĞÜIı ΑΒΓ Жизнь 漢字 𝐀😀";
+	for (int prefix = 0; prefix < 20; ++prefix)
+	{
+		string expected = string(prefix, 'a') + text + text;
+		string out = QuantumJson::Parse("\"" + expected + "\"");
+		REQUIRE(out == expected);
+	}
+
+	// Invalid sequences at various offsets of a long run
+	const char *invalid[] = {
+		"\xc0\xaf", "\xe0\x80\xaf", "\xed\xa0\x80", "\xf4\x90\x80\x80",
+		"\xf8\x88\x80\x80\x80", "\x80", "\xe2\x82", "\xff",
+	};
+	for (const char *seq : invalid)
+	{
+		for (size_t pos = 0; pos <= text.size(); ++pos)
+		{
+			// Only split the text on sequence boundaries
+			if (pos < text.size() && (text[pos] & 0xC0) == 0x80)
+				continue;
+			string in = "\"" + text.substr(0, pos) + seq + text.substr(pos) + "\"";
+			REQUIRE_THROWS_WITH(
+			    [&](){ string out = QuantumJson::Parse(in); }(),
+			    "Invalid UTF-8 Sequence");
+		}
+	}
+}
+
+TEST_CASE("Nesting depth limit")
+{
+	string in = "[[[1], [2, 3]], [[4]]]";
+
+	vector<vector<vector<int>>> out = QuantumJson::Parse(in).MaxDepth(3);
+	REQUIRE(out.size() == 2);
+	REQUIRE(out[0][1] == vector<int>{2, 3});
+
+	REQUIRE_THROWS_WITH(
+	    [&](){ vector<vector<vector<int>>> out = QuantumJson::Parse(in).MaxDepth(2); }(),
+	    "Depth Limit Exceeded");
+	using NestedMap = map<string, map<string, int>>;
+	REQUIRE_THROWS_WITH(
+	    [&](){ NestedMap out = QuantumJson::Parse(R"({"a": {"b": 1}})").MaxDepth(1); }(),
+	    "Depth Limit Exceeded");
+
+	// Preallocation walks the same containers
+	REQUIRE_THROWS_WITH(
+	    [&](){ vector<vector<vector<int>>> out = QuantumJson::Parse<QuantumJson::Preallocate>(in).MaxDepth(2); }(),
+	    "Depth Limit Exceeded");
+}
+
+TEST_CASE("Trusted input")
+{
+	SECTION("Same values as validating parser")
+	{
+		string in = R"(["plain", "esc\"aped\\\n", ")"
+		            + string(u8"ğüş 漢字 😀") + R"(", ")" + string(100, 'x') + R"("])";
+		vector<string> expected = QuantumJson::Parse(in);
+		vector<string> out = QuantumJson::Parse<QuantumJson::Trusted>(in);
+		REQUIRE(out == expected);
+
+		std::istringstream stream(in);
+		vector<string> streamOut = QuantumJson::Parse<QuantumJson::Trusted>(
+		    std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+		REQUIRE(streamOut == expected);
+
+		vector<bool> flags = QuantumJson::Parse<QuantumJson::Trusted>("[true, false, true]");
+		REQUIRE(flags == vector<bool>{true, false, true});
+
+		std::string_view view = QuantumJson::Parse<QuantumJson::Trusted>(R"("no escapes")");
+		REQUIRE(view == "no escapes");
+	}
+
+	SECTION("String contents are not validated")
+	{
+		string in = "\"a\x01" "b\xff\"";
+		REQUIRE_THROWS_WITH(
+		    [&](){ string out = QuantumJson::Parse(in); }(),
+		    "Control Character In String");
+
+		string out = QuantumJson::Parse<QuantumJson::Trusted>(in);
+		REQUIRE(out == "a\x01" "b\xff");
+	}
+
+	SECTION("Truncated literal")
+	{
+		REQUIRE_THROWS_WITH(
+		    [&](){ vector<bool> out = QuantumJson::Parse<QuantumJson::Trusted>("[tr"); }(),
+		    "Unexpected EOF");
+	}
+}
+
+TEST_CASE("SIMD kernels")
+{
+	using namespace QuantumJsonImpl__;
+
+	// Every class of characters the kernels look for, and bytes that are
+	// close to them
+	const string alphabet = string("a \t\n\r\"\\{}[]:,\x01\x1f\x7f") + u8"é中😀" + "\x80\xff";
+	vector<string> inputs;
+	for (size_t len = 0; len < 150; ++len)
+	{
+		for (char c : alphabet)
+		{
+			// One character of a class at the end of a run of whitespace
+			// and a run of plain characters
+			inputs.push_back(string(len, ' ') + c + "x");
+			inputs.push_back(string(len, 'x') + c + " ");
+		}
+	}
+	uint32_t seed = 1;
+	for (int i = 0; i < 2000; ++i)
+	{
+		string s;
+		size_t len = i % 200;
+		for (size_t j = 0; j < len; ++j)
+		{
+			seed = seed * 1103515245 + 12345;
+			s += alphabet[(seed >> 16) % alphabet.size()];
+		}
+		inputs.push_back(s);
+	}
+
+	const Kernels active = ActiveKernels();
+	const Kernels scalar = KernelsFor(SimdLevel::Scalar);
+	for (int level = 0; level <= static_cast<int>(DetectSimdLevel()); ++level)
+	{
+		ActiveKernels() = KernelsFor(static_cast<SimdLevel>(level));
+		INFO("SIMD level " << level);
+
+		for (const string &in : inputs)
+		{
+			// Exact size copies, so reads past the end are caught by sanitizers
+			vector<char> buf(in.begin(), in.end());
+			const char *begin = buf.data(), *end = buf.data() + buf.size();
+			for (int stop = 0; stop < static_cast<int>(StopAt::Count); ++stop)
+			{
+				REQUIRE(ActiveKernels().runLength[stop](begin, end) == scalar.runLength[stop](begin, end));
+			}
+			REQUIRE(ActiveKernels().isValidUtf8(begin, end) == scalar.isValidUtf8(begin, end));
+
+			if (in.size() >= 64)
+			{
+				BlockMasks masks, expected;
+				ActiveKernels().classifyBlock(begin, &masks);
+				scalar.classifyBlock(begin, &expected);
+				REQUIRE(masks.quote == expected.quote);
+				REQUIRE(masks.backslash == expected.backslash);
+				REQUIRE(masks.control == expected.control);
+				REQUIRE(masks.whitespace == expected.whitespace);
+				REQUIRE(masks.op == expected.op);
+			}
+		}
+
+		map<string, string> out = QuantumJson::Parse(R"({"k": ")" + string(100, 'z') + u8"é\"}");
+		REQUIRE(out["k"] == string(100, 'z') + u8"é");
+
+		string skipped = R"([{"a": [1, "x\"y", {"b": null}]}, ")" + string(100, 'z') + R"("])";
+		InputProcessor<const char*> skipper(skipped.data(), skipped.data() + skipped.size());
+		skipper.SkipValue();
+		REQUIRE(skipper.errorCode == ErrorCode::NoError);
+		REQUIRE(skipper.it == skipped.data() + skipped.size());
+	}
+	ActiveKernels() = active;
+}
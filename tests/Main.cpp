@@ -20,7 +20,10 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 
 #include "tests/Schema1.gen.hpp"
 
@@ -118,3 +121,1043 @@ TEST_CASE("Unknown Attributes")
 	// Check of parsing completes successfully
 	REQUIRE( o.attr1 == "wqwqeweqeq" );
 }
+
+TEST_CASE("Unknown nested attributes")
+{
+	SECTION( "Large subtree" )
+	{
+		string in = R"({"unknown": {"a": [1, 2, {"b": "x\"}]\\"}, [], {}], "c": null},)";
+		for (int i = 0; i < 20; ++i)
+		{
+			in += R"( "unknown-)" + to_string(i) + R"(": [{"\"q\"": "]]]\\\"}}}é long enough to cross blocks"}],)";
+		}
+		in += R"( "attr1": "val1"})";
+		AttributeTester o = QuantumJson::Parse(in);
+
+		REQUIRE( o.attr1 == "val1" );
+	}
+
+	SECTION( "Unbalanced subtree" )
+	{
+		string in = R"({"unknown": {"a": [1, 2}, "attr1": "val1"})";
+		REQUIRE_THROWS_WITH([&](){
+		        AttributeTester o = QuantumJson::Parse(in);
+		    }(),
+		    "Unexpected Char" );
+	}
+
+	SECTION( "Invalid escape in subtree" )
+	{
+		string in = R"({"unknown": ["\x"], "attr1": "val1"})";
+		REQUIRE_THROWS_WITH([&](){
+		        AttributeTester o = QuantumJson::Parse(in);
+		    }(),
+		    "Invalid Escape" );
+	}
+
+	SECTION( "Deeply nested subtree" )
+	{
+		auto nested = [](int depth) {
+			string value;
+			for (int i = 0; i < depth; ++i)
+			{
+				value += (i % 2) ? R"({"k": )" : "[";
+			}
+			value += "1";
+			for (int i = depth - 1; i >= 0; --i)
+			{
+				value += (i % 2) ? "}" : "]";
+			}
+			return R"({"unknown": )" + value + R"(, "attr1": "val1"})";
+		};
+
+		// Skipped both a block at a time and a character at a time, with the
+		// enclosing object counted in the depth
+		auto parse = [](const string &in, int maxDepth, bool contiguous) {
+			if (contiguous)
+			{
+				AttributeTester o = QuantumJson::Parse(in).MaxDepth(maxDepth);
+				return o.attr1;
+			}
+			istringstream stream(in);
+			AttributeTester o = QuantumJson::Parse(istreambuf_iterator<char>(stream),
+			                                       istreambuf_iterator<char>()).MaxDepth(maxDepth);
+			return o.attr1;
+		};
+
+		for (bool contiguous : { true, false })
+		{
+			REQUIRE( parse(nested(1023), 1024, contiguous) == "val1" );
+			REQUIRE_THROWS_WITH( parse(nested(1024), 1024, contiguous),
+			                     "Depth Limit Exceeded" );
+			REQUIRE( parse(nested(9), 10, contiguous) == "val1" );
+			REQUIRE_THROWS_WITH( parse(nested(10), 10, contiguous),
+			                     "Depth Limit Exceeded" );
+
+			// Levels past the inline bracket stack
+			REQUIRE( parse(nested(5000), 5001, contiguous) == "val1" );
+
+			// Hostile input fails without exhausting the stack
+			REQUIRE_THROWS_WITH( parse(R"({"unknown": )" + string(1000000, '['), 1024, contiguous),
+			                     "Depth Limit Exceeded" );
+		}
+
+		string in = nested(1023);
+		AttributeTester o = QuantumJson::Parse(in);
+		REQUIRE( o.attr1 == "val1" );
+	}
+
+	SECTION( "Truncated subtree" )
+	{
+		// Cut at every offset, into exact size buffers so reads past the
+		// end are caught by sanitizers. Trusted input needn't fail, but must
+		// not read past the end either.
+		string in = R"({"unknown": [1, -2.5e3, {"a": "}]\"{", "b": [true, false, null, []]}, null],)"
+		            R"( "attr1": "val1"})";
+		for (size_t len = 0; len < in.size(); ++len)
+		{
+			INFO( in.substr(0, len) );
+			vector<char> buf(in.begin(), in.begin() + len);
+			REQUIRE_THROWS_WITH([&](){
+			        AttributeTester o = QuantumJson::Parse(buf.data(), buf.data() + len);
+			    }(),
+			    "Unexpected EOF" );
+			REQUIRE_THROWS_WITH([&](){
+			        AttributeTester o = QuantumJson::Parse(buf.begin(), buf.end());
+			    }(),
+			    "Unexpected EOF" );
+			try
+			{
+				AttributeTester o = QuantumJson::Parse<QuantumJson::Trusted>(buf.data(), buf.data() + len);
+			}
+			catch (const QuantumJson::JsonError &)
+			{
+			}
+		}
+	}
+}
+
+TEST_CASE("Integer types")
+{
+	SECTION( "Limits" )
+	{
+		string in = R"({
+		  "i32": -2147483648,
+		  "u32": 4294967295,
+		  "i64": -9223372036854775808,
+		  "u64": 18446744073709551615
+		})";
+		IntegerTypes o = QuantumJson::Parse(in);
+
+		REQUIRE( o.i32 == numeric_limits<int32_t>::min() );
+		REQUIRE( o.u32 == numeric_limits<uint32_t>::max() );
+		REQUIRE( o.i64 == numeric_limits<int64_t>::min() );
+		REQUIRE( o.u64 == numeric_limits<uint64_t>::max() );
+	}
+
+	SECTION( "Out of range" )
+	{
+		for (string in : { R"({"i32": 2147483648})",
+		                   R"({"u32": -1})",
+		                   R"({"i64": 9223372036854775808})",
+		                   R"({"u64": 18446744073709551616})",
+		                   R"({"u64": 100000000000000000000})" })
+		{
+			REQUIRE_THROWS_WITH([&](){
+			        IntegerTypes o = QuantumJson::Parse(in);
+			        (void)o;
+			    }(),
+			    "Number Out Of Range" );
+		}
+	}
+}
+
+TEST_CASE("String views")
+{
+	string in = R"({"name": "plain ç text", "tags": ["t1", "ç", "t\"3"]})";
+	const char *inBegin = in.data();
+	const char *inEnd = in.data() + in.size();
+
+	auto pointsIntoInput = [&](std::string_view v) {
+		return v.data() >= inBegin && v.data() + v.size() <= inEnd;
+	};
+
+	SECTION( "With storage" )
+	{
+		QuantumJson::StringStorage storage;
+		StringViews o = QuantumJson::Parse(in, storage);
+
+		REQUIRE( o.name == "plain ç text" );
+		REQUIRE( o.tags.size() == 3 );
+		REQUIRE( o.tags[0] == "t1" );
+		REQUIRE( o.tags[1] == "ç" );
+		REQUIRE( o.tags[2] == "t\"3" );
+
+		// Only escaped strings are copied
+		REQUIRE( pointsIntoInput(o.name) );
+		REQUIRE( pointsIntoInput(o.tags[0]) );
+		REQUIRE( pointsIntoInput(o.tags[1]) );
+		REQUIRE( !pointsIntoInput(o.tags[2]) );
+		REQUIRE( storage.strings.size() == 1 );
+	}
+
+	SECTION( "Without escapes" )
+	{
+		string in = "{\"name\": \"caf\xc3\xa9\", \"tags\": [\"t1\"]}";
+		StringViews o = QuantumJson::Parse(in);
+
+		REQUIRE( o.name == "caf\xc3\xa9" );
+		REQUIRE( o.tags[0] == "t1" );
+		REQUIRE( o.name.data() > in.data() );
+		REQUIRE( o.name.data() < in.data() + in.size() );
+	}
+
+	SECTION( "Without storage" )
+	{
+		REQUIRE_THROWS_WITH([&](){
+		        StringViews o = QuantumJson::Parse(in);
+		    }(),
+		    "Missing String Storage" );
+	}
+
+	SECTION( "Errors without storage" )
+	{
+		const vector<pair<string, string>> cases = {
+			{ "{\"name\": \"a\x01\"}", "Control Character In String" },
+			{ "{\"name\": \"\xc3\"}", "Invalid UTF-8 Sequence" },
+			{ "{\"name\": \"abc", "Unexpected EOF" },
+			{ "{\"name\": 12}", "Unexpected Char" },
+			{ "{\"name\": \"\\q\"}", "Invalid Escape" },
+			{ "{\"name\": \"\\n\"}", "Missing String Storage" },
+		};
+		for (const auto &c : cases)
+		{
+			INFO( c.first );
+			REQUIRE_THROWS_WITH([&](){
+			        StringViews o = QuantumJson::Parse(c.first);
+			    }(),
+			    c.second );
+		}
+	}
+
+	SECTION( "Invalid UTF-8" )
+	{
+		QuantumJson::StringStorage storage;
+		string in = "{\"name\": \"\xc3\"}";
+		REQUIRE_THROWS_WITH([&](){
+		        StringViews o = QuantumJson::Parse(in, storage);
+		    }(),
+		    "Invalid UTF-8 Sequence" );
+	}
+
+	SECTION( "Serialize" )
+	{
+		QuantumJson::StringStorage storage;
+		StringViews o = QuantumJson::Parse(in, storage);
+
+		REQUIRE( QuantumJson::Serialize(o) ==
+		         "{\"name\":\"plain ç text\",\"tags\":[\"t1\",\"ç\",\"t\\\"3\"]}" );
+	}
+}
+
+TEST_CASE("Merging strings")
+{
+	Item obj;
+	obj.MergeFromJson(R"({"name": "first"})");
+	obj.MergeFromJson(R"({"name": "second"})");
+
+	REQUIRE( obj.name == "second" );
+}
+
+TEST_CASE("Parse into existing object")
+{
+	ReusedDocument doc;
+	QuantumJson::ParseInto(doc, R"({
+	  "title": "a long title that needs heap allocation",
+	  "items": [{"name": "a long item name that needs heap allocation"},
+	            {"name": "another long item name with heap allocation"},
+	            {"name": "third"}],
+	  "groups": {"g1": [1, 2, 3, 4], "g2": [5]}
+	})");
+
+	REQUIRE( doc.items.size() == 3 );
+
+	const char *titleBuf = doc.title.data();
+	const Item *itemsBuf = doc.items.data();
+	const char *item0Buf = doc.items[0].name.data();
+	const int *g1Buf = doc.groups.at("g1").data();
+
+	QuantumJson::ParseInto(doc, R"({
+	  "title": "another title, also long enough",
+	  "items": [{"name": "replaced item name, still long"},
+	            {"name": "short"}],
+	  "groups": {"g1": [7, 8], "g3": [9]}
+	})");
+
+	REQUIRE( doc.title == "another title, also long enough" );
+	REQUIRE( doc.items.size() == 2 );
+	REQUIRE( doc.items[0].name == "replaced item name, still long" );
+	REQUIRE( doc.items[1].name == "short" );
+	REQUIRE( doc.groups.size() == 2 );
+	REQUIRE( doc.groups.at("g1") == vector<int>{7, 8} );
+	REQUIRE( doc.groups.at("g3") == vector<int>{9} );
+
+	// Buffers from the first parse are reused
+	REQUIRE( doc.title.data() == titleBuf );
+	REQUIRE( doc.items.data() == itemsBuf );
+	REQUIRE( doc.items[0].name.data() == item0Buf );
+	REQUIRE( doc.groups.at("g1").data() == g1Buf );
+
+	// Grows past the old size
+	QuantumJson::ParseInto(doc, R"({"items": [{"name": "1"}, {"name": "2"}, {"name": "3"}, {"name": "4"}]})");
+	REQUIRE( doc.items.size() == 4 );
+	REQUIRE( doc.items[3].name == "4" );
+}
+
+TEST_CASE("Padded input")
+{
+	// Padding is filled with characters that would continue the last token,
+	// parser must not read them as input.
+	auto parsePadded = [](const string &json, char fill, auto *out)
+	{
+		vector<char> buf(json.size() + QuantumJson::PaddedInput::Padding, fill);
+		copy(json.begin(), json.end(), buf.begin());
+		using T = typename remove_pointer<decltype(out)>::type;
+		T val = QuantumJson::Parse(QuantumJson::PaddedInput(buf.data(), json.size()));
+		*out = val;
+	};
+
+	SECTION( "Objects" )
+	{
+		string json = R"({"kind":"Listing","item":{"name":"x"},"unknown":[1,true,null],)"
+		              R"("array-field":["a","b\"c"],"after":"end"})";
+		for (char fill : {' ', '"', '}', 'a'})
+		{
+			Listing l;
+			parsePadded(json, fill, &l);
+			REQUIRE( l.kind == "Listing" );
+			REQUIRE( l.item.name == "x" );
+			REQUIRE( l.arrayField == vector<string>{"a", "b\"c"} );
+			REQUIRE( l.after == "end" );
+		}
+	}
+
+	SECTION( "Values ending at the end of input" )
+	{
+		for (char fill : {'0', '9', 'e', '"'})
+		{
+			int i;
+			parsePadded("12345", fill, &i);
+			REQUIRE( i == 12345 );
+
+			uint64_t u;
+			parsePadded("123456789012", fill, &u);
+			REQUIRE( u == 123456789012ULL );
+
+			double d;
+			parsePadded("1.25", fill, &d);
+			REQUIRE( d == 1.25 );
+
+			string s;
+			parsePadded(R"("abc")", fill, &s);
+			REQUIRE( s == "abc" );
+
+			bool b;
+			parsePadded("true", fill, &b);
+			REQUIRE( b == true );
+
+			vector<int> v;
+			parsePadded("[1,22,333]", fill, &v);
+			REQUIRE( v == vector<int>{1, 22, 333} );
+		}
+	}
+
+	SECTION( "Pretty printed" )
+	{
+		vector<int> v;
+		parsePadded("[\n    1,\n    2\n]\n    ", ' ', &v);
+		REQUIRE( v == vector<int>{1, 2} );
+
+		// Only whitespace follows in the padding
+		vector<char> buf(6 + QuantumJson::PaddedInput::Padding, ' ');
+		copy_n("[1,   ", 6, buf.begin());
+		buf.back() = ']';
+		REQUIRE_THROWS_WITH(
+		    [&]() { vector<int> l = QuantumJson::Parse(QuantumJson::PaddedInput(buf.data(), 6)); }(),
+		    "Unexpected EOF" );
+	}
+
+	SECTION( "Truncated input" )
+	{
+		// Continuing with the padding would complete these
+		vector<string> truncated = {
+			R"({"kind":"Listing","item":{"na)",
+			R"({"kind":"Listing","item")",
+			R"({"kind":"Listing","unknown)",
+			R"(["abc)",
+			R"([1,tru)",
+		};
+		for (const string &json : truncated)
+		{
+			vector<char> buf(json.size() + QuantumJson::PaddedInput::Padding, '"');
+			string completion = R"(me":"x"}})";
+			copy(completion.begin(), completion.end(), buf.begin() + json.size());
+			copy(json.begin(), json.end(), buf.begin());
+
+			QuantumJson::PaddedInput input(buf.data(), json.size());
+			if (json[0] == '{')
+			{
+				REQUIRE_THROWS_WITH( [&]() { Listing l = QuantumJson::Parse(input); }(),
+				                     "Unexpected EOF" );
+			}
+			else if (json[1] == '"')
+			{
+				REQUIRE_THROWS( [&]() { vector<string> l = QuantumJson::Parse(input); }() );
+			}
+			else
+			{
+				REQUIRE_THROWS( [&]() { vector<bool> l = QuantumJson::Parse(input); }() );
+			}
+		}
+	}
+
+	SECTION( "Parse into existing object" )
+	{
+		string json = R"({"title":"t","items":[{"name":"a"}],"groups":{"g":[1]}})";
+		vector<char> buf(json.size() + QuantumJson::PaddedInput::Padding);
+		copy(json.begin(), json.end(), buf.begin());
+
+		ReusedDocument doc;
+		QuantumJson::ParseInto(doc, QuantumJson::PaddedInput(buf.data(), json.size()));
+		REQUIRE( doc.title == "t" );
+		REQUIRE( doc.items.size() == 1 );
+		REQUIRE( doc.groups.at("g") == vector<int>{1} );
+	}
+}
+
+TEST_CASE("Trusted input")
+{
+	string in = R"({"kind":"Listing","item":{"name":"x"},"unknown":[1,true,null,{"a":"\u00e9\"]"}],)"
+	            R"("array-field":["a","b\"c"],"after":"end"})";
+	Listing l = QuantumJson::Parse<QuantumJson::Trusted>(in);
+	REQUIRE( l.kind == "Listing" );
+	REQUIRE( l.item.name == "x" );
+	REQUIRE( l.arrayField == vector<string>{"a", "b\"c"} );
+	REQUIRE( l.after == "end" );
+
+	// Values skipped with the vectorized skipper
+	string large = R"({"unknown": [)";
+	for (int i = 0; i < 20; ++i)
+	{
+		large += R"({"\"q\"": "]]]\\\"}}} long enough to cross blocks", "n": -1.5e3},)";
+	}
+	large += R"(false], "attr1": "val1"})";
+	AttributeTester o = QuantumJson::Parse<QuantumJson::Trusted>(large);
+	REQUIRE( o.attr1 == "val1" );
+
+	// Cut at every offset, into exact size buffers so reads past the end
+	// are caught by sanitizers
+	string typed = R"({"intField": -12, "doubleField": 1.5e-3, "stringField": "s\\\/é",)"
+	               R"( "boolField": true, "structField": {"field": ["a", "b\"c"]}, "x": null})";
+	for (const string &doc : {in, typed})
+	{
+		for (size_t len = 0; len < doc.size(); ++len)
+		{
+			INFO( doc.substr(0, len) );
+			vector<char> buf(doc.begin(), doc.begin() + len);
+			try
+			{
+				Listing l = QuantumJson::Parse<QuantumJson::Trusted>(buf.data(), buf.data() + len);
+			}
+			catch (const QuantumJson::JsonError &)
+			{
+			}
+			try
+			{
+				FieldTypes f = QuantumJson::Parse<QuantumJson::Trusted>(buf.begin(), buf.end());
+			}
+			catch (const QuantumJson::JsonError &)
+			{
+			}
+		}
+	}
+}
+
+TEST_CASE("On-demand views")
+{
+	QuantumJson::StructuralIndex index;
+
+	SECTION( "Fields" )
+	{
+		string in = R"({"kind": "Listing", "unknown": [1, {"a": "}]\"{"}, null],)"
+		            R"( "item": {"name": "xé"}, "before": "a long string that crosses a block boundary",)"
+		            R"( "array-field": ["a", "b\"c"]})";
+		Listing::View l = QuantumJson::ParseView<Listing>(in, index);
+
+		REQUIRE( l.kind() == "Listing" );
+		REQUIRE( l.item().name() == "xé" );
+		REQUIRE( l.before() == "a long string that crosses a block boundary" );
+		REQUIRE( l.after() == "" );
+		REQUIRE( l.arrayField().size() == 2 );
+		REQUIRE( l.arrayField()[1] == "b\"c" );
+	}
+
+	SECTION( "Lists" )
+	{
+		string in = R"({"items": [{"name": "a"}, {}, {"name": "c", "extra": [[]]}]})";
+		ItemList::View list = QuantumJson::ParseView<ItemList>(in, index);
+
+		vector<string> names;
+		for (Item::View item : list.items())
+		{
+			names.push_back(item.name());
+		}
+		REQUIRE( names == vector<string>{"a", "", "c"} );
+
+		auto items = QuantumJson::ParseView<vector<Item>>("[ ]", index);
+		REQUIRE( items.empty() );
+	}
+
+	SECTION( "Nullable fields" )
+	{
+		SkipNullTester::View o = QuantumJson::ParseView<SkipNullTester>(
+		    R"({"attr_accepting_null": null, "attr_regular": null})", index);
+		REQUIRE( o.attr_accepting_null() == "" );
+		REQUIRE_THROWS_WITH( o.attr_regular(), "Unexpected Char" );
+	}
+
+	SECTION( "Duplicate fields" )
+	{
+		Item::View item = QuantumJson::ParseView<Item>(R"({"name": "a", "name": "b"})", index);
+		REQUIRE( item.name() == "b" );
+	}
+
+	SECTION( "String views" )
+	{
+		StringViews::View o = QuantumJson::ParseView<StringViews>(
+		    R"({"name": "plain", "tags": ["esc\naped"]})", index);
+		REQUIRE( o.name() == "plain" );
+		REQUIRE( o.tags()[0] == "esc\naped" );
+
+		// Unescaped once, however many times it is read
+		string_view first = o.tags()[0];
+		for (int i = 0; i < 10; ++i)
+		{
+			REQUIRE( o.tags()[0].data() == first.data() );
+		}
+		REQUIRE( index.unescapedStrings.size() == 1 );
+	}
+
+	SECTION( "Only read values are validated" )
+	{
+		Listing::View l = QuantumJson::ParseView<Listing>(
+		    R"({"kind": 12, "before": "\x", "after": "ok", "item": []})", index);
+		REQUIRE( l.after() == "ok" );
+		REQUIRE_THROWS_WITH( l.kind(), "Unexpected Char" );
+		REQUIRE_THROWS_WITH( l.before(), "Invalid Escape" );
+		REQUIRE_THROWS_WITH( l.item(), "Unexpected Char" );
+	}
+
+	SECTION( "Invalid structure" )
+	{
+		REQUIRE_THROWS_WITH( QuantumJson::ParseView<Item>(R"({"name": "a")", index),
+		                     "Unexpected EOF" );
+		REQUIRE_THROWS_WITH( QuantumJson::ParseView<Item>(R"({"name": "a"])", index),
+		                     "Unexpected Char" );
+		REQUIRE_THROWS_WITH( QuantumJson::ParseView<Item>(R"({"name": "a)", index),
+		                     "Unexpected EOF" );
+		REQUIRE_THROWS_WITH( QuantumJson::ParseView<Item>(R"(["name"])", index),
+		                     "Unexpected Char" );
+
+		Item::View item = QuantumJson::ParseView<Item>(R"({"name": "a" "other": 1})", index);
+		REQUIRE_THROWS_WITH( item.name(), "Unexpected Char" );
+	}
+
+	SECTION( "Errors are thrown on each access" )
+	{
+		Listing::View l = QuantumJson::ParseView<Listing>(R"({"kind": "a", 5: 1, "after": "z"})", index);
+		REQUIRE_THROWS_WITH( l.after(), "Unexpected Char" );
+		REQUIRE_THROWS_WITH( l.after(), "Unexpected Char" );
+		REQUIRE_THROWS_WITH( l.kind(), "Unexpected Char" );
+
+		auto items = QuantumJson::ParseView<vector<Item>>(R"([{"name": "a"} {}])", index);
+		REQUIRE_THROWS_WITH( items.size(), "Unexpected Char" );
+		REQUIRE_THROWS_WITH( items.size(), "Unexpected Char" );
+		REQUIRE_THROWS_WITH( items[0], "Unexpected Char" );
+	}
+}
+
+TEST_CASE("Parallel lists")
+{
+	// Large enough to be split between threads
+	string items = "[";
+	for (int i = 0; i < 5000; ++i)
+	{
+		items += (i ? ", " : "") + string(R"({"name": "item \")") + to_string(i) + R"(", "skipped": [1, {}]})";
+	}
+	items += "]";
+
+	SECTION( "Top level list" )
+	{
+		vector<Item> expected = QuantumJson::Parse(items);
+		vector<Item> parsed = QuantumJson::Parse(items).Threads(4);
+
+		REQUIRE( parsed.size() == 5000 );
+		for (size_t i = 0; i < parsed.size(); ++i)
+		{
+			REQUIRE( parsed[i].name == expected[i].name );
+		}
+	}
+
+	SECTION( "Fields" )
+	{
+		string groups = "[";
+		for (int i = 0; i < 20000; ++i)
+		{
+			groups += (i ? ",[" : "[") + to_string(i) + ",2]";
+		}
+		groups += "]";
+
+		string in = R"({"items": )" + items + R"(, "groups": )" + groups + R"(, "title": "t"})";
+		ParallelList l = QuantumJson::Parse(in).Threads(3);
+
+		REQUIRE( l.title == "t" );
+		REQUIRE( l.items.size() == 5000 );
+		REQUIRE( l.items[4999].name == "item \"4999" );
+		REQUIRE( l.groups.size() == 20000 );
+		REQUIRE( l.groups[12345] == vector<int>{12345, 2} );
+
+		// Same result without threads
+		ParallelList sequential = QuantumJson::Parse(in);
+		REQUIRE( sequential.items.size() == 5000 );
+		REQUIRE( sequential.groups[12345] == vector<int>{12345, 2} );
+	}
+
+	SECTION( "Errors" )
+	{
+		using Items = vector<Item>;
+
+		string badElement = items;
+		badElement.replace(badElement.find(R"("item \"2500")"), 1, "1");
+		REQUIRE_THROWS_WITH( Items(QuantumJson::Parse(badElement).Threads(4)), "Unexpected Char" );
+
+		string missingComma = items;
+		missingComma.replace(missingComma.find(R"(, {"name": "item \"3000")"), 1, " ");
+		REQUIRE_THROWS_WITH( Items(QuantumJson::Parse(missingComma).Threads(4)), "Unexpected Char" );
+
+		string scalars = "[1 2" + string(70000, ' ') + ", 3]";
+		using Ints = vector<int>;
+		REQUIRE_THROWS_WITH( Ints(QuantumJson::Parse(scalars).Threads(4)), "Unexpected Char" );
+
+		string truncated = items.substr(0, items.size() - 1);
+		REQUIRE_THROWS_WITH( Items(QuantumJson::Parse(truncated).Threads(4)), "Unexpected EOF" );
+	}
+}
+
+TEST_CASE("Json lines")
+{
+	// Enough lines for several batches, with a few invalid ones
+	string in;
+	for (int i = 1; i <= 20000; ++i)
+	{
+		if (i % 5000 == 0)
+		{
+			in += R"({"name": "item)" + to_string(i) + "\n";
+		}
+		else if (i % 7000 == 0)
+		{
+			in += "  \r\n";
+		}
+		else
+		{
+			in += R"({"name": "item)" + to_string(i) + "\"}\r\n";
+		}
+	}
+	in += R"({"name": "last"} {})";
+
+	auto check = [&](int threads, bool unordered)
+	{
+		std::mutex mutex;
+		std::map<size_t, string> values;
+		std::map<size_t, string> errors;
+		size_t lastLine = 0;
+		bool inOrder = true;
+
+		auto lines = QuantumJson::ParseLines<Item>(in).Threads(threads);
+		if (unordered)
+		{
+			lines.Unordered();
+		}
+		size_t failed = lines.ForEach(
+			[&](size_t line, Item &item)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				inOrder = inOrder && line > lastLine;
+				lastLine = line;
+				values[line] = std::move(item.name);
+			},
+			[&](size_t line, const QuantumJson::JsonError &error)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				inOrder = inOrder && line > lastLine;
+				lastLine = line;
+				errors[line] = error.what();
+			});
+
+		REQUIRE( failed == 5 );
+		REQUIRE( errors.size() == 5 );
+		REQUIRE( errors[5000] == "Unexpected EOF" );
+		REQUIRE( errors[20000] == "Unexpected EOF" );
+		REQUIRE( errors[20001] == "Unexpected Char" );
+		REQUIRE( values.size() == 20000 - 4 - 2 );
+		REQUIRE( values.count(7000) == 0 );
+		REQUIRE( values[1] == "item1" );
+		REQUIRE( values[19999] == "item19999" );
+		if (!unordered)
+		{
+			REQUIRE( inOrder );
+		}
+	};
+
+	SECTION( "Sequential" )
+	{
+		check(1, false);
+	}
+
+	SECTION( "Threads" )
+	{
+		check(4, false);
+	}
+
+	SECTION( "Unordered" )
+	{
+		check(3, true);
+	}
+
+	SECTION( "Callback exceptions" )
+	{
+		size_t calls = 0;
+		auto parse = [&]()
+		{
+			QuantumJson::ParseLines<Item>(in).Threads(4).ForEach(
+				[&](size_t, Item &) { if (++calls == 9000) throw std::runtime_error("stop"); },
+				[](size_t, const QuantumJson::JsonError &) {});
+		};
+		REQUIRE_THROWS_WITH( parse(), "stop" );
+		REQUIRE( calls == 9000 );
+	}
+
+	SECTION( "Missing fields" )
+	{
+		// Fields not in the line are value initialized, like the values
+		// parsed by threads
+		vector<FieldTypes> values;
+		QuantumJson::ParseLines<FieldTypes>(string("{}\n{\"intField\": 3}\n{}")).ForEach(
+			[&](size_t, FieldTypes &f) { values.push_back(f); },
+			[](size_t, const QuantumJson::JsonError &) {});
+		REQUIRE( values.size() == 3 );
+		REQUIRE( values[0].intField == 0 );
+		REQUIRE( values[0].doubleField == 0 );
+		REQUIRE( values[1].intField == 3 );
+		REQUIRE( values[2].intField == 0 );
+	}
+}
+
+TEST_CASE("File input")
+{
+	const string path = (filesystem::temp_directory_path() / "QuantumJsonFileInput.json").string();
+	auto write = [&](const string &content)
+	{
+		ofstream(path, ios::binary) << content;
+	};
+
+	SECTION( "Parse file" )
+	{
+		write(R"({"name": "from file"})");
+		Item item = QuantumJson::ParseFile<Item>(path);
+		REQUIRE( item.name == "from file" );
+
+		Item trusted = QuantumJson::ParseFile<Item, QuantumJson::Trusted>(path);
+		REQUIRE( trusted.name == "from file" );
+	}
+
+	SECTION( "Ends at a page boundary" )
+	{
+		// A string up to the last byte of the page is read in padded blocks
+		const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+		write(R"([")" + string(pageSize - 4, 'a') + R"("])");
+		REQUIRE( filesystem::file_size(path) == pageSize );
+
+		vector<string> strings = QuantumJson::ParseFile<vector<string>>(path);
+		REQUIRE( strings.size() == 1 );
+		REQUIRE( strings[0].size() == pageSize - 4 );
+	}
+
+	SECTION( "Mapped file" )
+	{
+		write(R"({"name": "view", "tags": ["a", "b\"c"]})");
+		QuantumJson::MappedFile file(path);
+		QuantumJson::StringStorage storage;
+		StringViews v = QuantumJson::Parse(file.Input(), storage);
+		REQUIRE( v.name == "view" );
+		REQUIRE( v.tags[1] == "b\"c" );
+	}
+
+	SECTION( "Errors" )
+	{
+		write("");
+		REQUIRE_THROWS_WITH( QuantumJson::ParseFile<Item>(path), "Unexpected EOF" );
+
+		filesystem::remove(path);
+		REQUIRE_THROWS_AS( QuantumJson::ParseFile<Item>(path), std::system_error );
+	}
+
+	filesystem::remove(path);
+}
+
+// Chunked inputs are cut at every offset of this, so their end of input is
+// met within each kind of value, parsed or skipped
+static const string truncatedJson = R"({"x": [1, -2.5e3, {"a": "}]\"{"}, true, null],)"
+                                    R"( "items": [{"name": "a\"b\u00e9"}, {"name": "c"}]})";
+
+TEST_CASE("Push parser")
+{
+	string in = R"({"items": [)";
+	for (int i = 0; i < 3000; ++i)
+	{
+		in += (i ? ", " : "") + string(R"({"name": "item \")") + to_string(i) + R"(", "skipped": [1, {"a": "b"}]})";
+	}
+	in += "]}";
+
+	auto feed = [](QuantumJson::PushParser<ItemList> &parser, const string &json, size_t chunkSize)
+	{
+		for (size_t i = 0; i < json.size(); i += chunkSize)
+		{
+			parser.Feed(string_view(json).substr(i, chunkSize));
+		}
+	};
+
+	SECTION( "Chunks" )
+	{
+		for (size_t chunkSize : {1, 7, 4096, 1 << 20})
+		{
+			QuantumJson::PushParser<ItemList> parser;
+			feed(parser, in, chunkSize);
+			ItemList l = parser.Finish();
+
+			REQUIRE( l.items.size() == 3000 );
+			REQUIRE( l.items[0].name == "item \"0" );
+			REQUIRE( l.items[2999].name == "item \"2999" );
+		}
+	}
+
+	SECTION( "Bounded buffering" )
+	{
+		QuantumJson::PushParser<ItemList> parser(1024);
+		feed(parser, in, 100);
+		REQUIRE( parser.Finish().items.size() == 3000 );
+	}
+
+	SECTION( "Truncated" )
+	{
+		// Cut at every offset, and split in two so the end of input is
+		// reached both within a chunk and right after one
+		for (size_t len = 0; len < truncatedJson.size(); ++len)
+		{
+			INFO( truncatedJson.substr(0, len) );
+			QuantumJson::PushParser<ItemList> parser;
+			parser.Feed(string_view(truncatedJson).substr(0, len / 2));
+			parser.Feed(string_view(truncatedJson).substr(len / 2, len - len / 2));
+			REQUIRE_THROWS_WITH( parser.Finish(), "Unexpected EOF" );
+		}
+	}
+
+	SECTION( "Errors" )
+	{
+		// Chunks after an error are not needed
+		QuantumJson::PushParser<ItemList> invalid(64);
+		REQUIRE( invalid.Feed(R"({"items": 1})") );
+		bool stopped = false;
+		for (int i = 0; i < 1000 && !stopped; ++i)
+		{
+			stopped = !invalid.Feed(in);
+		}
+		REQUIRE( stopped );
+		REQUIRE_THROWS_WITH( invalid.Finish(), "Unexpected Char" );
+	}
+
+	SECTION( "Numbers needing exact rounding" )
+	{
+		// Rounded by the digits after the first 19, split at every position
+		string numbers = "[9007199254740993.00000000000000000001, "
+		                 "1.00000000000000011102230246251565404236316680908203126]";
+		for (size_t split = 1; split < numbers.size(); ++split)
+		{
+			QuantumJson::PushParser<vector<double>> parser;
+			parser.Feed(string_view(numbers).substr(0, split));
+			parser.Feed(string_view(numbers).substr(split));
+			REQUIRE( parser.Finish() == vector<double>{9007199254740994.0, 1.00000000000000022} );
+		}
+	}
+
+	SECTION( "Missing fields" )
+	{
+		QuantumJson::PushParser<FieldTypes> parser;
+		parser.Feed(R"({"stringField": "s"})");
+		FieldTypes f = parser.Finish();
+		REQUIRE( f.intField == 0 );
+		REQUIRE( f.doubleField == 0 );
+		REQUIRE( f.stringField == "s" );
+	}
+
+	SECTION( "Abandoned" )
+	{
+		QuantumJson::PushParser<ItemList> parser;
+		parser.Feed(in.substr(0, 1000));
+	}
+}
+
+TEST_CASE("File descriptor input")
+{
+	string in = R"({"items": [)";
+	for (int i = 0; i < 5000; ++i)
+	{
+		in += (i ? ",\n  " : "") + string(R"({"name": "item \")") + to_string(i) + R"(", "skipped": [1, {"a": "b c d"}]})";
+	}
+	in += "]}";
+
+	// Parses `in` written to a pipe in small pieces
+	auto parsePipe = [&](bool readAhead, size_t chunkSize)
+	{
+		int fds[2];
+		REQUIRE( pipe(fds) == 0 );
+		std::thread writer([&]()
+		{
+			for (size_t i = 0; i < in.size(); )
+			{
+				ssize_t n = write(fds[1], in.data() + i, std::min<size_t>(1000, in.size() - i));
+				if (n <= 0)
+				{
+					break;
+				}
+				i += n;
+			}
+			close(fds[1]);
+		});
+
+		ItemList l;
+		{
+			QuantumJson::FdInput input(fds[0], chunkSize);
+			if (readAhead)
+			{
+				input.ReadAhead();
+			}
+			l = QuantumJson::Parse(input);
+		}
+		writer.join();
+		close(fds[0]);
+		return l;
+	};
+
+	SECTION( "Pipe" )
+	{
+		for (size_t chunkSize : {7, 4096, 65536})
+		{
+			ItemList l = parsePipe(false, chunkSize);
+			REQUIRE( l.items.size() == 5000 );
+			REQUIRE( l.items[4999].name == "item \"4999" );
+		}
+	}
+
+	SECTION( "Read ahead" )
+	{
+		for (size_t chunkSize : {7, 4096, 65536})
+		{
+			ItemList l = parsePipe(true, chunkSize);
+			REQUIRE( l.items.size() == 5000 );
+			REQUIRE( l.items[4999].name == "item \"4999" );
+		}
+	}
+
+	SECTION( "Errors" )
+	{
+		QuantumJson::FdInput badFd(-1);
+		REQUIRE_THROWS_AS( ItemList(QuantumJson::Parse(badFd)), std::system_error );
+
+		QuantumJson::FdInput badFdReadAhead(-1);
+		badFdReadAhead.ReadAhead();
+		REQUIRE_THROWS_AS( ItemList(QuantumJson::Parse(badFdReadAhead)), std::system_error );
+
+	}
+
+	SECTION( "Truncated" )
+	{
+		for (bool readAhead : {false, true})
+		{
+			for (size_t len = 0; len < truncatedJson.size(); ++len)
+			{
+				INFO( truncatedJson.substr(0, len) );
+				int fds[2];
+				REQUIRE( pipe(fds) == 0 );
+				REQUIRE( write(fds[1], truncatedJson.data(), len) == ssize_t(len) );
+				close(fds[1]);
+				{
+					QuantumJson::FdInput input(fds[0], 7);
+					if (readAhead)
+					{
+						input.ReadAhead();
+					}
+					REQUIRE_THROWS_WITH( ItemList(QuantumJson::Parse(input)), "Unexpected EOF" );
+				}
+				close(fds[0]);
+			}
+		}
+	}
+
+	SECTION( "Stopped early" )
+	{
+		// The reader stops waiting for input once the parse fails, leaving
+		// the rest of the stream unread
+		int fds[2];
+		REQUIRE( pipe(fds) == 0 );
+		REQUIRE( write(fds[1], "[1, x", 5) == 5 );
+		{
+			QuantumJson::FdInput input(fds[0]);
+			REQUIRE_THROWS_WITH( vector<int>(QuantumJson::Parse(input.ReadAhead())), "Unexpected Token" );
+		}
+
+		REQUIRE( write(fds[1], "rest", 4) == 4 );
+		char buf[8];
+		REQUIRE( read(fds[0], buf, sizeof(buf)) == 4 );
+		close(fds[0]);
+		close(fds[1]);
+	}
+
+	SECTION( "Numbers needing exact rounding" )
+	{
+		string numbers = "[9007199254740993.00000000000000000001, "
+		                 "1.00000000000000011102230246251565404236316680908203126]";
+		for (bool readAhead : {false, true})
+		{
+			for (size_t chunkSize : {7, 16, 4096})
+			{
+				int fds[2];
+				REQUIRE( pipe(fds) == 0 );
+				REQUIRE( write(fds[1], numbers.data(), numbers.size()) == ssize_t(numbers.size()) );
+				close(fds[1]);
+
+				vector<double> v;
+				{
+					QuantumJson::FdInput input(fds[0], chunkSize);
+					if (readAhead)
+					{
+						input.ReadAhead();
+					}
+					v = vector<double>(QuantumJson::Parse(input));
+				}
+				close(fds[0]);
+				REQUIRE( v == vector<double>{9007199254740994.0, 1.00000000000000022} );
+			}
+		}
+	}
+}
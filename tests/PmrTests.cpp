@@ -0,0 +1,127 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Mustafa Serdar Sanli
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <memory_resource>
+#include <string>
+
+#include "tests/SchemaPmr.gen.hpp"
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+// Forwards to upstream resource, counting allocations
+struct CountingResource : std::pmr::memory_resource
+{
+	explicit CountingResource(std::pmr::memory_resource *upstream)
+	  : upstream(upstream)
+	{
+	}
+
+	void* do_allocate(size_t bytes, size_t alignment) override
+	{
+		++allocations;
+		return upstream->allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void *p, size_t bytes, size_t alignment) override
+	{
+		upstream->deallocate(p, bytes, alignment);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource &o) const noexcept override
+	{
+		return this == &o;
+	}
+
+	std::pmr::memory_resource *upstream;
+	int allocations = 0;
+};
+
+static const string json = R"({
+  "title": "a title that does not fit in small string buffer",
+  "count": 3,
+  "items": [
+    {"name": "first item with a long name", "values": [1, 2, 3]},
+    {"name": "second item with a long name", "values": [4, 5]},
+    {"name": "third item with a long name", "values": []}
+  ],
+  "attrs": {"key with a long name": "value with a long content"},
+  "main": {"name": "main item with a long name", "values": [6]}
+})";
+
+TEST_CASE("Types use pmr containers")
+{
+	PmrDocument doc;
+
+	REQUIRE( typeid(doc.title) == typeid(std::pmr::string) );
+	REQUIRE( typeid(doc.items) == typeid(std::pmr::vector<PmrItem>) );
+	REQUIRE( typeid(doc.attrs) == typeid(std::pmr::map<std::pmr::string, std::pmr::string>) );
+	REQUIRE( std::uses_allocator<PmrDocument, std::pmr::polymorphic_allocator<char>>::value );
+}
+
+TEST_CASE("Parse into arena")
+{
+	CountingResource defaultResource(std::pmr::new_delete_resource());
+	std::pmr::memory_resource *oldDefault = std::pmr::set_default_resource(&defaultResource);
+
+	std::pmr::monotonic_buffer_resource monotonic(std::pmr::new_delete_resource());
+	CountingResource arena(&monotonic);
+	{
+		PmrDocument doc = QuantumJson::Parse(json, arena);
+
+		// Nothing is allocated outside of the arena
+		int defaultAllocations = defaultResource.allocations;
+		std::pmr::set_default_resource(oldDefault);
+		REQUIRE( defaultAllocations == 0 );
+		REQUIRE( arena.allocations > 0 );
+
+		REQUIRE( doc.title == "a title that does not fit in small string buffer" );
+		REQUIRE( doc.count == 3 );
+		REQUIRE( doc.items.size() == 3 );
+		REQUIRE( doc.items[1].name == "second item with a long name" );
+		REQUIRE( doc.items[1].values == std::pmr::vector<int>{4, 5} );
+		REQUIRE( doc.attrs.at("key with a long name") == "value with a long content" );
+		REQUIRE( doc.main.values == std::pmr::vector<int>{6} );
+
+		REQUIRE( doc.items[2].name.get_allocator().resource() == &arena );
+		REQUIRE( doc.attrs.begin()->second.get_allocator().resource() == &arena );
+		REQUIRE( doc.main.name.get_allocator().resource() == &arena );
+	}
+}
+
+TEST_CASE("Parse pmr types without arena")
+{
+	PmrDocument doc = QuantumJson::Parse(json);
+
+	REQUIRE( doc.items[0].name == "first item with a long name" );
+	REQUIRE( doc.items[0].name.get_allocator().resource() == std::pmr::get_default_resource() );
+}
+
+TEST_CASE("Serialize pmr types")
+{
+	std::pmr::monotonic_buffer_resource arena;
+	PmrDocument doc = QuantumJson::Parse(R"({"title":"t","count":1,"items":[{"name":"n","values":[1]}],"attrs":{"k":"v"},"main":{"name":"m","values":[]}})", arena);
+
+	REQUIRE( QuantumJson::Serialize(doc) ==
+	         R"({"title":"t","count":1,"items":[{"name":"n","values":[1]}],"attrs":{"k":"v"},"main":{"name":"m","values":[]}})" );
+}
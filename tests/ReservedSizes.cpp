@@ -29,9 +29,6 @@
 
 using namespace std;
 
-// Tests are only valid when preallocation is enabled
-#if QUANTUMJON_PREALLOCATE_ON_RANDOMACCESSITERATOR
-
 TEST_CASE("Basic element type allocations check")
 {
 	string listValue16 = "[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16]";
@@ -119,5 +116,3 @@ TEST_CASE("Reserve list of strings")
 		CHECK( obj[2].capacity() > obj[0].capacity() );
 	}
 }
-
-#endif
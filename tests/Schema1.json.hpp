@@ -64,3 +64,31 @@ struct FieldTypes
 	string stringField;
 	AAAAAA structField;
 };
+
+struct IntegerTypes
+{
+	int32 i32;
+	uint32 u32;
+	int64 i64;
+	uint64 u64;
+};
+
+struct ReusedDocument
+{
+	string title;
+	vector<Item> items;
+	map< string, vector<int> > groups;
+};
+
+struct StringViews
+{
+	string_view name;
+	vector<string_view> tags;
+};
+
+struct ParallelList
+{
+	string title;
+	vector<Item> items [[ parallel ]];
+	vector<vector<int>> groups [[ parallel ]];
+};
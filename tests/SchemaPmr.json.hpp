@@ -0,0 +1,15 @@
+
+struct PmrItem
+{
+	string name;
+	vector<int> values;
+};
+
+struct PmrDocument
+{
+	string title;
+	int count;
+	vector<PmrItem> items;
+	map<string, string> attrs;
+	PmrItem main;
+};
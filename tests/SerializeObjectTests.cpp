@@ -87,3 +87,58 @@ TEST_CASE("Serialize object in list")
 
 	REQUIRE(out == "{\"items\":[{\"name\":\"i1\"},{\"name\":\"i2\"}]}");
 }
+
+TEST_CASE("Serialize object into string")
+{
+	AttributeTester obj;
+	obj.attr1 = "a1";
+	obj.attr2 = "a2";
+
+	REQUIRE(QuantumJson::Serialize(obj) == "{\"attr1\":\"a1\",\"attr-2\":\"a2\"}");
+
+	// Appends to existing content
+	std::string out = "[";
+	QuantumJson::SerializeInto(out, obj);
+	out += "]";
+	REQUIRE(out == "[{\"attr1\":\"a1\",\"attr-2\":\"a2\"}]");
+}
+
+TEST_CASE("Serialize large object into string")
+{
+	// Output spans many buffer chunks
+	ItemList obj;
+	for (int i = 0; i < 10000; ++i)
+	{
+		Item item;
+		item.name = "item-" + std::to_string(i);
+		obj.items.push_back(item);
+	}
+
+	std::string expected;
+	obj.SerializeTo(std::back_inserter(expected));
+
+	std::string out = QuantumJson::Serialize(obj);
+	REQUIRE(out.size() == expected.size());
+	REQUIRE(out == expected);
+}
+
+TEST_CASE("Serialize object with options")
+{
+	FieldTypes obj;
+	obj.intField = 1;
+	obj.doubleField = 3.14159265358979;
+	obj.stringField = "\xc3\xa7";
+
+	QuantumJson::SerializeOptions options;
+	options.doublePrecision = 6;
+	options.escapeNonAscii = true;
+
+	std::string out = QuantumJson::Serialize(obj, options);
+	REQUIRE(out.find("\"doubleField\":3.14159,") != std::string::npos);
+	REQUIRE(out.find("\"stringField\":\"\\u00e7\"") != std::string::npos);
+
+	out.clear();
+	QuantumJson::SerializeInto(out, obj);
+	REQUIRE(out.find("\"doubleField\":3.14159265358979,") != std::string::npos);
+	REQUIRE(out.find("\"stringField\":\"\xc3\xa7\"") != std::string::npos);
+}
@@ -20,6 +20,7 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <clocale>
 #include <cmath>
 #include <iostream>
 #include <iterator>
@@ -89,9 +90,8 @@ TEST_CASE("Serialize int64")
 
 TEST_CASE("Serialize double")
 {
-	// Some of the values in this test are platform dependent
-	// But since the significant digits are not maximal,
-	// they should be same for most? of the platforms.
+	// Doubles are written with the shortest representation that parses
+	// back to the same value.
 	string out;
 	Serializer s(std::back_inserter(out));
 
@@ -149,6 +149,44 @@ TEST_CASE("Serialize double")
 		s.SerializeValue(v);
 		REQUIRE(out == "0.4");
 	}
+	SECTION("0.1 + 0.2")
+	{
+		double v = 0.1 + 0.2;
+		s.SerializeValue(v);
+		REQUIRE(out == "0.30000000000000004");
+	}
+	SECTION("-0")
+	{
+		double v = -0.0;
+		s.SerializeValue(v);
+		REQUIRE(out == "-0");
+	}
+
+	// Large and small numbers
+	SECTION("1e20")
+	{
+		double v = 1e20;
+		s.SerializeValue(v);
+		REQUIRE(out == "100000000000000000000");
+	}
+	SECTION("1e21")
+	{
+		double v = 1e21;
+		s.SerializeValue(v);
+		REQUIRE(out == "1e+21");
+	}
+	SECTION("1e-6")
+	{
+		double v = 1e-6;
+		s.SerializeValue(v);
+		REQUIRE(out == "0.000001");
+	}
+	SECTION("1.5e-7")
+	{
+		double v = 1.5e-7;
+		s.SerializeValue(v);
+		REQUIRE(out == "1.5e-7");
+	}
 
 	// Invalid numbers, represented as null
 	SECTION("NaN")
@@ -175,49 +213,111 @@ TEST_CASE("Serialize double")
 	{
 		double v = numeric_limits<double>::min();
 		s.SerializeValue(v);
-		REQUIRE(out == "2.225073859e-308");
+		REQUIRE(out == "2.2250738585072014e-308");
 	}
 	SECTION("-min")
 	{
 		double v = -numeric_limits<double>::min();
 		s.SerializeValue(v);
-		REQUIRE(out == "-2.225073859e-308");
+		REQUIRE(out == "-2.2250738585072014e-308");
 	}
 	SECTION("max")
 	{
 		double v = numeric_limits<double>::max();
 		s.SerializeValue(v);
-		REQUIRE(out == "1.797693135e+308");
+		REQUIRE(out == "1.7976931348623157e+308");
 	}
 	SECTION("-max")
 	{
 		double v = -numeric_limits<double>::max();
 		s.SerializeValue(v);
-		REQUIRE(out == "-1.797693135e+308");
+		REQUIRE(out == "-1.7976931348623157e+308");
 	}
 	SECTION("epsilon")
 	{
 		double v = numeric_limits<double>::epsilon();
 		s.SerializeValue(v);
-		REQUIRE(out == "2.220446049e-16");
+		REQUIRE(out == "2.220446049250313e-16");
 	}
 	SECTION("-epsilon")
 	{
 		double v = -numeric_limits<double>::epsilon();
 		s.SerializeValue(v);
-		REQUIRE(out == "-2.220446049e-16");
+		REQUIRE(out == "-2.220446049250313e-16");
 	}
 	SECTION("denorm_min")
 	{
 		double v = numeric_limits<double>::denorm_min();
 		s.SerializeValue(v);
-		REQUIRE(out == "4.940656458e-324");
+		REQUIRE(out == "5e-324");
 	}
 	SECTION("-denorm_min")
 	{
 		double v = -numeric_limits<double>::denorm_min();
 		s.SerializeValue(v);
-		REQUIRE(out == "-4.940656458e-324");
+		REQUIRE(out == "-5e-324");
+	}
+}
+
+TEST_CASE("Serialize double with fixed precision")
+{
+	string out;
+	Serializer s(std::back_inserter(out));
+	s.doublePrecision = 6;
+
+	SECTION("pi")
+	{
+		double v = 3.14159265358979;
+		s.SerializeValue(v);
+		REQUIRE(out == "3.14159");
+	}
+	SECTION("max")
+	{
+		double v = numeric_limits<double>::max();
+		s.SerializeValue(v);
+		REQUIRE(out == "1.79769e+308");
+	}
+	SECTION("rounded from the exact value")
+	{
+		// Just below 2.675, rounding its shortest digits would give 2.68
+		s.doublePrecision = 3;
+		s.SerializeValue(2.675);
+		REQUIRE(out == "2.67");
+	}
+	SECTION("more digits than a double has")
+	{
+		s.doublePrecision = 40;
+		s.SerializeValue(-0.1);
+		REQUIRE(out == "-0.10000000000000001");
+	}
+	SECTION("locale independent")
+	{
+		// Only checked where a locale with a decimal comma is installed
+		const char *previous = setlocale(LC_NUMERIC, nullptr);
+		string saved = previous ? previous : "C";
+		for (const char *name : { "de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "fr_FR.utf8" })
+		{
+			if (setlocale(LC_NUMERIC, name) != nullptr)
+			{
+				break;
+			}
+		}
+		s.SerializeValue(1.5);
+		setlocale(LC_NUMERIC, saved.c_str());
+		REQUIRE(out == "1.5");
+	}
+}
+
+TEST_CASE("Double round trip")
+{
+	for (double v : { 0.1, 1.0 / 3, 51.50853, -0.12784, 6.02214076e23, 1.602176634e-19 })
+	{
+		string out;
+		Serializer s(std::back_inserter(out));
+		s.SerializeValue(v);
+
+		double parsed = QuantumJson::Parse(out);
+		REQUIRE( parsed == v );
 	}
 }
 
@@ -262,6 +362,40 @@ TEST_CASE("Serialize string")
 		s.SerializeValue(v);
 		REQUIRE(out == "\"\\b\\f\\r\"");
 	}
+	SECTION("all control chars")
+	{
+		std::string v("\x01\x1f\x7f", 3);
+		s.SerializeValue(v);
+		REQUIRE(out == "\"\\u0001\\u001f\x7f\"");
+	}
+	SECTION("long string with escapes")
+	{
+		// Runs longer than the vector width around each escape
+		std::string run(40, 'x');
+		std::string v = run + "\"" + run + "\x02" + run + "\xc3\xa7" + run;
+		s.SerializeValue(v);
+		REQUIRE(out == "\"" + run + "\\\"" + run + "\\u0002" + run + "\xc3\xa7" + run + "\"");
+	}
+	SECTION("non-ASCII kept as UTF-8")
+	{
+		std::string v = "\xc3\xa7\xe2\x82\xac\xf0\x9f\x98\x80";
+		s.SerializeValue(v);
+		REQUIRE(out == "\"" + v + "\"");
+	}
+	SECTION("non-ASCII escaped")
+	{
+		s.escapeNonAscii = true;
+		std::string v = "a\xc3\xa7\xe2\x82\xac\xf0\x9f\x98\x80\n";
+		s.SerializeValue(v);
+		REQUIRE(out == "\"a\\u00e7\\u20ac\\ud83d\\ude00\\n\"");
+	}
+	SECTION("malformed UTF-8 escaped")
+	{
+		s.escapeNonAscii = true;
+		std::string v = "\xc3-\xed\xa0\x80\xc0\xaf";
+		s.SerializeValue(v);
+		REQUIRE(out == "\"\\ufffd-\\ufffd\\ufffd\\ufffd\\ufffd\\ufffd\"");
+	}
 }
 
 TEST_CASE("Serialize list")
@@ -26,6 +26,7 @@
 
 #include <iostream>
 #include <iterator>
+#include <new>
 #include <sstream>
 
 #include "lib/Common.hpp"
@@ -37,6 +38,9 @@ using namespace std;
 int statsAllocationCount = 0;
 size_t statsLastAllocationSize = -1;
 
+// Allocations of this size or larger throw std::bad_alloc
+size_t failAllocationsFrom = -1;
+
 void resetAllocationStats()
 {
 	statsAllocationCount = 0;
@@ -48,6 +52,10 @@ void* operator new(size_t sz)
 {
 	statsAllocationCount++;
 	statsLastAllocationSize = sz;
+	if (sz >= failAllocationsFrom)
+	{
+		throw std::bad_alloc();
+	}
 	return malloc(sz);
 }
 
@@ -163,3 +171,22 @@ TEST_CASE("Minimal allocations check")
 	}
 }
 
+TEST_CASE("Allocation failures in parallel lists")
+{
+	// Large enough to be split between threads, with a string in the middle
+	// that fails to allocate in whichever thread parses it
+	string in = "[";
+	for (int i = 0; i < 2000; ++i)
+	{
+		in += (i == 1000) ? "\"" + string(256 * 1024, 'x') + "\"," : "\"short enough string\",";
+	}
+	in += "\"last\"]";
+
+	failAllocationsFrom = 128 * 1024;
+	REQUIRE_THROWS_AS( vector<string>(QuantumJson::Parse(in).Threads(4)), std::bad_alloc );
+	failAllocationsFrom = -1;
+
+	vector<string> out = QuantumJson::Parse(in).Threads(4);
+	REQUIRE( out.size() == 2001 );
+	REQUIRE( out[1000].size() == 256 * 1024 );
+}
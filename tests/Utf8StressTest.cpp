@@ -103,8 +103,8 @@ TEST_CASE("Case 2.1.5")
 	    0xf8, 0x88, 0x80, 0x80, 0x80,
 	'"', };
 
-	string out = PARSE(input);
-	REQUIRE( out == "\U00200000" );
+	// Not valid UTF-8, beyond U+10FFFF
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
 }
 
 TEST_CASE("Case 2.1.6")
@@ -113,8 +113,8 @@ TEST_CASE("Case 2.1.6")
 	    0xfc, 0x84, 0x80, 0x80, 0x80, 0x80,
 	'"', };
 
-	string out = PARSE(input);
-	REQUIRE( out == "\U04000000" );
+	// Not valid UTF-8, beyond U+10FFFF
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
 }
 
 TEST_CASE("Case 2.2.1")
@@ -153,8 +153,8 @@ TEST_CASE("Case 2.2.4")
 	    0xf7, 0xbf, 0xbf, 0xbf,
 	'"', };
 
-	string out = PARSE(input);
-	REQUIRE( out == "\U001fffff" );
+	// Not valid UTF-8, beyond U+10FFFF
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
 }
 
 TEST_CASE("Case 2.2.5")
@@ -163,8 +163,8 @@ TEST_CASE("Case 2.2.5")
 	    0xfb, 0xbf, 0xbf, 0xbf, 0xbf,
 	'"', };
 
-	string out = PARSE(input);
-	REQUIRE( out == "\U03ffffff" );
+	// Not valid UTF-8, beyond U+10FFFF
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
 }
 
 TEST_CASE("Case 2.2.6")
@@ -173,8 +173,8 @@ TEST_CASE("Case 2.2.6")
 	    0xfd, 0xbf, 0xbf, 0xbf, 0xbf, 0xbf,
 	'"', };
 
-	string out = PARSE(input);
-	REQUIRE( out == "\U7fffffff" );
+	// Not valid UTF-8, beyond U+10FFFF
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
 }
 
 TEST_CASE("Case 2.3.1")
@@ -223,8 +223,8 @@ TEST_CASE("Case 2.3.5")
 	    0xf4, 0x90, 0x80, 0x80,
 	'"', };
 
-	string out = PARSE(input);
-	REQUIRE( out == "\U00110000" );
+	// Not valid UTF-8, beyond U+10FFFF
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
 }
 
 TEST_CASE("Case 3.1.1")
@@ -460,7 +460,16 @@ TEST_CASE("Case 3.3.10")
 	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
 }
 
-// TODO Add case 3.4
+TEST_CASE("Case 3.4")
+{
+	unsigned char input[] = { '"',
+	    0xc0, 0xe0, 0x80, 0xf0, 0x80, 0x80, 0xf8, 0x80, 0x80, 0x80,
+	    0xfc, 0x80, 0x80, 0x80, 0x80, 0xdf, 0xef, 0xbf, 0xf7, 0xbf,
+	    0xbf, 0xfb, 0xbf, 0xbf, 0xbf, 0xfd, 0xbf, 0xbf, 0xbf, 0xbf,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
 
 TEST_CASE("Case 3.5.1")
 {
@@ -489,37 +498,312 @@ TEST_CASE("Case 3.5.3")
 	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
 }
 
-// TODO Add case 4.1.1
-// TODO Add case 4.1.2
-// TODO Add case 4.1.3
-// TODO Add case 4.1.4
-// TODO Add case 4.1.5
-// TODO Add case 4.2.1
-// TODO Add case 4.2.2
-// TODO Add case 4.2.3
-// TODO Add case 4.2.4
-// TODO Add case 4.2.5
-// TODO Add case 4.3.1
-// TODO Add case 4.3.2
-// TODO Add case 4.3.3
-// TODO Add case 4.3.4
-// TODO Add case 4.3.5
-// TODO Add case 5.1.1
-// TODO Add case 5.1.2
-// TODO Add case 5.1.3
-// TODO Add case 5.1.4
-// TODO Add case 5.1.5
-// TODO Add case 5.1.6
-// TODO Add case 5.1.7
-// TODO Add case 5.2.1
-// TODO Add case 5.2.2
-// TODO Add case 5.2.3
-// TODO Add case 5.2.4
-// TODO Add case 5.2.5
-// TODO Add case 5.2.6
-// TODO Add case 5.2.7
-// TODO Add case 5.2.8
-// TODO Add case 5.3.1
-// TODO Add case 5.3.2
-// TODO Add case 5.3.3
-// TODO Add case 5.3.4
+TEST_CASE("Case 4.1.1")
+{
+	unsigned char input[] = { '"',
+	    0xc0, 0xaf,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 4.1.2")
+{
+	unsigned char input[] = { '"',
+	    0xe0, 0x80, 0xaf,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 4.1.3")
+{
+	unsigned char input[] = { '"',
+	    0xf0, 0x80, 0x80, 0xaf,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 4.1.4")
+{
+	unsigned char input[] = { '"',
+	    0xf8, 0x80, 0x80, 0x80, 0xaf,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 4.1.5")
+{
+	unsigned char input[] = { '"',
+	    0xfc, 0x80, 0x80, 0x80, 0x80, 0xaf,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 4.2.1")
+{
+	unsigned char input[] = { '"',
+	    0xc1, 0xbf,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 4.2.2")
+{
+	unsigned char input[] = { '"',
+	    0xe0, 0x9f, 0xbf,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 4.2.3")
+{
+	unsigned char input[] = { '"',
+	    0xf0, 0x8f, 0xbf, 0xbf,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 4.2.4")
+{
+	unsigned char input[] = { '"',
+	    0xf8, 0x87, 0xbf, 0xbf, 0xbf,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 4.2.5")
+{
+	unsigned char input[] = { '"',
+	    0xfc, 0x83, 0xbf, 0xbf, 0xbf, 0xbf,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 4.3.1")
+{
+	unsigned char input[] = { '"',
+	    0xc0, 0x80,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 4.3.2")
+{
+	unsigned char input[] = { '"',
+	    0xe0, 0x80, 0x80,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 4.3.3")
+{
+	unsigned char input[] = { '"',
+	    0xf0, 0x80, 0x80, 0x80,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 4.3.4")
+{
+	unsigned char input[] = { '"',
+	    0xf8, 0x80, 0x80, 0x80, 0x80,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 4.3.5")
+{
+	unsigned char input[] = { '"',
+	    0xfc, 0x80, 0x80, 0x80, 0x80, 0x80,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 5.1.1")
+{
+	unsigned char input[] = { '"',
+	    0xed, 0xa0, 0x80,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 5.1.2")
+{
+	unsigned char input[] = { '"',
+	    0xed, 0xad, 0xbf,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 5.1.3")
+{
+	unsigned char input[] = { '"',
+	    0xed, 0xae, 0x80,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 5.1.4")
+{
+	unsigned char input[] = { '"',
+	    0xed, 0xaf, 0xbf,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 5.1.5")
+{
+	unsigned char input[] = { '"',
+	    0xed, 0xb0, 0x80,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 5.1.6")
+{
+	unsigned char input[] = { '"',
+	    0xed, 0xbe, 0x80,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 5.1.7")
+{
+	unsigned char input[] = { '"',
+	    0xed, 0xbf, 0xbf,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 5.2.1")
+{
+	unsigned char input[] = { '"',
+	    0xed, 0xa0, 0x80, 0xed, 0xb0, 0x80,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 5.2.2")
+{
+	unsigned char input[] = { '"',
+	    0xed, 0xa0, 0x80, 0xed, 0xbf, 0xbf,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 5.2.3")
+{
+	unsigned char input[] = { '"',
+	    0xed, 0xad, 0xbf, 0xed, 0xb0, 0x80,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 5.2.4")
+{
+	unsigned char input[] = { '"',
+	    0xed, 0xad, 0xbf, 0xed, 0xbf, 0xbf,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 5.2.5")
+{
+	unsigned char input[] = { '"',
+	    0xed, 0xae, 0x80, 0xed, 0xb0, 0x80,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 5.2.6")
+{
+	unsigned char input[] = { '"',
+	    0xed, 0xae, 0x80, 0xed, 0xbf, 0xbf,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 5.2.7")
+{
+	unsigned char input[] = { '"',
+	    0xed, 0xaf, 0xbf, 0xed, 0xb0, 0x80,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 5.2.8")
+{
+	unsigned char input[] = { '"',
+	    0xed, 0xaf, 0xbf, 0xed, 0xbf, 0xbf,
+	'"', };
+
+	REQUIRE_THROWS_WITH( [&](){ PARSE_AS_STR(input); }(), "Invalid UTF-8 Sequence" );
+}
+
+TEST_CASE("Case 5.3.1")
+{
+	unsigned char input[] = { '"',
+	    0xef, 0xbf, 0xbe,
+	'"', };
+
+	string out = PARSE(input);
+	REQUIRE( out == "\ufffe" );
+}
+
+TEST_CASE("Case 5.3.2")
+{
+	unsigned char input[] = { '"',
+	    0xef, 0xbf, 0xbf,
+	'"', };
+
+	string out = PARSE(input);
+	REQUIRE( out == "\uffff" );
+}
+
+TEST_CASE("Case 5.3.3")
+{
+	unsigned char input[] = { '"',
+	    0xef, 0xb7, 0x90, 0xef, 0xb7, 0xaf,
+	'"', };
+
+	string out = PARSE(input);
+	REQUIRE( out == "\ufdd0\ufdef" );
+}
+
+TEST_CASE("Case 5.3.4")
+{
+	unsigned char input[] = { '"',
+	    0xf0, 0x9f, 0xbf, 0xbe, 0xf4, 0x8f, 0xbf, 0xbf,
+	'"', };
+
+	string out = PARSE(input);
+	REQUIRE( out == "\U0001fffe\U0010ffff" );
+}
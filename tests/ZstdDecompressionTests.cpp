@@ -0,0 +1,137 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Mustafa Serdar Sanli
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Built with QUANTUMJSON_WITH_ZSTD, when configure finds libzstd
+
+#include <string>
+#include <thread>
+
+#include <zstd.h>
+
+#include "tests/Schema1.gen.hpp"
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+static string Zstd(const string &in)
+{
+	string out(ZSTD_compressBound(in.size()), '\0');
+	const size_t size = ZSTD_compress(&out[0], out.size(), in.data(), in.size(), 3);
+	REQUIRE( !ZSTD_isError(size) );
+	out.resize(size);
+	return out;
+}
+
+static string ItemsJson(int count)
+{
+	string in = R"({"items": [)";
+	for (int i = 0; i < count; ++i)
+	{
+		in += (i ? ",\n  " : "") + string(R"({"name": "item \")") + to_string(i) + R"(", "skipped": [1, {"a": "b c d"}]})";
+	}
+	return in + "]}";
+}
+
+TEST_CASE("Zstd input")
+{
+	const string json = ItemsJson(5000);
+	const string zst = Zstd(json);
+
+	SECTION( "From memory" )
+	{
+		for (size_t chunkSize : {7, 4096, 65536})
+		{
+			QuantumJson::DecompressingInput input(zst.data(), zst.size(), QuantumJson::DecompressingInput::Zstd, chunkSize);
+			ItemList l = QuantumJson::Parse(input);
+			REQUIRE( l.items.size() == 5000 );
+			REQUIRE( l.items[4999].name == "item \"4999" );
+		}
+	}
+
+	SECTION( "From pipe" )
+	{
+		int fds[2];
+		REQUIRE( pipe(fds) == 0 );
+		std::thread writer([&]()
+		{
+			for (size_t i = 0; i < zst.size(); )
+			{
+				ssize_t n = write(fds[1], zst.data() + i, std::min<size_t>(1000, zst.size() - i));
+				if (n <= 0)
+				{
+					break;
+				}
+				i += n;
+			}
+			close(fds[1]);
+		});
+
+		ItemList l;
+		{
+			QuantumJson::DecompressingInput input(fds[0], QuantumJson::DecompressingInput::Zstd);
+			l = QuantumJson::Parse(input);
+		}
+		writer.join();
+		close(fds[0]);
+
+		REQUIRE( l.items.size() == 5000 );
+		REQUIRE( l.items[0].name == "item \"0" );
+	}
+
+	SECTION( "Concatenated frames" )
+	{
+		const string parts = Zstd(json.substr(0, 1000)) + Zstd(json.substr(1000));
+		QuantumJson::DecompressingInput input(parts.data(), parts.size(), QuantumJson::DecompressingInput::Zstd);
+		ItemList l = QuantumJson::Parse(input);
+		REQUIRE( l.items.size() == 5000 );
+	}
+
+	SECTION( "Errors" )
+	{
+		QuantumJson::DecompressingInput truncated(zst.data(), zst.size() - 10, QuantumJson::DecompressingInput::Zstd);
+		REQUIRE_THROWS_WITH( ItemList(QuantumJson::Parse(truncated)), "Truncated zstd data" );
+
+		string corrupted = zst;
+		corrupted[0] ^= 0x55;
+		QuantumJson::DecompressingInput invalid(corrupted.data(), corrupted.size(), QuantumJson::DecompressingInput::Zstd);
+		REQUIRE_THROWS_WITH( ItemList(QuantumJson::Parse(invalid)), "Invalid zstd data: Unknown frame descriptor" );
+
+		REQUIRE_THROWS_AS( QuantumJson::DecompressingInput(zst.data(), zst.size(), QuantumJson::DecompressingInput::Gzip),
+		                   std::invalid_argument );
+	}
+
+	SECTION( "Truncated json" )
+	{
+		// Decompressed fine, but cut at every offset of the json
+		const string doc = R"({"x": [1, -2.5e3, {"a": "}]\"{"}, true, null],)"
+		                   R"( "items": [{"name": "a\"b\u00e9"}, {"name": "c"}]})";
+		for (size_t len = 0; len < doc.size(); ++len)
+		{
+			INFO( doc.substr(0, len) );
+			const string compressed = Zstd(doc.substr(0, len));
+			QuantumJson::DecompressingInput input(compressed.data(), compressed.size(), QuantumJson::DecompressingInput::Zstd, 7);
+			REQUIRE_THROWS_WITH( ItemList(QuantumJson::Parse(input)), "Unexpected EOF" );
+		}
+	}
+}